@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bbasm.dir/main.cc.o"
+  "CMakeFiles/bbasm.dir/main.cc.o.d"
+  "bbasm"
+  "bbasm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bbasm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,6 @@
+#ifndef VERSION_H
+#define VERSION_H
+
+#define GIT_DESCRIBE_STR "cd53bfc"
+
+#endif
@@ -0,0 +1,82 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/3rdparty/json11/json11.cpp" "CMakeFiles/nextpnr-generic-test.dir/3rdparty/json11/json11.cpp.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/3rdparty/json11/json11.cpp.o.d"
+  "/root/repo/3rdparty/oourafft/fftsg.cc" "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg.cc.o.d"
+  "/root/repo/3rdparty/oourafft/fftsg2d.cc" "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg2d.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg2d.cc.o.d"
+  "/root/repo/common/kernel/archcheck.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/archcheck.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/archcheck.cc.o.d"
+  "/root/repo/common/kernel/basectx.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/basectx.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/basectx.cc.o.d"
+  "/root/repo/common/kernel/bits.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/bits.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/bits.cc.o.d"
+  "/root/repo/common/kernel/checkpoint.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/checkpoint.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/checkpoint.cc.o.d"
+  "/root/repo/common/kernel/command.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/command.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/command.cc.o.d"
+  "/root/repo/common/kernel/context.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/context.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/context.cc.o.d"
+  "/root/repo/common/kernel/design_name_index.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_name_index.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_name_index.cc.o.d"
+  "/root/repo/common/kernel/design_utils.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_utils.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_utils.cc.o.d"
+  "/root/repo/common/kernel/embed.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/embed.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/embed.cc.o.d"
+  "/root/repo/common/kernel/graph_snapshot.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/graph_snapshot.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/graph_snapshot.cc.o.d"
+  "/root/repo/common/kernel/gzip_writer.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/gzip_writer.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/gzip_writer.cc.o.d"
+  "/root/repo/common/kernel/handle_error.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/handle_error.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/handle_error.cc.o.d"
+  "/root/repo/common/kernel/hier_name_index.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/hier_name_index.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/hier_name_index.cc.o.d"
+  "/root/repo/common/kernel/idstring.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring.cc.o.d"
+  "/root/repo/common/kernel/idstring_pool.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring_pool.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring_pool.cc.o.d"
+  "/root/repo/common/kernel/idstringlist.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstringlist.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstringlist.cc.o.d"
+  "/root/repo/common/kernel/log.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/log.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/log.cc.o.d"
+  "/root/repo/common/kernel/nextpnr.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr.cc.o.d"
+  "/root/repo/common/kernel/nextpnr_assertions.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_assertions.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  "/root/repo/common/kernel/nextpnr_namespaces.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_namespaces.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_namespaces.cc.o.d"
+  "/root/repo/common/kernel/nextpnr_types.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_types.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_types.cc.o.d"
+  "/root/repo/common/kernel/property.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/property.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/property.cc.o.d"
+  "/root/repo/common/kernel/pybindings.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/pybindings.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/pybindings.cc.o.d"
+  "/root/repo/common/kernel/report.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/report.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/report.cc.o.d"
+  "/root/repo/common/kernel/sdc.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdc.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdc.cc.o.d"
+  "/root/repo/common/kernel/sdf.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdf.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdf.cc.o.d"
+  "/root/repo/common/kernel/str_ring_buffer.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/str_ring_buffer.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/str_ring_buffer.cc.o.d"
+  "/root/repo/common/kernel/svg.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/svg.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/svg.cc.o.d"
+  "/root/repo/common/kernel/thread_pool.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/thread_pool.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/thread_pool.cc.o.d"
+  "/root/repo/common/kernel/timing.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing.cc.o.d"
+  "/root/repo/common/kernel/timing_log.cc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing_log.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing_log.cc.o.d"
+  "/root/repo/common/place/detail_place_core.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/detail_place_core.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/detail_place_core.cc.o.d"
+  "/root/repo/common/place/parallel_refine.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/parallel_refine.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/parallel_refine.cc.o.d"
+  "/root/repo/common/place/place_common.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/place_common.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/place_common.cc.o.d"
+  "/root/repo/common/place/placer1.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/placer1.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/placer1.cc.o.d"
+  "/root/repo/common/place/placer_heap.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_heap.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_heap.cc.o.d"
+  "/root/repo/common/place/placer_static.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_static.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_static.cc.o.d"
+  "/root/repo/common/place/sparse_solver.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/sparse_solver.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/sparse_solver.cc.o.d"
+  "/root/repo/common/place/spectral_solver.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/spectral_solver.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/spectral_solver.cc.o.d"
+  "/root/repo/common/place/timing_opt.cc" "CMakeFiles/nextpnr-generic-test.dir/common/place/timing_opt.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/place/timing_opt.cc.o.d"
+  "/root/repo/common/route/router1.cc" "CMakeFiles/nextpnr-generic-test.dir/common/route/router1.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/route/router1.cc.o.d"
+  "/root/repo/common/route/router2.cc" "CMakeFiles/nextpnr-generic-test.dir/common/route/router2.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/route/router2.cc.o.d"
+  "/root/repo/common/route/router_lookahead.cc" "CMakeFiles/nextpnr-generic-test.dir/common/route/router_lookahead.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/common/route/router_lookahead.cc.o.d"
+  "/root/repo/frontend/json_frontend.cc" "CMakeFiles/nextpnr-generic-test.dir/frontend/json_frontend.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/frontend/json_frontend.cc.o.d"
+  "/root/repo/generic/arch.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/arch.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/arch.cc.o.d"
+  "/root/repo/generic/arch_pybindings.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/arch_pybindings.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/arch_pybindings.cc.o.d"
+  "/root/repo/generic/cells.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/cells.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/cells.cc.o.d"
+  "/root/repo/generic/main.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/main.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/main.cc.o.d"
+  "/root/repo/generic/pack.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/pack.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/pack.cc.o.d"
+  "/root/repo/generic/tests/checkpoint.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/tests/checkpoint.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/tests/checkpoint.cc.o.d"
+  "/root/repo/generic/viaduct/example/example.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/example/example.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/example/example.cc.o.d"
+  "/root/repo/generic/viaduct/fabulous/fabulous.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fabulous.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fabulous.cc.o.d"
+  "/root/repo/generic/viaduct/fabulous/fasm.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fasm.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fasm.cc.o.d"
+  "/root/repo/generic/viaduct/fabulous/pack.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/pack.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/pack.cc.o.d"
+  "/root/repo/generic/viaduct/fabulous/validity_check.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/validity_check.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/validity_check.cc.o.d"
+  "/root/repo/generic/viaduct/okami/okami.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/okami/okami.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/okami/okami.cc.o.d"
+  "/root/repo/generic/viaduct_api.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_api.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_api.cc.o.d"
+  "/root/repo/generic/viaduct_helpers.cc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_helpers.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_helpers.cc.o.d"
+  "/root/repo/json/jsonwrite.cc" "CMakeFiles/nextpnr-generic-test.dir/json/jsonwrite.cc.o" "gcc" "CMakeFiles/nextpnr-generic-test.dir/json/jsonwrite.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_test_build/generated/3rdparty/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_test_build/generated/3rdparty/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
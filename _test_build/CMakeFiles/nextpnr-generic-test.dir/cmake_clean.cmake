@@ -0,0 +1,133 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nextpnr-generic-test.dir/3rdparty/json11/json11.cpp.o"
+  "CMakeFiles/nextpnr-generic-test.dir/3rdparty/json11/json11.cpp.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg2d.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/3rdparty/oourafft/fftsg2d.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/archcheck.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/archcheck.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/basectx.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/basectx.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/bits.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/bits.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/checkpoint.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/checkpoint.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/command.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/command.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/context.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/context.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_name_index.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_name_index.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_utils.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/design_utils.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/embed.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/embed.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/graph_snapshot.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/graph_snapshot.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/gzip_writer.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/gzip_writer.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/handle_error.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/handle_error.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/hier_name_index.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/hier_name_index.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring_pool.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstring_pool.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstringlist.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/idstringlist.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/log.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/log.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_assertions.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_namespaces.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_namespaces.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_types.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/nextpnr_types.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/property.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/property.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/pybindings.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/pybindings.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/report.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/report.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdc.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdc.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdf.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/sdf.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/str_ring_buffer.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/str_ring_buffer.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/svg.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/svg.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/thread_pool.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/thread_pool.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing_log.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/kernel/timing_log.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/detail_place_core.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/detail_place_core.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/parallel_refine.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/parallel_refine.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/place_common.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/place_common.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/placer1.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/placer1.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_heap.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_heap.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_static.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/placer_static.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/sparse_solver.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/sparse_solver.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/spectral_solver.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/spectral_solver.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/timing_opt.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/place/timing_opt.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/route/router1.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/route/router1.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/route/router2.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/route/router2.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/common/route/router_lookahead.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/common/route/router_lookahead.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/frontend/json_frontend.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/frontend/json_frontend.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/arch.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/arch.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/arch_pybindings.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/arch_pybindings.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/cells.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/cells.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/main.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/main.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/pack.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/pack.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/tests/checkpoint.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/tests/checkpoint.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/example/example.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/example/example.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fabulous.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fabulous.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fasm.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/fasm.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/pack.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/pack.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/validity_check.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/fabulous/validity_check.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/okami/okami.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct/okami/okami.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_api.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_api.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_helpers.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/generic/viaduct_helpers.cc.o.d"
+  "CMakeFiles/nextpnr-generic-test.dir/json/jsonwrite.cc.o"
+  "CMakeFiles/nextpnr-generic-test.dir/json/jsonwrite.cc.o.d"
+  "nextpnr-generic-test"
+  "nextpnr-generic-test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nextpnr-generic-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/common/kernel/bench/idstring_bench.cc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/bench/idstring_bench.cc.o" "gcc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/bench/idstring_bench.cc.o.d"
+  "/root/repo/common/kernel/idstring_pool.cc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/idstring_pool.cc.o" "gcc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/idstring_pool.cc.o.d"
+  "/root/repo/common/kernel/log.cc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/log.cc.o" "gcc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/log.cc.o.d"
+  "/root/repo/common/kernel/nextpnr_assertions.cc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/nextpnr_assertions.cc.o" "gcc" "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/bench/idstring_bench.cc.o"
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/bench/idstring_bench.cc.o.d"
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/idstring_pool.cc.o"
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/idstring_pool.cc.o.d"
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/log.cc.o"
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/log.cc.o.d"
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/nextpnr_assertions.cc.o"
+  "CMakeFiles/nextpnr-idstring-bench.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  "nextpnr-idstring-bench"
+  "nextpnr-idstring-bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nextpnr-idstring-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/common/kernel/bench/name_index_bench.cc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/bench/name_index_bench.cc.o" "gcc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/bench/name_index_bench.cc.o.d"
+  "/root/repo/common/kernel/hier_name_index.cc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/hier_name_index.cc.o" "gcc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/hier_name_index.cc.o.d"
+  "/root/repo/common/kernel/log.cc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/log.cc.o" "gcc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/log.cc.o.d"
+  "/root/repo/common/kernel/nextpnr_assertions.cc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/nextpnr_assertions.cc.o" "gcc" "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/bench/name_index_bench.cc.o"
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/bench/name_index_bench.cc.o.d"
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/hier_name_index.cc.o"
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/hier_name_index.cc.o.d"
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/log.cc.o"
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/log.cc.o.d"
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/nextpnr_assertions.cc.o"
+  "CMakeFiles/nextpnr-name-index-bench.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  "nextpnr-name-index-bench"
+  "nextpnr-name-index-bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nextpnr-name-index-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/3rdparty/oourafft/fftsg.cc" "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg.cc.o" "gcc" "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg.cc.o.d"
+  "/root/repo/3rdparty/oourafft/fftsg2d.cc" "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg2d.cc.o" "gcc" "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg2d.cc.o.d"
+  "/root/repo/common/kernel/log.cc" "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/log.cc.o" "gcc" "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/log.cc.o.d"
+  "/root/repo/common/kernel/nextpnr_assertions.cc" "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/nextpnr_assertions.cc.o" "gcc" "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  "/root/repo/common/kernel/thread_pool.cc" "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/thread_pool.cc.o" "gcc" "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/thread_pool.cc.o.d"
+  "/root/repo/common/place/bench/spectral_bench.cc" "CMakeFiles/nextpnr-spectral-bench.dir/common/place/bench/spectral_bench.cc.o" "gcc" "CMakeFiles/nextpnr-spectral-bench.dir/common/place/bench/spectral_bench.cc.o.d"
+  "/root/repo/common/place/spectral_solver.cc" "CMakeFiles/nextpnr-spectral-bench.dir/common/place/spectral_solver.cc.o" "gcc" "CMakeFiles/nextpnr-spectral-bench.dir/common/place/spectral_solver.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg.cc.o"
+  "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg.cc.o.d"
+  "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg2d.cc.o"
+  "CMakeFiles/nextpnr-spectral-bench.dir/3rdparty/oourafft/fftsg2d.cc.o.d"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/log.cc.o"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/log.cc.o.d"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/nextpnr_assertions.cc.o"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/nextpnr_assertions.cc.o.d"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/thread_pool.cc.o"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/kernel/thread_pool.cc.o.d"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/place/bench/spectral_bench.cc.o"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/place/bench/spectral_bench.cc.o.d"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/place/spectral_solver.cc.o"
+  "CMakeFiles/nextpnr-spectral-bench.dir/common/place/spectral_solver.cc.o.d"
+  "nextpnr-spectral-bench"
+  "nextpnr-spectral-bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nextpnr-spectral-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
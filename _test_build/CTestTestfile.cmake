@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_test_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(generic-test "/root/repo/_test_build/nextpnr-generic-test")
+set_tests_properties(generic-test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;353;add_test;/root/repo/CMakeLists.txt;0;")
+subdirs("generated/3rdparty/googletest")
+subdirs("bba")
@@ -0,0 +1,6 @@
+#ifndef VERSION_H
+#define VERSION_H
+
+#define GIT_DESCRIBE_STR "3ef59a2"
+
+#endif
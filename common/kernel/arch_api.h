@@ -59,6 +59,7 @@ template <typename R> struct ArchAPI : BaseCtx
     virtual bool checkBelAvail(BelId bel) const = 0;
     virtual CellInfo *getBoundBelCell(BelId bel) const = 0;
     virtual CellInfo *getConflictingBelCell(BelId bel) const = 0;
+    virtual bool isBelBindingPartitionSafe(BelId bel) const = 0;
     virtual IdString getBelType(BelId bel) const = 0;
     virtual bool getBelHidden(BelId bel) const = 0;
     virtual typename R::BelAttrsRangeT getBelAttrs(BelId bel) const = 0;
@@ -66,6 +67,8 @@ template <typename R> struct ArchAPI : BaseCtx
     virtual PortType getBelPinType(BelId bel, IdString pin) const = 0;
     virtual typename R::BelPinsRangeT getBelPins(BelId bel) const = 0;
     virtual typename R::CellBelPinRangeT getBelPinsForCellPin(const CellInfo *cell_info, IdString pin) const = 0;
+    virtual int getBelIndex(BelId bel) const = 0;
+    virtual int getBelIndexCount() const = 0;
     // Wire methods
     virtual typename R::AllWiresRangeT getWires() const = 0;
     virtual WireId getWireByName(IdStringList name) const = 0;
@@ -84,6 +87,8 @@ template <typename R> struct ArchAPI : BaseCtx
     virtual NetInfo *getConflictingWireNet(WireId wire) const = 0;
     virtual DelayQuad getWireDelay(WireId wire) const = 0;
     virtual IdString getWireConstantValue(WireId wire) const = 0;
+    virtual int getWireIndex(WireId wire) const = 0;
+    virtual int getWireIndexCount() const = 0;
     // Pip methods
     virtual typename R::AllPipsRangeT getPips() const = 0;
     virtual PipId getPipByName(IdStringList name) const = 0;
@@ -102,6 +107,8 @@ template <typename R> struct ArchAPI : BaseCtx
     virtual WireId getPipDstWire(PipId pip) const = 0;
     virtual DelayQuad getPipDelay(PipId pip) const = 0;
     virtual Loc getPipLocation(PipId pip) const = 0;
+    virtual int getPipIndex(PipId pip) const = 0;
+    virtual int getPipIndexCount() const = 0;
     // Group methods
     virtual GroupId getGroupByName(IdStringList name) const = 0;
     virtual IdStringList getGroupName(GroupId group) const = 0;
@@ -15,6 +15,18 @@ readonly_wrapper<Context, decltype(&Context::timing_result), &Context::timing_re
 fn_wrapper_0a<Context, decltype(&Context::getNameDelimiter), &Context::getNameDelimiter, pass_through<char>>::def_wrap(
         ctx_cls, "getNameDelimiter");
 
+ctx_cls.def("getRoutingGraphSnapshot",
+            [](const Context &ctx) { return std::unique_ptr<RoutingGraphSnapshot>(new RoutingGraphSnapshot(&ctx)); });
+
+ctx_cls.def("getCellNames", cell_names_py);
+ctx_cls.def("getNetNames", net_names_py);
+ctx_cls.def("getCellLocations", cell_locations_py);
+ctx_cls.def("getCellBelTypes", cell_bel_types_py);
+ctx_cls.def("getNetFanouts", net_fanouts_py);
+ctx_cls.def("getPinNets", pin_nets_py);
+ctx_cls.def("getArcTiming", arc_timing_py);
+ctx_cls.def("placeCells", place_cells_py, py::arg("cells"), py::arg("bels"), py::arg("strength") = STRENGTH_USER);
+
 fn_wrapper_1a<Context, decltype(&Context::getNetByAlias), &Context::getNetByAlias, deref_and_wrap<NetInfo>,
               conv_from_str<IdString>>::def_wrap(ctx_cls, "getNetByAlias");
 fn_wrapper_2a_v<Context, decltype(&Context::addClock), &Context::addClock, conv_from_str<IdString>,
@@ -152,7 +152,7 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual void bindBel(BelId bel, CellInfo *cell, PlaceStrength strength) override
     {
         NPNR_ASSERT(bel != BelId());
-        auto &entry = base_bel2cell[bel];
+        auto &entry = bel2cell_entry(bel);
         NPNR_ASSERT(entry == nullptr);
         cell->bel = bel;
         cell->belStrength = strength;
@@ -162,7 +162,7 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual void unbindBel(BelId bel) override
     {
         NPNR_ASSERT(bel != BelId());
-        auto &entry = base_bel2cell[bel];
+        auto &entry = bel2cell_entry(bel);
         NPNR_ASSERT(entry != nullptr);
         entry->bel = BelId();
         entry->belStrength = STRENGTH_NONE;
@@ -173,11 +173,12 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual bool getBelHidden(BelId /*bel*/) const override { return false; }
 
     virtual bool getBelGlobalBuf(BelId /*bel*/) const override { return false; }
+    // The default binding storage is shared by all bels, so nothing can be bound concurrently
+    virtual bool isBelBindingPartitionSafe(BelId /*bel*/) const override { return false; }
     virtual bool checkBelAvail(BelId bel) const override { return getBoundBelCell(bel) == nullptr; };
     virtual CellInfo *getBoundBelCell(BelId bel) const override
     {
-        auto fnd = base_bel2cell.find(bel);
-        return fnd == base_bel2cell.end() ? nullptr : fnd->second;
+        return binding_lookup(base_bel2cell, dense_bel2cell, bel, bel == BelId() ? -1 : this->getBelIndex(bel));
     }
     virtual CellInfo *getConflictingBelCell(BelId bel) const override { return getBoundBelCell(bel); }
     virtual typename R::BelAttrsRangeT getBelAttrs(BelId /*bel*/) const override
@@ -190,6 +191,8 @@ template <typename R> struct BaseArch : ArchAPI<R>
     {
         return return_if_match<std::array<IdString, 1>, typename R::CellBelPinRangeT>({pin});
     }
+    virtual int getBelIndex(BelId /*bel*/) const override { return -1; }
+    virtual int getBelIndexCount() const override { return 0; }
 
     // Wire methods
     virtual IdString getWireType(WireId /*wire*/) const override { return IdString(); }
@@ -202,7 +205,7 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual void bindWire(WireId wire, NetInfo *net, PlaceStrength strength) override
     {
         NPNR_ASSERT(wire != WireId());
-        auto &w2n_entry = base_wire2net[wire];
+        auto &w2n_entry = wire2net_entry(wire);
         NPNR_ASSERT(w2n_entry == nullptr);
         net->wires[wire].pip = PipId();
         net->wires[wire].strength = strength;
@@ -212,7 +215,7 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual void unbindWire(WireId wire) override
     {
         NPNR_ASSERT(wire != WireId());
-        auto &w2n_entry = base_wire2net[wire];
+        auto &w2n_entry = wire2net_entry(wire);
         NPNR_ASSERT(w2n_entry != nullptr);
 
         auto &net_wires = w2n_entry->wires;
@@ -221,11 +224,10 @@ template <typename R> struct BaseArch : ArchAPI<R>
 
         auto pip = it->second.pip;
         if (pip != PipId()) {
-            base_pip2net[pip] = nullptr;
+            pip2net_entry(pip) = nullptr;
         }
 
         net_wires.erase(it);
-        base_wire2net[wire] = nullptr;
 
         w2n_entry = nullptr;
         this->refreshUiWire(wire);
@@ -233,12 +235,13 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual bool checkWireAvail(WireId wire) const override { return getBoundWireNet(wire) == nullptr; }
     virtual NetInfo *getBoundWireNet(WireId wire) const override
     {
-        auto fnd = base_wire2net.find(wire);
-        return fnd == base_wire2net.end() ? nullptr : fnd->second;
+        return binding_lookup(base_wire2net, dense_wire2net, wire, wire == WireId() ? -1 : this->getWireIndex(wire));
     }
     virtual WireId getConflictingWireWire(WireId wire) const override { return wire; };
     virtual NetInfo *getConflictingWireNet(WireId wire) const override { return getBoundWireNet(wire); }
     virtual IdString getWireConstantValue(WireId /*wire*/) const override { return {}; }
+    virtual int getWireIndex(WireId /*wire*/) const override { return -1; }
+    virtual int getWireIndexCount() const override { return 0; }
 
     // Pip methods
     virtual IdString getPipType(PipId /*pip*/) const override { return IdString(); }
@@ -250,12 +253,12 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual void bindPip(PipId pip, NetInfo *net, PlaceStrength strength) override
     {
         NPNR_ASSERT(pip != PipId());
-        auto &p2n_entry = base_pip2net[pip];
+        auto &p2n_entry = pip2net_entry(pip);
         NPNR_ASSERT(p2n_entry == nullptr);
         p2n_entry = net;
 
         WireId dst = this->getPipDstWire(pip);
-        auto &w2n_entry = base_wire2net[dst];
+        auto &w2n_entry = wire2net_entry(dst);
         NPNR_ASSERT(w2n_entry == nullptr);
         w2n_entry = net;
         net->wires[dst].pip = pip;
@@ -264,11 +267,11 @@ template <typename R> struct BaseArch : ArchAPI<R>
     virtual void unbindPip(PipId pip) override
     {
         NPNR_ASSERT(pip != PipId());
-        auto &p2n_entry = base_pip2net[pip];
+        auto &p2n_entry = pip2net_entry(pip);
         NPNR_ASSERT(p2n_entry != nullptr);
         WireId dst = this->getPipDstWire(pip);
 
-        auto &w2n_entry = base_wire2net[dst];
+        auto &w2n_entry = wire2net_entry(dst);
         NPNR_ASSERT(w2n_entry != nullptr);
         w2n_entry = nullptr;
 
@@ -283,11 +286,12 @@ template <typename R> struct BaseArch : ArchAPI<R>
     }
     virtual NetInfo *getBoundPipNet(PipId pip) const override
     {
-        auto fnd = base_pip2net.find(pip);
-        return fnd == base_pip2net.end() ? nullptr : fnd->second;
+        return binding_lookup(base_pip2net, dense_pip2net, pip, pip == PipId() ? -1 : this->getPipIndex(pip));
     }
     virtual WireId getConflictingPipWire(PipId /*pip*/) const override { return WireId(); }
     virtual NetInfo *getConflictingPipNet(PipId pip) const override { return getBoundPipNet(pip); }
+    virtual int getPipIndex(PipId /*pip*/) const override { return -1; }
+    virtual int getPipIndexCount() const override { return 0; }
 
     // Group methods
     virtual GroupId getGroupByName(IdStringList /*name*/) const override { return GroupId(); };
@@ -453,6 +457,47 @@ template <typename R> struct BaseArch : ArchAPI<R>
     dict<WireId, NetInfo *> base_wire2net;
     dict<PipId, NetInfo *> base_pip2net;
 
+    // Where the arch provides dense indices (getBelIndex, getWireIndex, getPipIndex), bindings are stored in these
+    // flat vectors instead of the dicts above. They are sized on the first bind, so stay empty until then
+    std::vector<CellInfo *> dense_bel2cell;
+    std::vector<NetInfo *> dense_wire2net;
+    std::vector<NetInfo *> dense_pip2net;
+
+    template <typename TId, typename TBound>
+    static TBound *&binding_entry(dict<TId, TBound *> &base, std::vector<TBound *> &dense, TId id, int index,
+                                  int count)
+    {
+        if (index < 0)
+            return base[id];
+        if (dense.empty())
+            dense.resize(count, nullptr);
+        return dense.at(index);
+    }
+
+    template <typename TId, typename TBound>
+    static TBound *binding_lookup(const dict<TId, TBound *> &base, const std::vector<TBound *> &dense, TId id,
+                                  int index)
+    {
+        if (index >= 0)
+            return dense.empty() ? nullptr : dense.at(index);
+        auto fnd = base.find(id);
+        return fnd == base.end() ? nullptr : fnd->second;
+    }
+
+    CellInfo *&bel2cell_entry(BelId bel)
+    {
+        return binding_entry(base_bel2cell, dense_bel2cell, bel, this->getBelIndex(bel), this->getBelIndexCount());
+    }
+    NetInfo *&wire2net_entry(WireId wire)
+    {
+        return binding_entry(base_wire2net, dense_wire2net, wire, this->getWireIndex(wire),
+                             this->getWireIndexCount());
+    }
+    NetInfo *&pip2net_entry(PipId pip)
+    {
+        return binding_entry(base_pip2net, dense_pip2net, pip, this->getPipIndex(pip), this->getPipIndexCount());
+    }
+
     // For the default cell/bel bucket implementations
     std::vector<IdString> cell_types;
     std::vector<BelBucketId> bel_buckets;
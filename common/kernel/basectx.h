@@ -30,6 +30,7 @@
 
 #include "hashlib.h"
 #include "idstring.h"
+#include "idstring_pool.h"
 #include "nextpnr_namespaces.h"
 #include "nextpnr_types.h"
 #include "property.h"
@@ -52,9 +53,8 @@ struct BaseCtx
     std::mutex ui_mutex;
 #endif
 
-    // ID String database.
-    mutable std::unordered_map<std::string, int> *idstring_str_to_idx;
-    mutable std::vector<const std::string *> *idstring_idx_to_str;
+    // ID String database. Safe to use from several threads at once
+    mutable IdStringPool *idstrings;
 
     // Temporary string backing store for logging
     mutable StrRingBuffer log_strs;
@@ -94,8 +94,7 @@ struct BaseCtx
 
     BaseCtx()
     {
-        idstring_str_to_idx = new std::unordered_map<std::string, int>;
-        idstring_idx_to_str = new std::vector<const std::string *>;
+        idstrings = new IdStringPool;
         IdString::initialize_add(this, "", 0);
         IdString::initialize_arch(this);
 
@@ -104,8 +103,7 @@ struct BaseCtx
 
     virtual ~BaseCtx()
     {
-        delete idstring_str_to_idx;
-        delete idstring_idx_to_str;
+        delete idstrings;
     }
 
     // Must be called before performing any mutating changes on the Ctx/Arch.
@@ -196,12 +194,19 @@ struct BaseCtx
     pool<WireId> wireUiReload;
     pool<PipId> pipUiReload;
     pool<GroupId> groupUiReload;
+    // Set while bels are bound from several threads at once (see isBelBindingPartitionSafe); bel changes are not
+    // recorded one by one, and the whole UI is refreshed afterwards instead
+    bool belUiReloadSuspended = false;
 
     void refreshUi() { allUiReload = true; }
 
     void refreshUiFrame() { frameUiReload = true; }
 
-    void refreshUiBel(BelId bel) { belUiReload.insert(bel); }
+    void refreshUiBel(BelId bel)
+    {
+        if (!belUiReloadSuspended)
+            belUiReload.insert(bel);
+    }
 
     void refreshUiWire(WireId wire) { wireUiReload.insert(wire); }
 
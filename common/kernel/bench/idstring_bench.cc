@@ -0,0 +1,135 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+// Benchmark of the IdString pool against the unordered_map and vector of string pointers that IdString::set used
+// before it.
+//
+// Usage: nextpnr-idstring-bench [names [threads]]
+//
+// Interns names distinct strings of the form "top/u_core<i>/reg_<j>[<bit>]", then looks each of them up again and
+// reads them back by index twice, both ways, printing the time per operation. Then interns the same names into a new
+// pool from several threads at once, each thread taking every threads'th name, and checks the result.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "idstring_pool.h"
+
+USING_NEXTPNR_NAMESPACE
+
+namespace {
+
+double elapsed(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// The string table IdString used before IdStringPool
+struct LegacyPool
+{
+    std::unordered_map<std::string, int> str_to_idx;
+    std::vector<const std::string *> idx_to_str;
+
+    int intern(const std::string &s)
+    {
+        auto it = str_to_idx.find(s);
+        if (it != str_to_idx.end())
+            return it->second;
+        int index = idx_to_str.size();
+        auto insert_rc = str_to_idx.insert({s, index});
+        idx_to_str.push_back(&insert_rc.first->first);
+        return index;
+    }
+
+    const std::string &get(int idx) const { return *idx_to_str.at(idx); }
+};
+
+template <typename Pool> void run(const char *label, Pool &pool, const std::vector<std::string> &names)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto &name : names)
+        pool.intern(name);
+    double insert_time = elapsed(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    size_t checksum = 0;
+    for (auto &name : names)
+        checksum += pool.intern(name);
+    double lookup_time = elapsed(start);
+
+    // The pool only creates the std::string for an index when it is first asked for, so time that separately
+    double get_time[2];
+    for (int pass = 0; pass < 2; pass++) {
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < int(names.size()); i++)
+            checksum += pool.get(i).size();
+        get_time[pass] = elapsed(start);
+    }
+
+    double n = double(names.size());
+    printf("%-12s %12.1f %12.1f %12.1f %12.1f   (checksum %zu)\n", label, 1e9 * insert_time / n,
+           1e9 * lookup_time / n, 1e9 * get_time[0] / n, 1e9 * get_time[1] / n, checksum);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int count = (argc > 1) ? std::atoi(argv[1]) : 2000000;
+    int threads = (argc > 2) ? std::atoi(argv[2]) : 4;
+
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (int i = 0; int(names.size()) < count; i++)
+        for (int bit = 0; bit < 8 && int(names.size()) < count; bit++)
+            names.push_back("top/u_core" + std::to_string(i / 1024) + "/reg_" + std::to_string(i % 1024) + "[" +
+                            std::to_string(bit) + "]");
+
+    printf("%d names\n", count);
+    printf("%-12s %12s %12s %12s %12s\n", "", "insert (ns)", "lookup (ns)", "1st str (ns)", "str (ns)");
+    {
+        LegacyPool legacy;
+        run("legacy", legacy, names);
+    }
+    {
+        IdStringPool pool;
+        run("pool", pool, names);
+    }
+
+    IdStringPool pool;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&, t]() {
+            for (size_t i = t; i < names.size(); i += threads)
+                pool.intern(names.at(i));
+        });
+    for (auto &w : workers)
+        w.join();
+    double time = elapsed(start);
+    bool ok = (pool.size() == count);
+    for (int i = 0; ok && i < count; i++)
+        ok = (pool.find(pool.view(i)) == i);
+    printf("pool, %d threads: %.1f ns per insert%s\n", threads, 1e9 * time / count, ok ? "" : " MISMATCH");
+    return ok ? 0 : 1;
+}
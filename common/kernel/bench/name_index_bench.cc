@@ -0,0 +1,100 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+// Benchmark of the constraint query name index against testing every name, as get_cells etc would without it.
+//
+// Usage: nextpnr-name-index-bench [cores [alus [regs]]]
+//
+// Generates cores * alus * regs * 8 names of the form "top/u_core<i>/u_alu<j>/reg_<k>[<bit>]", then runs a set of
+// glob and regular expression queries both ways, printing the time per query and the number of matches.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <vector>
+#include "hier_name_index.h"
+
+USING_NEXTPNR_NAMESPACE
+
+namespace {
+
+double elapsed(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int cores = (argc > 1) ? std::atoi(argv[1]) : 32;
+    int alus = (argc > 2) ? std::atoi(argv[2]) : 32;
+    int regs = (argc > 3) ? std::atoi(argv[3]) : 128;
+
+    std::vector<std::string> names;
+    for (int i = 0; i < cores; i++)
+        for (int j = 0; j < alus; j++)
+            for (int k = 0; k < regs; k++)
+                for (int bit = 0; bit < 8; bit++)
+                    names.push_back("top/u_core" + std::to_string(i) + "/u_alu" + std::to_string(j) + "/reg_" +
+                                    std::to_string(k) + "[" + std::to_string(bit) + "]");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    HierNameIndex index("/");
+    for (size_t i = 0; i < names.size(); i++)
+        index.add(names.at(i), int32_t(i));
+    printf("%zu names, index built in %.2f ms\n", names.size(), 1000 * elapsed(start));
+
+    const std::vector<std::string> globs = {"top/u_core3/u_alu7/reg_12[5]", "top/u_core3/u_alu7/*",
+                                            "top/u_core*/u_alu1/reg_5?[0]", "top/*/*/reg_1[?]", "*/*/*/*"};
+    const std::vector<std::string> regexes = {"top/u_core12/u_alu3/reg_[0-9]+\\[3\\]", "top/u_core1[0-9]/.*",
+                                              ".*/reg_99\\[7\\]"};
+
+    printf("%-40s %12s %12s %10s\n", "query", "scan (ms)", "index (ms)", "matches");
+    for (auto &pattern : globs) {
+        start = std::chrono::high_resolution_clock::now();
+        size_t scan_count = 0;
+        for (auto &name : names)
+            if (HierNameIndex::glob_match(pattern, name, "/"))
+                ++scan_count;
+        double scan_time = elapsed(start);
+        start = std::chrono::high_resolution_clock::now();
+        size_t index_count = index.match_glob(pattern).size();
+        double index_time = elapsed(start);
+        printf("%-40s %12.3f %12.3f %10zu%s\n", pattern.c_str(), 1000 * scan_time, 1000 * index_time, index_count,
+               (scan_count == index_count) ? "" : " MISMATCH");
+    }
+    for (auto &expr : regexes) {
+        std::regex re(expr);
+        start = std::chrono::high_resolution_clock::now();
+        size_t scan_count = 0;
+        for (auto &name : names)
+            if (std::regex_match(name, re))
+                ++scan_count;
+        double scan_time = elapsed(start);
+        start = std::chrono::high_resolution_clock::now();
+        size_t index_count = index.match_regex(expr).size();
+        double index_time = elapsed(start);
+        printf("-regexp %-32s %12.3f %12.3f %10zu%s\n", expr.c_str(), 1000 * scan_time, 1000 * index_time,
+               index_count, (scan_count == index_count) ? "" : " MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,705 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "checkpoint.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include "base_clusterinfo.h"
+#include "log.h"
+#include "nextpnr.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+namespace {
+
+// File layout, all integers in native byte order:
+//   magic, version, arch name, chip name
+//   string table: count, then (length, bytes) for each string; entry 0 is always the empty IdString
+//   body: see CheckpointWriter::write_body. IdStrings are indices into the string table
+const char checkpoint_magic[8] = {'N', 'P', 'N', 'R', 'C', 'K', 'P', 'T'};
+const uint32_t checkpoint_version = 2;
+
+struct ByteWriter
+{
+    std::vector<char> data;
+
+    template <typename T> void put(T value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written directly");
+        size_t pos = data.size();
+        data.resize(pos + sizeof(T));
+        std::memcpy(data.data() + pos, &value, sizeof(T));
+    }
+
+    void put_str(const std::string &str)
+    {
+        put<uint32_t>(str.size());
+        data.insert(data.end(), str.begin(), str.end());
+    }
+};
+
+struct CheckpointWriter
+{
+    CheckpointWriter(Context *ctx) : ctx(ctx)
+    {
+        // The empty IdString is always entry 0
+        id_map.push_back(0);
+        id_list.push_back(IdString());
+    }
+
+    Context *ctx;
+    ByteWriter body;
+    // IdString index to index in the string table, or -1 if not yet used
+    std::vector<int32_t> id_map;
+    std::vector<IdString> id_list;
+
+    dict<IdString, int32_t> cell_idx, net_idx;
+
+    void put_id(IdString id)
+    {
+        if (id.index >= int(id_map.size()))
+            id_map.resize(id.index + 1, -1);
+        int32_t &entry = id_map.at(id.index);
+        if (entry == -1) {
+            entry = int32_t(id_list.size());
+            id_list.push_back(id);
+        }
+        body.put<int32_t>(entry);
+    }
+
+    void put_id_list(const IdStringList &list)
+    {
+        body.put<uint32_t>(list.size());
+        for (IdString id : list)
+            put_id(id);
+    }
+
+    void put_ids(const std::vector<IdString> &ids)
+    {
+        body.put<uint32_t>(ids.size());
+        for (IdString id : ids)
+            put_id(id);
+    }
+
+    void put_id_dict(const dict<IdString, IdString> &d)
+    {
+        body.put<uint32_t>(d.size());
+        for (auto &entry : d) {
+            put_id(entry.first);
+            put_id(entry.second);
+        }
+    }
+
+    void put_props(const dict<IdString, Property> &props)
+    {
+        body.put<uint32_t>(props.size());
+        for (auto &prop : props) {
+            put_id(prop.first);
+            body.put<uint8_t>(prop.second.is_string);
+            body.put_str(prop.second.str);
+        }
+    }
+
+    void put_cell_ref(const CellInfo *cell) { body.put<int32_t>(cell ? cell_idx.at(cell->name) : -1); }
+    void put_net_ref(const NetInfo *net) { body.put<int32_t>(net ? net_idx.at(net->name) : -1); }
+
+    // The relative placement constraints of arches that use the base cluster data; nothing for the others
+    template <typename T> void put_cluster_info(const T *ci)
+    {
+        if constexpr (std::is_base_of<BaseClusterInfo, T>::value) {
+            body.put<uint32_t>(ci->constr_children.size());
+            for (const CellInfo *child : ci->constr_children)
+                put_cell_ref(child);
+            body.put<int32_t>(ci->constr_x);
+            body.put<int32_t>(ci->constr_y);
+            body.put<int32_t>(ci->constr_z);
+            body.put<uint8_t>(ci->constr_abs_z);
+        }
+    }
+
+    void write_body()
+    {
+        put_props(ctx->settings);
+        put_props(ctx->attrs);
+        put_id(ctx->top_module);
+
+        for (auto &cell : ctx->cells)
+            cell_idx[cell.first] = int32_t(cell_idx.size());
+        for (auto &net : ctx->nets)
+            net_idx[net.first] = int32_t(net_idx.size());
+
+        body.put<uint32_t>(ctx->nets.size());
+        for (auto &net : ctx->nets) {
+            const NetInfo *ni = net.second.get();
+            put_id(ni->name);
+            put_id(ni->hierpath);
+            put_id(ni->constant_value);
+            put_props(ni->attrs);
+            put_ids(ni->aliases);
+            body.put<uint8_t>(bool(ni->clkconstr));
+            if (ni->clkconstr)
+                body.put<ClockConstraint>(*ni->clkconstr);
+        }
+
+        body.put<uint32_t>(ctx->cells.size());
+        for (auto &cell : ctx->cells) {
+            const CellInfo *ci = cell.second.get();
+            put_id(ci->name);
+            put_id(ci->type);
+            put_id(ci->hierpath);
+            put_props(ci->params);
+            put_props(ci->attrs);
+            body.put<uint32_t>(ci->ports.size());
+            for (auto &port : ci->ports) {
+                put_id(port.first);
+                body.put<uint8_t>(port.second.type);
+                put_net_ref(port.second.net);
+            }
+        }
+
+        // Connectivity is written per net, so that the order of users is kept
+        for (auto &net : ctx->nets) {
+            const NetInfo *ni = net.second.get();
+            put_cell_ref(ni->driver.cell);
+            put_id(ni->driver.port);
+            body.put<uint32_t>(ni->users.entries());
+            for (auto &usr : ni->users) {
+                put_cell_ref(usr.cell);
+                put_id(usr.port);
+            }
+        }
+
+        for (auto &cell : ctx->cells) {
+            const CellInfo *ci = cell.second.get();
+            put_id(ci->cluster);
+            put_cluster_info(ci);
+        }
+
+        body.put<uint32_t>(ctx->ports.size());
+        for (auto &port : ctx->ports) {
+            put_id(port.first);
+            body.put<uint8_t>(port.second.type);
+            put_net_ref(port.second.net);
+        }
+        body.put<uint32_t>(ctx->port_cells.size());
+        for (auto &port : ctx->port_cells) {
+            put_id(port.first);
+            put_cell_ref(port.second);
+        }
+        put_id_dict(ctx->net_aliases);
+
+        body.put<uint32_t>(ctx->hierarchy.size());
+        for (auto &hier : ctx->hierarchy) {
+            const HierarchicalCell &hc = hier.second;
+            put_id(hier.first);
+            put_id(hc.name);
+            put_id(hc.type);
+            put_id(hc.parent);
+            put_id(hc.fullpath);
+            put_id_dict(hc.leaf_cells);
+            put_id_dict(hc.nets);
+            put_id_dict(hc.leaf_cells_by_gname);
+            put_id_dict(hc.nets_by_gname);
+            body.put<uint32_t>(hc.ports.size());
+            for (auto &port : hc.ports) {
+                put_id(port.first);
+                put_id(port.second.name);
+                body.put<uint8_t>(port.second.dir);
+                put_ids(port.second.nets);
+                body.put<int32_t>(port.second.offset);
+                body.put<uint8_t>(port.second.upto);
+            }
+            put_id_dict(hc.hier_cells);
+        }
+
+        // Regions, pseudo cells and bindings last, as they refer to names of arch objects rather than the design
+        body.put<uint32_t>(ctx->region.size());
+        for (auto &region : ctx->region) {
+            const Region *r = region.second.get();
+            put_id(region.first);
+            put_id(r->name);
+            body.put<uint8_t>(r->constr_bels);
+            body.put<uint8_t>(r->constr_wires);
+            body.put<uint8_t>(r->constr_pips);
+            body.put<uint32_t>(r->bels.size());
+            for (BelId bel : r->bels)
+                put_id_list(ctx->getBelName(bel));
+            body.put<uint32_t>(r->wires.size());
+            for (WireId wire : r->wires)
+                put_id_list(ctx->getWireName(wire));
+            body.put<uint32_t>(r->piplocs.size());
+            for (Loc loc : r->piplocs)
+                body.put<Loc>(loc);
+        }
+        for (auto &cell : ctx->cells) {
+            const CellInfo *ci = cell.second.get();
+            put_id(ci->region ? ci->region->name : IdString());
+            if (!ci->pseudo_cell) {
+                body.put<uint8_t>(0);
+                continue;
+            }
+            auto plug = dynamic_cast<const RegionPlug *>(ci->pseudo_cell.get());
+            if (plug == nullptr)
+                log_error("Cell '%s' is a kind of pseudo cell that can't be stored in a checkpoint.\n",
+                          ctx->nameOf(ci));
+            body.put<uint8_t>(1);
+            body.put<Loc>(plug->loc);
+            body.put<uint32_t>(plug->port_wires.size());
+            for (auto &port : plug->port_wires) {
+                put_id(port.first);
+                put_id_list(ctx->getWireName(port.second));
+            }
+        }
+        for (auto &cell : ctx->cells) {
+            const CellInfo *ci = cell.second.get();
+            if (ci->bel == BelId()) {
+                body.put<uint32_t>(0);
+                continue;
+            }
+            put_id_list(ctx->getBelName(ci->bel));
+            body.put<uint8_t>(ci->belStrength);
+        }
+        for (auto &net : ctx->nets) {
+            const NetInfo *ni = net.second.get();
+            body.put<uint32_t>(ni->wires.size());
+            for (auto &wire : ni->wires) {
+                if (wire.second.pip == PipId()) {
+                    body.put<uint8_t>(0);
+                    put_id_list(ctx->getWireName(wire.first));
+                } else {
+                    body.put<uint8_t>(1);
+                    put_id_list(ctx->getPipName(wire.second.pip));
+                }
+                body.put<uint8_t>(wire.second.strength);
+            }
+        }
+    }
+
+    std::vector<char> write_header()
+    {
+        ByteWriter head;
+        head.data.insert(head.data.end(), checkpoint_magic, checkpoint_magic + sizeof(checkpoint_magic));
+        head.put<uint32_t>(checkpoint_version);
+        head.put_str(ctx->archId().str(ctx));
+        head.put_str(ctx->getChipName());
+        head.put<uint32_t>(id_list.size());
+        for (IdString id : id_list)
+            head.put_str(id.str(ctx));
+        return std::move(head.data);
+    }
+};
+
+struct CheckpointReader
+{
+    CheckpointReader(Context *ctx, const std::string &filename, const char *data, size_t size)
+            : ctx(ctx), filename(filename), ptr(data), end(data + size){};
+
+    Context *ctx;
+    const std::string &filename;
+    const char *ptr, *end;
+    std::vector<IdString> ids;
+    std::vector<CellInfo *> cells;
+    std::vector<NetInfo *> nets;
+
+    [[noreturn]] void corrupt() { log_error("Checkpoint file '%s' is truncated or corrupt.\n", filename.c_str()); }
+
+    template <typename T> T get()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read directly");
+        if (size_t(end - ptr) < sizeof(T))
+            corrupt();
+        T value;
+        std::memcpy(&value, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return value;
+    }
+
+    std::string get_str()
+    {
+        uint32_t len = get<uint32_t>();
+        if (size_t(end - ptr) < len)
+            corrupt();
+        std::string str(ptr, len);
+        ptr += len;
+        return str;
+    }
+
+    IdString get_id()
+    {
+        uint32_t idx = get<uint32_t>();
+        if (idx >= ids.size())
+            corrupt();
+        return ids[idx];
+    }
+
+    IdStringList get_id_list()
+    {
+        uint32_t len = get<uint32_t>();
+        IdStringList list{size_t(len)};
+        for (uint32_t i = 0; i < len; i++)
+            list.ids[i] = get_id();
+        return list;
+    }
+
+    void get_ids(std::vector<IdString> &out)
+    {
+        uint32_t len = get<uint32_t>();
+        out.reserve(len);
+        for (uint32_t i = 0; i < len; i++)
+            out.push_back(get_id());
+    }
+
+    void get_id_dict(dict<IdString, IdString> &out)
+    {
+        uint32_t len = get<uint32_t>();
+        for (uint32_t i = 0; i < len; i++) {
+            IdString key = get_id();
+            out[key] = get_id();
+        }
+    }
+
+    void get_props(dict<IdString, Property> &out)
+    {
+        uint32_t len = get<uint32_t>();
+        for (uint32_t i = 0; i < len; i++) {
+            Property &prop = out[get_id()];
+            prop.is_string = get<uint8_t>();
+            prop.str = get_str();
+            if (prop.is_string)
+                prop.intval = 0;
+            else
+                prop.update_intval();
+        }
+    }
+
+    CellInfo *get_cell_ref()
+    {
+        int32_t idx = get<int32_t>();
+        if (idx < -1 || idx >= int32_t(cells.size()))
+            corrupt();
+        return idx == -1 ? nullptr : cells.at(idx);
+    }
+
+    NetInfo *get_net_ref()
+    {
+        int32_t idx = get<int32_t>();
+        if (idx < -1 || idx >= int32_t(nets.size()))
+            corrupt();
+        return idx == -1 ? nullptr : nets.at(idx);
+    }
+
+    template <typename T> void get_cluster_info(T *ci)
+    {
+        if constexpr (std::is_base_of<BaseClusterInfo, T>::value) {
+            uint32_t child_count = get<uint32_t>();
+            for (uint32_t i = 0; i < child_count; i++) {
+                CellInfo *child = get_cell_ref();
+                if (child == nullptr)
+                    corrupt();
+                ci->constr_children.push_back(child);
+            }
+            ci->constr_x = get<int32_t>();
+            ci->constr_y = get<int32_t>();
+            ci->constr_z = get<int32_t>();
+            ci->constr_abs_z = get<uint8_t>();
+        }
+    }
+
+    BelId get_bel(const char *what, IdString of)
+    {
+        IdStringList name = get_id_list();
+        BelId bel = ctx->getBelByName(name);
+        if (bel == BelId())
+            log_error("Bel '%s' of %s '%s' in checkpoint '%s' doesn't exist.\n", name.str(ctx).c_str(), what,
+                      of.c_str(ctx), filename.c_str());
+        return bel;
+    }
+
+    WireId get_wire(const char *what, IdString of)
+    {
+        IdStringList name = get_id_list();
+        WireId wire = ctx->getWireByName(name);
+        if (wire == WireId())
+            log_error("Wire '%s' of %s '%s' in checkpoint '%s' doesn't exist.\n", name.str(ctx).c_str(), what,
+                      of.c_str(ctx), filename.c_str());
+        return wire;
+    }
+
+    PortType get_port_type()
+    {
+        uint8_t type = get<uint8_t>();
+        if (type != PORT_IN && type != PORT_OUT && type != PORT_INOUT)
+            corrupt();
+        return PortType(type);
+    }
+
+    void read_header()
+    {
+        if (size_t(end - ptr) < sizeof(checkpoint_magic) ||
+            std::memcmp(ptr, checkpoint_magic, sizeof(checkpoint_magic)) != 0)
+            log_error("File '%s' is not a nextpnr checkpoint.\n", filename.c_str());
+        ptr += sizeof(checkpoint_magic);
+        uint32_t version = get<uint32_t>();
+        if (version != checkpoint_version)
+            log_error("Checkpoint file '%s' has version %u, but this nextpnr expects version %u.\n", filename.c_str(),
+                      version, checkpoint_version);
+        std::string arch = get_str(), chip = get_str();
+        if (arch != ctx->archId().str(ctx) || chip != ctx->getChipName())
+            log_error("Checkpoint file '%s' is for %s device '%s', not %s device '%s'.\n", filename.c_str(),
+                      arch.c_str(), chip.c_str(), ctx->archId().c_str(ctx), ctx->getChipName().c_str());
+        uint32_t id_count = get<uint32_t>();
+        ids.reserve(id_count);
+        for (uint32_t i = 0; i < id_count; i++)
+            ids.push_back(ctx->id(get_str()));
+    }
+
+    void read_body()
+    {
+        get_props(ctx->settings);
+        get_props(ctx->attrs);
+        ctx->top_module = get_id();
+
+        uint32_t net_count = get<uint32_t>();
+        nets.reserve(net_count);
+        for (uint32_t i = 0; i < net_count; i++) {
+            NetInfo *ni = ctx->createNet(get_id());
+            ni->hierpath = get_id();
+            ni->constant_value = get_id();
+            get_props(ni->attrs);
+            get_ids(ni->aliases);
+            if (get<uint8_t>())
+                ni->clkconstr = std::make_unique<ClockConstraint>(get<ClockConstraint>());
+            nets.push_back(ni);
+        }
+
+        uint32_t cell_count = get<uint32_t>();
+        cells.reserve(cell_count);
+        for (uint32_t i = 0; i < cell_count; i++) {
+            IdString name = get_id();
+            CellInfo *ci = ctx->createCell(name, get_id());
+            ci->hierpath = get_id();
+            get_props(ci->params);
+            get_props(ci->attrs);
+            uint32_t port_count = get<uint32_t>();
+            for (uint32_t j = 0; j < port_count; j++) {
+                IdString port_name = get_id();
+                PortInfo &port = ci->ports[port_name];
+                port.name = port_name;
+                port.type = get_port_type();
+                port.net = get_net_ref();
+            }
+            cells.push_back(ci);
+        }
+
+        for (NetInfo *ni : nets) {
+            ni->driver.cell = get_cell_ref();
+            ni->driver.port = get_id();
+            uint32_t user_count = get<uint32_t>();
+            for (uint32_t j = 0; j < user_count; j++) {
+                PortRef usr;
+                usr.cell = get_cell_ref();
+                usr.port = get_id();
+                if (usr.cell == nullptr || !usr.cell->ports.count(usr.port))
+                    corrupt();
+                usr.cell->ports.at(usr.port).user_idx = ni->users.add(usr);
+            }
+        }
+
+        for (CellInfo *ci : cells) {
+            ci->cluster = get_id();
+            get_cluster_info(ci);
+        }
+
+        uint32_t port_count = get<uint32_t>();
+        for (uint32_t i = 0; i < port_count; i++) {
+            IdString name = get_id();
+            PortInfo &port = ctx->ports[name];
+            port.name = name;
+            port.type = get_port_type();
+            port.net = get_net_ref();
+        }
+        uint32_t port_cell_count = get<uint32_t>();
+        for (uint32_t i = 0; i < port_cell_count; i++) {
+            IdString name = get_id();
+            ctx->port_cells[name] = get_cell_ref();
+        }
+        get_id_dict(ctx->net_aliases);
+
+        uint32_t hier_count = get<uint32_t>();
+        for (uint32_t i = 0; i < hier_count; i++) {
+            HierarchicalCell &hc = ctx->hierarchy[get_id()];
+            hc.name = get_id();
+            hc.type = get_id();
+            hc.parent = get_id();
+            hc.fullpath = get_id();
+            get_id_dict(hc.leaf_cells);
+            get_id_dict(hc.nets);
+            get_id_dict(hc.leaf_cells_by_gname);
+            get_id_dict(hc.nets_by_gname);
+            uint32_t hier_port_count = get<uint32_t>();
+            for (uint32_t j = 0; j < hier_port_count; j++) {
+                HierarchicalPort &port = hc.ports[get_id()];
+                port.name = get_id();
+                port.dir = get_port_type();
+                get_ids(port.nets);
+                port.offset = get<int32_t>();
+                port.upto = get<uint8_t>();
+            }
+            get_id_dict(hc.hier_cells);
+        }
+
+        uint32_t region_count = get<uint32_t>();
+        for (uint32_t i = 0; i < region_count; i++) {
+            IdString key = get_id();
+            auto &region = ctx->region[key];
+            region = std::make_unique<Region>();
+            region->name = get_id();
+            region->constr_bels = get<uint8_t>();
+            region->constr_wires = get<uint8_t>();
+            region->constr_pips = get<uint8_t>();
+            uint32_t bel_count = get<uint32_t>();
+            for (uint32_t j = 0; j < bel_count; j++)
+                region->bels.insert(get_bel("region", key));
+            uint32_t wire_count = get<uint32_t>();
+            for (uint32_t j = 0; j < wire_count; j++)
+                region->wires.insert(get_wire("region", key));
+            uint32_t piploc_count = get<uint32_t>();
+            for (uint32_t j = 0; j < piploc_count; j++)
+                region->piplocs.insert(get<Loc>());
+        }
+        for (CellInfo *ci : cells) {
+            IdString region = get_id();
+            if (region != IdString()) {
+                if (!ctx->region.count(region))
+                    corrupt();
+                ci->region = ctx->region.at(region).get();
+            }
+            if (!get<uint8_t>())
+                continue;
+            auto plug = std::make_unique<RegionPlug>(get<Loc>());
+            uint32_t plug_port_count = get<uint32_t>();
+            for (uint32_t j = 0; j < plug_port_count; j++) {
+                IdString port = get_id();
+                plug->port_wires[port] = get_wire("cell", ci->name);
+            }
+            ci->pseudo_cell = std::move(plug);
+        }
+        for (CellInfo *ci : cells) {
+            IdStringList name = get_id_list();
+            if (name.size() == 0)
+                continue;
+            PlaceStrength strength = PlaceStrength(get<uint8_t>());
+            BelId bel = ctx->getBelByName(name);
+            if (bel == BelId())
+                log_error("Bel '%s' of cell '%s' in checkpoint '%s' doesn't exist.\n", name.str(ctx).c_str(),
+                          ci->name.c_str(ctx), filename.c_str());
+            ctx->bindBel(bel, ci, strength);
+        }
+        for (NetInfo *ni : nets) {
+            uint32_t wire_count = get<uint32_t>();
+            for (uint32_t j = 0; j < wire_count; j++) {
+                bool is_pip = get<uint8_t>();
+                IdStringList name = get_id_list();
+                PlaceStrength strength = PlaceStrength(get<uint8_t>());
+                if (is_pip) {
+                    PipId pip = ctx->getPipByName(name);
+                    if (pip == PipId())
+                        log_error("Pip '%s' of net '%s' in checkpoint '%s' doesn't exist.\n", name.str(ctx).c_str(),
+                                  ni->name.c_str(ctx), filename.c_str());
+                    ctx->bindPip(pip, ni, strength);
+                } else {
+                    WireId wire = ctx->getWireByName(name);
+                    if (wire == WireId())
+                        log_error("Wire '%s' of net '%s' in checkpoint '%s' doesn't exist.\n", name.str(ctx).c_str(),
+                                  ni->name.c_str(ctx), filename.c_str());
+                    ctx->bindWire(wire, ni, strength);
+                }
+            }
+        }
+
+        if (ptr != end)
+            corrupt();
+    }
+};
+
+} // namespace
+
+bool write_checkpoint(const std::string &filename, Context *ctx)
+{
+    try {
+        auto start = std::chrono::steady_clock::now();
+        CheckpointWriter wr(ctx);
+        wr.write_body();
+        std::vector<char> head = wr.write_header();
+
+        std::ofstream out(filename, std::ios::binary);
+        if (!out)
+            log_error("Failed to open checkpoint file '%s' for writing.\n", filename.c_str());
+        out.write(head.data(), head.size());
+        out.write(wr.body.data.data(), wr.body.data.size());
+        if (!out)
+            log_error("Failed to write checkpoint file '%s'.\n", filename.c_str());
+
+        auto end = std::chrono::steady_clock::now();
+        log_info("Wrote checkpoint '%s' (%.1f MiB) in %.2fs.\n", filename.c_str(),
+                 (head.size() + wr.body.data.size()) / (1024.0 * 1024.0),
+                 std::chrono::duration<double>(end - start).count());
+        return true;
+    } catch (log_execution_error_exception) {
+        return false;
+    }
+}
+
+bool read_checkpoint(const std::string &filename, Context *ctx)
+{
+    try {
+        auto start = std::chrono::steady_clock::now();
+        if (!ctx->cells.empty() || !ctx->nets.empty())
+            log_error("Cannot load checkpoint '%s' into a context that already contains a design.\n",
+                      filename.c_str());
+        boost::iostreams::mapped_file_source mapped;
+        try {
+            mapped.open(filename);
+        } catch (std::ios_base::failure &fail) {
+            log_error("Failed to open checkpoint file '%s'.\n", filename.c_str());
+        }
+        if (!mapped.is_open())
+            log_error("Failed to open checkpoint file '%s'.\n", filename.c_str());
+
+        CheckpointReader rd(ctx, filename, mapped.data(), mapped.size());
+        rd.read_header();
+        rd.read_body();
+        ctx->assignArchInfo();
+        ctx->design_loaded = true;
+
+        auto end = std::chrono::steady_clock::now();
+        log_info("Loaded checkpoint '%s' (%d cells, %d nets) in %.2fs.\n", filename.c_str(), int(ctx->cells.size()),
+                 int(ctx->nets.size()), std::chrono::duration<double>(end - start).count());
+        return true;
+    } catch (log_execution_error_exception) {
+        return false;
+    }
+}
+
+NEXTPNR_NAMESPACE_END
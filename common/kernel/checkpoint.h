@@ -0,0 +1,46 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include "nextpnr.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Binary design checkpoints, for saving and restoring the state of a design between flow stages without going through
+// JSON and the frontend.
+//
+// A checkpoint holds the settings and attributes of the Context, cells, nets, their connectivity (including the order
+// of net users), net aliases, top-level ports, the design hierarchy, cluster constraints, floorplanning regions, region
+// plugs and bel/wire/pip bindings. Only the IdStrings used by the design are stored; they are re-interned on load. Arch
+// objects are stored by name, so a checkpoint can be loaded by any nextpnr build for the same arch and device.
+//
+// Arch-specific cell state (ArchCellInfo) is not stored, but rebuilt by assignArchInfo after loading, as it is when
+// a placed or routed design is loaded from JSON, except for the relative placement constraints of BaseClusterInfo.
+//
+// The file is written from a single buffer and memory-mapped on load.
+
+bool write_checkpoint(const std::string &filename, Context *ctx);
+bool read_checkpoint(const std::string &filename, Context *ctx);
+
+NEXTPNR_NAMESPACE_END
+
+#endif
@@ -37,7 +37,9 @@
 #include <set>
 
 #include "command.h"
+#include "checkpoint.h"
 #include "design_utils.h"
+#include "gzip_writer.h"
 #include "json_frontend.h"
 #include "jsonwrite.h"
 #include "log.h"
@@ -342,6 +344,8 @@ po::options_description CommandHandler::getGeneralOptions()
 #endif
     general.add_options()("json", po::value<std::string>(), "JSON design file to ingest");
     general.add_options()("write", po::value<std::string>(), "JSON design file to write");
+    general.add_options()("checkpoint", po::value<std::string>(), "binary design checkpoint to restore");
+    general.add_options()("write-checkpoint", po::value<std::string>(), "binary design checkpoint to write");
     general.add_options()("top", po::value<std::string>(), "name of top module");
     general.add_options()("seed", po::value<uint64_t>(), "seed value for random number generator");
     general.add_options()("randomize-seed,r", "randomize seed value for random number generator");
@@ -376,7 +380,8 @@ po::options_description CommandHandler::getGeneralOptions()
     general.add_options()("timing-allow-fail", "allow timing to fail in design");
     general.add_options()("no-tmdriv", "disable timing-driven placement");
     general.add_options()("sdc", po::value<std::string>(), "Generic timing constraints SDC file to load");
-    general.add_options()("sdf", po::value<std::string>(), "SDF delay back-annotation file to write");
+    general.add_options()("sdf", po::value<std::string>(),
+                          "SDF delay back-annotation file to write (gzip-compressed if the name ends in .gz)");
     general.add_options()("sdf-cvc", "enable tweaks for SDF file compatibility with the CVC simulator");
     general.add_options()("no-print-critical-path-source",
                           "disable printing of the line numbers associated with each net in the critical path");
@@ -398,12 +403,21 @@ po::options_description CommandHandler::getGeneralOptions()
 
     general.add_options()("router2-heatmap", po::value<std::string>(),
                           "prefix for router2 resource congestion heatmaps");
+    general.add_options()("router2-trace", po::value<std::string>(),
+                          "write a Chrome trace of router2 phases on each thread to this JSON file");
 
     general.add_options()("tmg-ripup", "enable experimental timing-driven ripup in router");
     general.add_options()("router2-tmg-ripup",
                           "enable experimental timing-driven ripup in router (deprecated; use --tmg-ripup instead)");
 
     general.add_options()("router2-alt-weights", "use alternate router2 weights");
+    general.add_options()("router2-eco", "only reroute nets whose existing routing is no longer valid (ECO mode)");
+
+    general.add_options()("router-lookahead",
+                          "use a routing lookahead sampled from the routing graph, on architectures that support it");
+    general.add_options()("router-lookahead-cache", po::value<std::string>(),
+                          "file to cache the routing lookahead in (default: in the user cache directory)");
+    general.add_options()("router-lookahead-rebuild", "ignore any cached routing lookahead and rebuild it");
 
     general.add_options()("report", po::value<std::string>(),
                           "write timing and utilization report in JSON format to file");
@@ -540,11 +554,22 @@ void CommandHandler::setupContext(Context *ctx)
 
     if (vm.count("router2-heatmap"))
         ctx->settings[ctx->id("router2/heatmap")] = vm["router2-heatmap"].as<std::string>();
+    if (vm.count("router2-trace"))
+        ctx->settings[ctx->id("router2/trace")] = vm["router2-trace"].as<std::string>();
     if (vm.count("tmg-ripup") || vm.count("router2-tmg-ripup"))
         ctx->settings[ctx->id("router/tmg_ripup")] = true;
 
     if (vm.count("router2-alt-weights"))
         ctx->settings[ctx->id("router2/alt-weights")] = true;
+    if (vm.count("router2-eco"))
+        ctx->settings[ctx->id("router2/eco")] = true;
+
+    if (vm.count("router-lookahead"))
+        ctx->settings[ctx->id("router/lookahead")] = true;
+    if (vm.count("router-lookahead-cache"))
+        ctx->settings[ctx->id("router/lookahead/cache")] = vm["router-lookahead-cache"].as<std::string>();
+    if (vm.count("router-lookahead-rebuild"))
+        ctx->settings[ctx->id("router/lookahead/rebuild")] = true;
 
     if (vm.count("static-dump-density"))
         ctx->settings[ctx->id("static/dump_density")] = true;
@@ -596,6 +621,8 @@ int CommandHandler::executeMain(std::unique_ptr<Context> ctx)
         ctx->settings[ctx->id("frontend/top")] = vm["top"].as<std::string>();
     }
 
+    conflicting_options(vm, "json", "checkpoint");
+
 #ifndef NO_GUI
     if (vm.count("gui")) {
         Application a(argc, argv, (vm.count("gui-no-aa") > 0));
@@ -642,6 +669,21 @@ int CommandHandler::executeMain(std::unique_ptr<Context> ctx)
         customAfterLoad(ctx.get());
     }
 
+    if (vm.count("checkpoint")) {
+        std::string filename = vm["checkpoint"].as<std::string>();
+        if (!read_checkpoint(filename, ctx.get()))
+            log_error("Loading checkpoint failed.\n");
+
+        if (vm.count("sdc")) {
+            std::string sdc_filename = vm["sdc"].as<std::string>();
+            std::ifstream sdc_stream(sdc_filename);
+            ctx->read_sdc(sdc_stream);
+        }
+
+        // As for a design loaded from JSON, so that constraint files (--pcf, --lpf, ...) are applied
+        customAfterLoad(ctx.get());
+    }
+
 #ifndef NO_PYTHON
     init_python(argv[0]);
     python_export_global("ctx", *ctx);
@@ -702,12 +744,33 @@ int CommandHandler::executeMain(std::unique_ptr<Context> ctx)
             log_error("Saving design failed.\n");
     }
 
+    if (vm.count("write-checkpoint")) {
+        if (!write_checkpoint(vm["write-checkpoint"].as<std::string>(), ctx.get()))
+            log_error("Saving checkpoint failed.\n");
+    }
+
     if (vm.count("sdf")) {
         std::string filename = vm["sdf"].as<std::string>();
-        std::ofstream f(filename);
-        if (!f)
-            log_error("Failed to open SDF file '%s' for writing.\n", filename.c_str());
-        ctx->writeSDF(f, vm.count("sdf-cvc"));
+        if (boost::algorithm::ends_with(filename, ".gz")) {
+#ifdef NEXTPNR_USE_ZLIB
+            ParallelGzipBuf buf(ctx->threadPool());
+            if (!buf.open(filename))
+                log_error("Failed to open SDF file '%s' for writing.\n", filename.c_str());
+            {
+                std::ostream f(&buf);
+                ctx->writeSDF(f, vm.count("sdf-cvc"));
+            }
+            if (!buf.close())
+                log_error("Failed to write SDF file '%s'.\n", filename.c_str());
+#else
+            log_error("Writing a gzip-compressed SDF file requires nextpnr to be built with zlib.\n");
+#endif
+        } else {
+            std::ofstream f(filename);
+            if (!f)
+                log_error("Failed to open SDF file '%s' for writing.\n", filename.c_str());
+            ctx->writeSDF(f, vm.count("sdf-cvc"));
+        }
     }
 
     if (vm.count("report")) {
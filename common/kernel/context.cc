@@ -215,6 +215,20 @@ DelayQuad Context::getNetinfoRouteDelayQuad(const NetInfo *net_info, const PortR
     return result;
 }
 
+ThreadPool &Context::threadPool() const
+{
+    auto create = [&]() {
+        thread_pool = std::make_unique<ThreadPool>(settings.count(id("threads")) ? setting<int>("threads") : 8);
+    };
+#ifndef NPNR_DISABLE_THREADS
+    std::call_once(thread_pool_once, create);
+#else
+    if (!thread_pool)
+        create();
+#endif
+    return *thread_pool;
+}
+
 static uint32_t xorshift32(uint32_t x)
 {
     x ^= x << 13;
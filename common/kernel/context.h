@@ -22,9 +22,13 @@
 #define CONTEXT_H
 
 #include <boost/lexical_cast.hpp>
+#ifndef NPNR_DISABLE_THREADS
+#include <mutex>
+#endif
 
 #include "arch.h"
 #include "deterministic_rng.h"
+#include "thread_pool.h"
 
 NEXTPNR_NAMESPACE_BEGIN
 
@@ -61,7 +65,9 @@ struct Context : Arch, DeterministicRNG
     DelayQuad getNetinfoRouteDelayQuad(const NetInfo *net_info, const PortRef &sink) const;
 
     // provided by router1.cc
-    bool checkRoutedDesign() const;
+    // Checks that every net is routed as a tree of wires and pips bound to it, from its driver to all of its sinks. Nets
+    // that fail are added to failed_nets, if given
+    bool checkRoutedDesign(std::vector<NetInfo *> *failed_nets = nullptr) const;
     bool getActualRouteDelay(WireId src_wire, WireId dst_wire, delay_t *delay = nullptr,
                              dict<WireId, PipId> *route = nullptr, bool useEstimate = true);
 
@@ -111,6 +117,16 @@ struct Context : Arch, DeterministicRNG
 
     // --------------------------------------------------------------
 
+    // Thread pool shared by all parallel passes, created with the "threads" setting on first use. That first use may
+    // come from several threads at once, so creation goes through thread_pool_once
+    mutable std::unique_ptr<ThreadPool> thread_pool;
+#ifndef NPNR_DISABLE_THREADS
+    mutable std::once_flag thread_pool_once;
+#endif
+    ThreadPool &threadPool() const;
+
+    // --------------------------------------------------------------
+
     uint32_t checksum() const;
 
     void check() const;
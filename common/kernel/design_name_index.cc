@@ -0,0 +1,141 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "design_name_index.h"
+#include <regex>
+#include "log.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+template <typename F>
+std::vector<IdString> DesignNameIndex::match(ObjectIndex &idx, const std::string &name, bool regexp, F build)
+{
+    if (!idx.index) {
+        idx.index = std::make_unique<HierNameIndex>();
+        build(idx);
+    }
+    std::vector<int32_t> found;
+    if (regexp) {
+        try {
+            found = idx.index->match_regex(name);
+        } catch (const std::regex_error &e) {
+            log_error("invalid regular expression '%s': %s\n", name.c_str(), e.what());
+        }
+    } else {
+        found = idx.index->match_glob(name);
+    }
+    std::vector<IdString> result;
+    result.reserve(found.size());
+    for (int32_t i : found)
+        result.push_back(idx.objects.at(i));
+    return result;
+}
+
+std::vector<IdString> DesignNameIndex::get_cells(const std::string &name, bool regexp)
+{
+    if (!regexp && !HierNameIndex::is_glob(name)) {
+        IdString id = ctx->id(name);
+        if (ctx->cells.count(id))
+            return {id};
+        return {};
+    }
+    return match(cells, name, regexp, [&](ObjectIndex &idx) {
+        for (auto &cell : ctx->cells) {
+            idx.index->add(cell.first.str(ctx), int32_t(idx.objects.size()));
+            idx.objects.push_back(cell.first);
+        }
+    });
+}
+
+std::vector<IdString> DesignNameIndex::get_nets(const std::string &name, bool regexp)
+{
+    if (!regexp && !HierNameIndex::is_glob(name)) {
+        IdString id = ctx->id(name);
+        if (ctx->nets.count(id))
+            return {id};
+        if (ctx->net_aliases.count(id))
+            return {ctx->net_aliases.at(id)};
+        return {};
+    }
+    return match(nets, name, regexp, [&](ObjectIndex &idx) {
+        dict<IdString, int32_t> net_to_idx;
+        for (auto &net : ctx->nets) {
+            net_to_idx[net.first] = int32_t(idx.objects.size());
+            idx.index->add(net.first.str(ctx), int32_t(idx.objects.size()));
+            idx.objects.push_back(net.first);
+        }
+        // Aliases match as the net they refer to
+        for (auto &alias : ctx->net_aliases) {
+            auto found = net_to_idx.find(alias.second);
+            if (found != net_to_idx.end() && !ctx->nets.count(alias.first))
+                idx.index->add(alias.first.str(ctx), found->second);
+        }
+    });
+}
+
+std::vector<IdString> DesignNameIndex::get_ports(const std::string &name, bool regexp)
+{
+    if (!regexp && !HierNameIndex::is_glob(name)) {
+        IdString id = ctx->id(name);
+        if (ctx->ports.count(id))
+            return {id};
+        return {};
+    }
+    return match(ports, name, regexp, [&](ObjectIndex &idx) {
+        for (auto &port : ctx->ports) {
+            idx.index->add(port.first.str(ctx), int32_t(idx.objects.size()));
+            idx.objects.push_back(port.first);
+        }
+    });
+}
+
+std::vector<std::pair<IdString, IdString>> DesignNameIndex::get_pins(const std::string &name, bool regexp)
+{
+    std::vector<std::pair<IdString, IdString>> result;
+    auto pos = name.rfind('/');
+    if (pos == std::string::npos)
+        return result;
+    std::string pin = name.substr(pos + 1);
+    auto cell_names = get_cells(name.substr(0, pos), regexp);
+    if (!regexp && !HierNameIndex::is_glob(pin)) {
+        IdString pin_id = ctx->id(pin);
+        for (auto cell : cell_names)
+            if (ctx->cells.at(cell)->ports.count(pin_id))
+                result.emplace_back(cell, pin_id);
+        return result;
+    }
+    std::regex pin_re;
+    if (regexp) {
+        try {
+            pin_re = std::regex(pin);
+        } catch (const std::regex_error &e) {
+            log_error("invalid regular expression '%s': %s\n", pin.c_str(), e.what());
+        }
+    }
+    for (auto cell : cell_names) {
+        for (auto &port : ctx->cells.at(cell)->ports) {
+            const std::string &port_name = port.first.str(ctx);
+            if (regexp ? std::regex_match(port_name, pin_re) : HierNameIndex::glob_match(pin, port_name))
+                result.emplace_back(cell, port.first);
+        }
+    }
+    return result;
+}
+
+NEXTPNR_NAMESPACE_END
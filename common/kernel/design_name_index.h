@@ -0,0 +1,63 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef DESIGN_NAME_INDEX_H
+#define DESIGN_NAME_INDEX_H
+
+#include <memory>
+#include "hier_name_index.h"
+#include "nextpnr.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Object lookup for the get_cells/get_nets/get_ports/get_pins queries of the constraint file readers (SDC, PDC, XDC).
+//
+// A name may be an exact object name, a glob pattern using `*` and `?`, or (with regexp set) a regular expression that
+// must match the whole name. Exact names are looked up directly; the HierNameIndex for cells, nets or ports is only
+// built on the first pattern query of that kind, and is not updated if the netlist changes afterwards.
+//
+// Malformed regular expressions are reported with log_error.
+struct DesignNameIndex
+{
+    explicit DesignNameIndex(const Context *ctx) : ctx(ctx) {};
+
+    std::vector<IdString> get_cells(const std::string &name, bool regexp = false);
+    // Net aliases are resolved to the name of the net
+    std::vector<IdString> get_nets(const std::string &name, bool regexp = false);
+    std::vector<IdString> get_ports(const std::string &name, bool regexp = false);
+    // Cell pins as "cell/pin", split at the last `/`. The cell part is matched as by get_cells and the pin part against
+    // the ports of each matching cell. Returns (cell, port) pairs
+    std::vector<std::pair<IdString, IdString>> get_pins(const std::string &name, bool regexp = false);
+
+  private:
+    struct ObjectIndex
+    {
+        std::unique_ptr<HierNameIndex> index;
+        std::vector<IdString> objects;
+    };
+
+    const Context *ctx;
+    ObjectIndex cells, nets, ports;
+
+    template <typename F> std::vector<IdString> match(ObjectIndex &idx, const std::string &name, bool regexp, F build);
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
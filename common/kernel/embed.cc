@@ -25,6 +25,14 @@ const void *get_chipdb(const std::string &filename)
     return nullptr;
 }
 
+size_t get_chipdb_size(const std::string &filename)
+{
+    std::string full_filename = EXTERNAL_CHIPDB_ROOT "/" + filename;
+    if (!boost::filesystem::exists(full_filename))
+        return 0;
+    return boost::filesystem::file_size(full_filename);
+}
+
 #elif defined(WIN32)
 
 const void *get_chipdb(const std::string &filename)
@@ -34,6 +42,12 @@ const void *get_chipdb(const std::string &filename)
     return ::LockResource(rcData);
 }
 
+size_t get_chipdb_size(const std::string &filename)
+{
+    HRSRC rc = ::FindResource(nullptr, filename.c_str(), RT_RCDATA);
+    return (rc == nullptr) ? 0 : ::SizeofResource(nullptr, rc);
+}
+
 #else
 
 EmbeddedFile *EmbeddedFile::head = nullptr;
@@ -46,6 +60,14 @@ const void *get_chipdb(const std::string &filename)
     return nullptr;
 }
 
+size_t get_chipdb_size(const std::string &filename)
+{
+    for (EmbeddedFile *file = EmbeddedFile::head; file; file = file->next)
+        if (file->filename == filename)
+            return file->size;
+    return 0;
+}
+
 #endif
 
 NEXTPNR_NAMESPACE_END
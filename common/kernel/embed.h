@@ -31,18 +31,28 @@ struct EmbeddedFile
 
     std::string filename;
     const void *content;
+    // Size in bytes, 0 if not known
+    size_t size = 0;
     EmbeddedFile *next = nullptr;
 
-    EmbeddedFile(const std::string &filename, const void *content) : filename(filename), content(content)
+    EmbeddedFile(const std::string &filename, const void *content, size_t size = 0)
+            : filename(filename), content(content), size(size)
     {
         next = head;
         head = this;
     }
+    // bbasm emits the blob as a char array with a terminating NUL, which is not part of the file
+    template <size_t N>
+    EmbeddedFile(const std::string &filename, const char (&content)[N]) : EmbeddedFile(filename, content, N - 1)
+    {
+    }
 };
 
 #endif
 
 const void *get_chipdb(const std::string &filename);
+// Size in bytes of a chipdb found by get_chipdb, or 0 if it is not known
+size_t get_chipdb_size(const std::string &filename);
 
 NEXTPNR_NAMESPACE_END
 
@@ -0,0 +1,92 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "graph_snapshot.h"
+#include <stdexcept>
+#include "log.h"
+#include "nextpnr.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+RoutingGraphSnapshot::RoutingGraphSnapshot(const Context *ctx) : ctx(ctx)
+{
+    int wire_count = ctx->getWireIndexCount();
+    arch_wire_index = (wire_count > 0);
+    if (arch_wire_index) {
+        wires.resize(wire_count);
+        for (auto wire : ctx->getWires())
+            wires.at(ctx->getWireIndex(wire)) = wire;
+    } else {
+        for (auto wire : ctx->getWires()) {
+            wire_to_index[wire] = int32_t(wires.size());
+            wires.push_back(wire);
+        }
+    }
+
+    // Pips are numbered by walking the wires in order, so the downhill lists come out already sorted
+    downhill_begin.reserve(wires.size() + 1);
+    for (int32_t i = 0; i < int32_t(wires.size()); i++) {
+        downhill_begin.push_back(int32_t(pips.size()));
+        if (wires.at(i) == WireId())
+            continue;
+        for (auto pip : ctx->getPipsDownhill(wires.at(i))) {
+            pips.push_back(pip);
+            pip_src.push_back(i);
+            pip_dst.push_back(wire_index(ctx->getPipDstWire(pip)));
+        }
+    }
+    downhill_begin.push_back(int32_t(pips.size()));
+
+    nets.reserve(ctx->nets.size());
+    net_source.reserve(ctx->nets.size());
+    sink_begin.reserve(ctx->nets.size() + 1);
+    for (auto &net : ctx->nets) {
+        NetInfo *ni = net.second.get();
+        nets.push_back(ni);
+        net_source.push_back(ni->driver.cell ? wire_index(ctx->getNetinfoSourceWire(ni)) : -1);
+        sink_begin.push_back(int32_t(sink_ports.size()));
+        for (auto &usr : ni->users) {
+            sink_ports.push_back(&usr);
+            sink_wire.push_back(ctx->getNetinfoSinkWireCount(ni, usr) > 0
+                                        ? wire_index(ctx->getNetinfoSinkWire(ni, usr, 0))
+                                        : -1);
+        }
+    }
+    sink_begin.push_back(int32_t(sink_ports.size()));
+}
+
+int32_t RoutingGraphSnapshot::wire_index(WireId wire) const
+{
+    if (wire == WireId())
+        return -1;
+    if (arch_wire_index)
+        return ctx->getWireIndex(wire);
+    auto found = wire_to_index.find(wire);
+    return found == wire_to_index.end() ? -1 : found->second;
+}
+
+IdStringList RoutingGraphSnapshot::wire_name(int32_t idx) const
+{
+    if (idx < 0 || idx >= int32_t(wires.size()))
+        throw std::out_of_range(stringf("wire number %d out of range", int(idx)));
+    WireId wire = wires.at(idx);
+    return (wire == WireId()) ? IdStringList() : ctx->getWireName(wire);
+}
+
+NEXTPNR_NAMESPACE_END
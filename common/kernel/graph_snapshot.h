@@ -0,0 +1,74 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include <vector>
+#include "nextpnr.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Snapshot of the routing graph and of the net endpoints, with wires, pips and nets numbered densely and all the
+// connectivity held in flat integer arrays (compressed sparse row form). It is meant for handing the device to code
+// outside of nextpnr - the Rust and Python bindings - in a few large arrays rather than one call per object.
+//
+// Wire numbers are the arch's dense wire indices (getWireIndex) where it has them, and the getWires() order otherwise.
+// Dense wire indices may have gaps; numbers without a wire hold WireId() and have no pips.
+// Pips are numbered in order of their source wire, so the pips downhill of wire w are [downhill_begin[w],
+// downhill_begin[w + 1]). Nets are numbered in ctx->nets order, and the users of net n are [sink_begin[n],
+// sink_begin[n + 1]) in the sink arrays, in the order of net->users.
+//
+// The snapshot does not follow later changes to the netlist: NetInfo and PortRef pointers in it are only valid for as
+// long as the nets are not modified.
+struct RoutingGraphSnapshot
+{
+    explicit RoutingGraphSnapshot(const Context *ctx);
+
+    const Context *ctx;
+
+    std::vector<WireId> wires;
+    std::vector<PipId> pips;
+    std::vector<int32_t> pip_src, pip_dst;
+    // Size wires.size() + 1
+    std::vector<int32_t> downhill_begin;
+
+    std::vector<NetInfo *> nets;
+    // Source wire of each net, or -1 if it has none
+    std::vector<int32_t> net_source;
+    // Size nets.size() + 1
+    std::vector<int32_t> sink_begin;
+    std::vector<PortRef *> sink_ports;
+    // First sink wire of each user, or -1 if it has none
+    std::vector<int32_t> sink_wire;
+
+    // Returns the dense number of a wire, or -1 if it is not in the snapshot
+    int32_t wire_index(WireId wire) const;
+    // Returns the name of a wire number, or an empty name for a gap in the numbering. Throws std::out_of_range if idx
+    // is not below wires.size()
+    IdStringList wire_name(int32_t idx) const;
+
+  private:
+    dict<WireId, int32_t> wire_to_index;
+    bool arch_wire_index = false;
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "gzip_writer.h"
+
+#ifdef NEXTPNR_USE_ZLIB
+
+#include <algorithm>
+#include <chrono>
+#include "nextpnr_assertions.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+namespace {
+// Largest deflate window, and so the most of the previous block that is useful as a dictionary
+const size_t dictionary_size = 32768;
+} // namespace
+
+ParallelGzipBuf::ParallelGzipBuf(ThreadPool &pool, int level, size_t block_size)
+        : pool(pool), level(level), block_size(block_size), crc(crc32(0, Z_NULL, 0))
+{
+    NPNR_ASSERT(block_size > 0);
+    // Enough to keep every thread busy while the block at the front is being written out
+    max_in_flight = 2 * pool.size() + 1;
+}
+
+ParallelGzipBuf::~ParallelGzipBuf()
+{
+    if (file == nullptr)
+        return;
+    // Only reached without close() when writing was abandoned, likely while unwinding from an error, so don't finish
+    // the file or do anything else that might throw. The blocks still being compressed must finish before they are
+    // freed, though
+    for (auto &block : in_flight)
+        if (block->done.valid())
+            block->done.wait();
+    fclose(file);
+}
+
+bool ParallelGzipBuf::open(const std::string &filename)
+{
+    NPNR_ASSERT(file == nullptr);
+    file = fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+    ok = true;
+    crc = crc32(0, Z_NULL, 0);
+    total_in = total_out = 0;
+    total_compress_time = 0;
+    dictionary.clear();
+    current.resize(block_size);
+    setp(current.data(), current.data() + current.size());
+
+    // Member header: deflate, no flags, no modification time, unknown OS
+    const unsigned char header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+    write_bytes(header, sizeof(header));
+    return ok;
+}
+
+bool ParallelGzipBuf::close()
+{
+    NPNR_ASSERT(file != nullptr);
+    submit(true);
+    while (!in_flight.empty())
+        write_front();
+
+    // Member trailer: CRC-32 and the input size modulo 2^32, both little-endian
+    unsigned char trailer[8];
+    uint32_t isize = uint32_t(total_in);
+    for (int i = 0; i < 4; i++) {
+        trailer[i] = (crc >> (8 * i)) & 0xFF;
+        trailer[4 + i] = (isize >> (8 * i)) & 0xFF;
+    }
+    write_bytes(trailer, sizeof(trailer));
+
+    if (fclose(file) != 0)
+        ok = false;
+    file = nullptr;
+    setp(nullptr, nullptr);
+    return ok;
+}
+
+ParallelGzipBuf::int_type ParallelGzipBuf::overflow(int_type ch)
+{
+    if (file == nullptr)
+        return traits_type::eof();
+    submit(false);
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return ok ? traits_type::not_eof(ch) : traits_type::eof();
+}
+
+void ParallelGzipBuf::submit(bool last)
+{
+    auto block = std::make_unique<Block>();
+    current.resize(pptr() - pbase());
+    block->input = std::move(current);
+    block->dictionary = dictionary;
+    block->last = last;
+    total_in += block->input.size();
+
+    // The next block's dictionary is the last 32KiB of input so far, which may span more than this block
+    const std::vector<char> &input = block->input;
+    if (input.size() >= dictionary_size) {
+        dictionary.assign(input.end() - dictionary_size, input.end());
+    } else {
+        dictionary.insert(dictionary.end(), input.begin(), input.end());
+        if (dictionary.size() > dictionary_size)
+            dictionary.erase(dictionary.begin(), dictionary.end() - dictionary_size);
+    }
+
+    if (!last) {
+        current.assign(block_size, 0);
+        setp(current.data(), current.data() + current.size());
+    }
+
+    Block *b = block.get();
+    int lvl = level;
+    b->done = pool.async([b, lvl]() { compress(*b, lvl); });
+    in_flight.push_back(std::move(block));
+    while (in_flight.size() > max_in_flight)
+        write_front();
+}
+
+void ParallelGzipBuf::write_front()
+{
+    std::unique_ptr<Block> block = std::move(in_flight.front());
+    in_flight.pop_front();
+    block->done.get();
+    crc = crc32_combine(crc, block->crc, z_off_t(block->input.size()));
+    total_compress_time += block->time;
+    write_bytes(block->output.data(), block->output.size());
+}
+
+void ParallelGzipBuf::write_bytes(const void *data, size_t size)
+{
+    if (size == 0)
+        return;
+    if (fwrite(data, 1, size, file) != size)
+        ok = false;
+    total_out += size;
+}
+
+void ParallelGzipBuf::compress(Block &block, int level)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    z_stream strm{};
+    // Negative window bits give raw deflate data, as the header and trailer are written separately
+    NPNR_ASSERT(deflateInit2(&strm, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    if (!block.dictionary.empty())
+        NPNR_ASSERT(deflateSetDictionary(&strm, reinterpret_cast<const Bytef *>(block.dictionary.data()),
+                                         uInt(block.dictionary.size())) == Z_OK);
+
+    // deflateBound covers a finished stream; allow for the empty stored block of a sync flush on top
+    block.output.resize(deflateBound(&strm, uLong(block.input.size())) + 16);
+    strm.next_in = reinterpret_cast<Bytef *>(block.input.data());
+    strm.avail_in = uInt(block.input.size());
+    strm.next_out = block.output.data();
+    strm.avail_out = uInt(block.output.size());
+    // A sync flush ends the block on a byte boundary, so the next block's data can follow directly
+    int ret = deflate(&strm, block.last ? Z_FINISH : Z_SYNC_FLUSH);
+    NPNR_ASSERT(block.last ? (ret == Z_STREAM_END) : (ret == Z_OK && strm.avail_in == 0));
+    block.output.resize(block.output.size() - strm.avail_out);
+    deflateEnd(&strm);
+
+    block.crc = crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef *>(block.input.data()),
+                      uInt(block.input.size()));
+
+    auto end = std::chrono::high_resolution_clock::now();
+    block.time = std::chrono::duration<double>(end - start).count();
+}
+
+NEXTPNR_NAMESPACE_END
+
+#endif
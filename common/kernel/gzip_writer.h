@@ -0,0 +1,107 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef GZIP_WRITER_H
+#define GZIP_WRITER_H
+
+#ifdef NEXTPNR_USE_ZLIB
+
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include "nextpnr_namespaces.h"
+#include "thread_pool.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Stream buffer writing a gzip file, with the input compressed in fixed-size blocks on a thread pool (in the style of
+// pigz). Each block is deflated separately, using the end of the previous block as the preset dictionary, and the
+// blocks are joined with sync flushes; so the output is a single, ordinary gzip member that any gzip reader accepts.
+//
+// Blocks are written out in order as soon as they are compressed, with a bounded number in flight, so the whole input
+// is never held in memory at once. Use with a std::ostream (and kj::std::StdOutputStream to write a capnp message).
+//
+// Only available if nextpnr was built with zlib (NEXTPNR_USE_ZLIB).
+class ParallelGzipBuf : public std::streambuf
+{
+  public:
+    ParallelGzipBuf(ThreadPool &pool, int level = Z_DEFAULT_COMPRESSION, size_t block_size = 1 << 20);
+    ~ParallelGzipBuf();
+    ParallelGzipBuf(const ParallelGzipBuf &) = delete;
+    ParallelGzipBuf &operator=(const ParallelGzipBuf &) = delete;
+
+    // Returns false if the file cannot be created
+    bool open(const std::string &filename);
+    // Compresses and writes the remaining input and the gzip trailer, then closes the file. Returns false if any write
+    // failed. Must be called to finish the file: destroying an open buffer just closes it, leaving it incomplete
+    bool close();
+
+    size_t bytes_in() const { return total_in; }
+    size_t bytes_out() const { return total_out; }
+    // Time spent deflating, summed over all threads
+    double compress_time() const { return total_compress_time; }
+
+  protected:
+    int_type overflow(int_type ch) override;
+
+  private:
+    struct Block
+    {
+        std::vector<char> input;
+        // The last (up to) 32KiB of input before this block
+        std::vector<char> dictionary;
+        std::vector<unsigned char> output;
+        uLong crc = 0;
+        double time = 0;
+        bool last = false;
+        std::future<void> done;
+    };
+
+    ThreadPool &pool;
+    int level;
+    size_t block_size;
+    size_t max_in_flight;
+    FILE *file = nullptr;
+    bool ok = true;
+
+    std::vector<char> current;
+    std::vector<char> dictionary;
+    std::deque<std::unique_ptr<Block>> in_flight;
+
+    uLong crc;
+    size_t total_in = 0, total_out = 0;
+    double total_compress_time = 0;
+
+    void submit(bool last);
+    void write_front();
+    void write_bytes(const void *data, size_t size);
+    static void compress(Block &block, int level);
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
+
+#endif
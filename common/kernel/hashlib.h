@@ -26,6 +26,9 @@ NEXTPNR_NAMESPACE_BEGIN
 
 const int hashtable_size_trigger = 2;
 const int hashtable_size_factor = 3;
+// dicts and pools with at most this many entries are searched linearly and don't allocate a hashtable. Most of them in
+// a design (cell ports, attributes and parameters) are this small.
+const int hashtable_small_size = 8;
 
 // Cantor pairing function for two non-negative integers
 // https://en.wikipedia.org/wiki/Pairing_function
@@ -244,6 +247,11 @@ template <typename K, typename T, typename OPS> class dict
     void do_rehash()
     {
         hashtable.clear();
+        if (int(entries.size()) <= hashtable_small_size) {
+            for (auto &entry : entries)
+                entry.next = -1;
+            return;
+        }
         hashtable.resize(hashtable_size(entries.capacity() * hashtable_size_factor), -1);
 
         for (int i = 0; i < int(entries.size()); i++) {
@@ -257,9 +265,17 @@ template <typename K, typename T, typename OPS> class dict
     int do_erase(int index, int hash)
     {
         do_assert(index < int(entries.size()));
-        if (hashtable.empty() || index < 0)
+        if (index < 0)
             return 0;
 
+        if (hashtable.empty()) {
+            int back_idx = entries.size() - 1;
+            if (index != back_idx)
+                entries[index] = std::move(entries[back_idx]);
+            entries.pop_back();
+            return 1;
+        }
+
         int k = hashtable[hash];
         do_assert(0 <= k && k < int(entries.size()));
 
@@ -304,8 +320,12 @@ template <typename K, typename T, typename OPS> class dict
 
     int do_lookup(const K &key, int &hash) const
     {
-        if (hashtable.empty())
+        if (hashtable.empty()) {
+            for (int i = 0; i < int(entries.size()); i++)
+                if (ops.cmp(entries[i].udata.first, key))
+                    return i;
             return -1;
+        }
 
         if (entries.size() * hashtable_size_trigger > hashtable.size()) {
             ((dict *)this)->do_rehash();
@@ -717,6 +737,11 @@ template <typename K, typename OPS> class pool
     void do_rehash()
     {
         hashtable.clear();
+        if (int(entries.size()) <= hashtable_small_size) {
+            for (auto &entry : entries)
+                entry.next = -1;
+            return;
+        }
         hashtable.resize(hashtable_size(entries.capacity() * hashtable_size_factor), -1);
 
         for (int i = 0; i < int(entries.size()); i++) {
@@ -730,9 +755,17 @@ template <typename K, typename OPS> class pool
     int do_erase(int index, int hash)
     {
         do_assert(index < int(entries.size()));
-        if (hashtable.empty() || index < 0)
+        if (index < 0)
             return 0;
 
+        if (hashtable.empty()) {
+            int back_idx = entries.size() - 1;
+            if (index != back_idx)
+                entries[index] = std::move(entries[back_idx]);
+            entries.pop_back();
+            return 1;
+        }
+
         int k = hashtable[hash];
         if (k == index) {
             hashtable[hash] = entries[index].next;
@@ -773,8 +806,12 @@ template <typename K, typename OPS> class pool
 
     int do_lookup(const K &key, int &hash) const
     {
-        if (hashtable.empty())
+        if (hashtable.empty()) {
+            for (int i = 0; i < int(entries.size()); i++)
+                if (ops.cmp(entries[i].udata, key))
+                    return i;
             return -1;
+        }
 
         if (entries.size() * hashtable_size_trigger > hashtable.size()) {
             ((pool *)this)->do_rehash();
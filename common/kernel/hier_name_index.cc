@@ -0,0 +1,181 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "hier_name_index.h"
+#include <algorithm>
+#include <cstring>
+#include <regex>
+
+NEXTPNR_NAMESPACE_BEGIN
+
+bool HierNameIndex::glob_match(const std::string &pattern, const std::string &text, const std::string &separators)
+{
+    size_t p = 0, t = 0;
+    // Position after the last `*` seen and the text position it is currently matched up to, for backtracking
+    size_t star_p = std::string::npos, star_t = 0;
+    while (t < text.size()) {
+        bool is_sep = separators.find(text[t]) != std::string::npos;
+        if (p < pattern.size() && pattern[p] == '*') {
+            star_p = ++p;
+            star_t = t;
+        } else if (p < pattern.size() && (pattern[p] == text[t] || (pattern[p] == '?' && !is_sep))) {
+            ++p;
+            ++t;
+        } else if (star_p != std::string::npos && separators.find(text[star_t]) == std::string::npos) {
+            p = star_p;
+            t = ++star_t;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
+
+namespace {
+// The literal text every match of a regular expression must start with, or an empty string if that can't be worked
+// out simply
+std::string literal_prefix(const std::string &expr)
+{
+    if (expr.find('|') != std::string::npos)
+        return "";
+    std::string prefix;
+    for (size_t i = (!expr.empty() && expr.front() == '^') ? 1 : 0; i < expr.size(); i++) {
+        char c = expr[i];
+        if (std::strchr("\\.[](){}*+?|^$", c) != nullptr) {
+            // A quantifier may make the preceding character optional
+            if ((c == '*' || c == '?' || c == '{') && !prefix.empty())
+                prefix.pop_back();
+            break;
+        }
+        prefix += c;
+    }
+    return prefix;
+}
+} // namespace
+
+std::vector<std::string> HierNameIndex::split(const std::string &name) const
+{
+    std::vector<std::string> parts;
+    size_t start = 0;
+    for (size_t i = 1; i < name.size(); i++) {
+        if (separators.find(name[i]) != std::string::npos) {
+            parts.push_back(name.substr(start, i - start));
+            start = i;
+        }
+    }
+    parts.push_back(name.substr(start));
+    return parts;
+}
+
+void HierNameIndex::add(const std::string &name, int32_t value)
+{
+    int32_t node = 0;
+    for (auto &part : split(name)) {
+        auto inserted = child_by_label.emplace(std::make_pair(node, part), int32_t(nodes.size()));
+        if (inserted.second) {
+            nodes.at(node).children.push_back(int32_t(nodes.size()));
+            nodes.emplace_back();
+            nodes.back().label = part;
+        }
+        node = inserted.first->second;
+    }
+    Node &n = nodes.at(node);
+    if (n.name == -1) {
+        n.name = int32_t(names.size());
+        names.push_back(name);
+        values.push_back(value);
+    } else {
+        values.at(n.name) = value;
+    }
+}
+
+void HierNameIndex::collect(int32_t node, std::vector<int32_t> &out) const
+{
+    const Node &n = nodes.at(node);
+    if (n.name != -1)
+        out.push_back(n.name);
+    for (int32_t child : n.children)
+        collect(child, out);
+}
+
+void HierNameIndex::match_glob(int32_t node, const std::vector<std::string> &parts, size_t i,
+                               std::vector<int32_t> &out) const
+{
+    if (i == parts.size()) {
+        if (nodes.at(node).name != -1)
+            out.push_back(nodes.at(node).name);
+        return;
+    }
+    const std::string &part = parts.at(i);
+    if (!is_glob(part)) {
+        auto found = child_by_label.find(std::make_pair(node, part));
+        if (found != child_by_label.end())
+            match_glob(found->second, parts, i + 1, out);
+        return;
+    }
+    for (int32_t child : nodes.at(node).children)
+        if (glob_match(part, nodes.at(child).label, separators))
+            match_glob(child, parts, i + 1, out);
+}
+
+void HierNameIndex::match_prefix(int32_t node, const std::string &prefix, std::vector<int32_t> &out) const
+{
+    // Labels only contain a separator as their first character, so a prefix running into a later component can only
+    // continue through the child that is exactly its first component
+    size_t sep = prefix.empty() ? std::string::npos : prefix.find_first_of(separators, 1);
+    if (sep != std::string::npos) {
+        auto found = child_by_label.find(std::make_pair(node, prefix.substr(0, sep)));
+        if (found != child_by_label.end())
+            match_prefix(found->second, prefix.substr(sep), out);
+        return;
+    }
+    for (int32_t child : nodes.at(node).children)
+        if (nodes.at(child).label.compare(0, prefix.size(), prefix) == 0)
+            collect(child, out);
+}
+
+std::vector<int32_t> HierNameIndex::match_glob(const std::string &pattern) const
+{
+    std::vector<int32_t> found;
+    match_glob(0, split(pattern), 0, found);
+    std::vector<int32_t> result;
+    for (int32_t name : found)
+        result.push_back(values.at(name));
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+std::vector<int32_t> HierNameIndex::match_regex(const std::string &expr) const
+{
+    std::regex re(expr);
+    std::vector<int32_t> candidates;
+    match_prefix(0, literal_prefix(expr), candidates);
+    std::vector<int32_t> result;
+    for (int32_t name : candidates)
+        if (std::regex_match(names.at(name), re))
+            result.push_back(values.at(name));
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+NEXTPNR_NAMESPACE_END
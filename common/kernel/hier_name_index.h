@@ -0,0 +1,83 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef HIER_NAME_INDEX_H
+#define HIER_NAME_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "hashlib.h"
+#include "nextpnr_namespaces.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Index of hierarchical object names for constraint queries (get_cells, get_nets etc), so that wildcard patterns don't
+// have to be tested against every object in the design.
+//
+// Names are split into components at the hierarchy separators, with each component after the first keeping the
+// separator it starts with ("top/u_cpu.alu" is "top", "/u_cpu", ".alu"), and the components are stored as a trie.
+//
+// Glob patterns are split in the same way and matched one component at a time: `*` and `?` never match a separator,
+// so "top/*" matches "top/a" but not "top/a/b". Components without wildcards are looked up directly rather than
+// compared against every child. Regular expressions must match the whole name; only the part of the trie under the
+// literal prefix of the expression is searched.
+struct HierNameIndex
+{
+    explicit HierNameIndex(const std::string &separators = "/.") : separators(separators) { nodes.emplace_back(); }
+
+    // Add a name, returned as `value` by any query matching it. Adding the same name again replaces its value
+    void add(const std::string &name, int32_t value);
+
+    // Values of all names matching a glob pattern or a regular expression, in order of value. match_regex throws
+    // std::regex_error for a malformed expression
+    std::vector<int32_t> match_glob(const std::string &pattern) const;
+    std::vector<int32_t> match_regex(const std::string &expr) const;
+
+    // True if a name contains glob wildcards, so that exact lookups can skip the index
+    static bool is_glob(const std::string &name) { return name.find_first_of("*?") != std::string::npos; }
+    // Glob match of a single string, where wildcards don't match any of the separators
+    static bool glob_match(const std::string &pattern, const std::string &text, const std::string &separators = "");
+
+    size_t size() const { return names.size(); }
+
+  private:
+    struct Node
+    {
+        std::string label;
+        std::vector<int32_t> children;
+        // Index into names/values, -1 if no name ends at this node
+        int32_t name = -1;
+    };
+
+    std::string separators;
+    std::vector<Node> nodes;
+    dict<std::pair<int32_t, std::string>, int32_t> child_by_label;
+    std::vector<std::string> names;
+    std::vector<int32_t> values;
+
+    std::vector<std::string> split(const std::string &name) const;
+    void collect(int32_t node, std::vector<int32_t> &out) const;
+    void match_glob(int32_t node, const std::vector<std::string> &parts, size_t i, std::vector<int32_t> &out) const;
+    void match_prefix(int32_t node, const std::string &prefix, std::vector<int32_t> &out) const;
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
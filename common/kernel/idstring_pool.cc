@@ -0,0 +1,211 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "idstring_pool.h"
+
+#include <algorithm>
+
+#include "nextpnr_assertions.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+IdStringPool::IdStringPool() : chunks(new std::atomic<Entry *>[max_chunks]), shards(new Shard[num_shards])
+{
+    for (int i = 0; i < max_chunks; i++)
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+}
+
+IdStringPool::~IdStringPool()
+{
+    int n = count.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; i++)
+        delete entry(i).str.load(std::memory_order_relaxed);
+    for (int i = 0; i < max_chunks; i++)
+        delete[] chunks[i].load(std::memory_order_relaxed);
+}
+
+uint32_t IdStringPool::hash(std::string_view s)
+{
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (char c : s) {
+        h ^= uint8_t(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+const IdStringPool::Entry &IdStringPool::entry(int idx) const
+{
+    NPNR_ASSERT(idx >= 0 && idx < size());
+    const Entry *chunk = chunks[idx >> chunk_bits].load(std::memory_order_acquire);
+    NPNR_ASSERT(chunk != nullptr);
+    return chunk[idx & (chunk_size - 1)];
+}
+
+const std::string &IdStringPool::get(int idx) const
+{
+    const Entry &e = entry(idx);
+    std::string *str = e.str.load(std::memory_order_acquire);
+    if (str == nullptr) {
+        std::string *created = new std::string(e.data, e.size);
+        // If another thread got there first, use its copy instead
+        if (e.str.compare_exchange_strong(str, created, std::memory_order_acq_rel, std::memory_order_acquire))
+            str = created;
+        else
+            delete created;
+    }
+    return *str;
+}
+
+const char *IdStringPool::store(std::string_view s)
+{
+    size_t needed = s.size() + 1;
+    char *dst;
+    if (needed > arena_block_size / 4) {
+        // Long strings get a block of their own, rather than wasting the rest of the current one
+        arena.emplace_back(new char[needed]);
+        dst = arena.back().get();
+    } else {
+        if (needed > arena_left) {
+            arena.emplace_back(new char[arena_block_size]);
+            arena_next = arena.back().get();
+            arena_left = arena_block_size;
+        }
+        dst = arena_next;
+        arena_next += needed;
+        arena_left -= needed;
+    }
+    std::copy(s.begin(), s.end(), dst);
+    dst[s.size()] = '\0';
+    return dst;
+}
+
+int IdStringPool::append(std::string_view s)
+{
+#ifndef NPNR_DISABLE_THREADS
+    std::lock_guard<std::mutex> lock(append_mutex);
+#endif
+    int idx = count.load(std::memory_order_relaxed);
+    NPNR_ASSERT((idx >> chunk_bits) < max_chunks);
+    auto &chunk_ptr = chunks[idx >> chunk_bits];
+    Entry *chunk = chunk_ptr.load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new Entry[chunk_size];
+        chunk_ptr.store(chunk, std::memory_order_release);
+    }
+    Entry &e = chunk[idx & (chunk_size - 1)];
+    e.data = store(s);
+    e.size = uint32_t(s.size());
+    // Only now is the entry complete, so only now may other threads see idx as valid
+    count.store(idx + 1, std::memory_order_release);
+    return idx;
+}
+
+int IdStringPool::probe(const Table *table, std::string_view s, uint32_t h) const
+{
+    if (table == nullptr)
+        return -1;
+    for (uint32_t i = (h >> shard_bits) & table->mask;; i = (i + 1) & table->mask) {
+        uint64_t slot = table->slots[i].load(std::memory_order_acquire);
+        if (slot == 0)
+            return -1;
+        int idx = int(uint32_t(slot)) - 1;
+        if (uint32_t(slot >> 32) == h && view(idx) == s)
+            return idx;
+    }
+}
+
+void IdStringPool::insert_slot(Table *table, uint32_t h, int idx)
+{
+    uint32_t i = (h >> shard_bits) & table->mask;
+    while (table->slots[i].load(std::memory_order_relaxed) != 0)
+        i = (i + 1) & table->mask;
+    table->slots[i].store((uint64_t(h) << 32) | uint64_t(idx + 1), std::memory_order_release);
+}
+
+IdStringPool::Table *IdStringPool::grow(Shard &shard)
+{
+    Table *old_table = shard.table.load(std::memory_order_relaxed);
+    uint32_t new_size = old_table ? 2 * (old_table->mask + 1) : 64;
+    shard.tables.emplace_back(new Table(new_size));
+    Table *new_table = shard.tables.back().get();
+    for (uint32_t i = 0; i < new_size; i++)
+        new_table->slots[i].store(0, std::memory_order_relaxed);
+    if (old_table != nullptr) {
+        for (uint32_t i = 0; i <= old_table->mask; i++) {
+            uint64_t slot = old_table->slots[i].load(std::memory_order_relaxed);
+            if (slot != 0)
+                insert_slot(new_table, uint32_t(slot >> 32), int(uint32_t(slot)) - 1);
+        }
+    }
+    // The old table stays in shard.tables, in case another thread is still probing it
+    shard.table.store(new_table, std::memory_order_release);
+    return new_table;
+}
+
+int IdStringPool::add_locked(Shard &shard, std::string_view s, uint32_t h)
+{
+    Table *table = shard.table.load(std::memory_order_relaxed);
+    if (table == nullptr || 4 * (shard.entries + 1) > 3 * (table->mask + 1))
+        table = grow(shard);
+    int idx = append(s);
+    // Publishing the slot makes the string visible to lock-free lookups
+    insert_slot(table, h, idx);
+    ++shard.entries;
+    return idx;
+}
+
+int IdStringPool::find(std::string_view s) const
+{
+    uint32_t h = hash(s);
+    const Shard &shard = shards[h & (num_shards - 1)];
+    return probe(shard.table.load(std::memory_order_acquire), s, h);
+}
+
+int IdStringPool::intern(std::string_view s)
+{
+    uint32_t h = hash(s);
+    Shard &shard = shards[h & (num_shards - 1)];
+    int idx = probe(shard.table.load(std::memory_order_acquire), s, h);
+    if (idx != -1)
+        return idx;
+#ifndef NPNR_DISABLE_THREADS
+    std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+    // Another thread might have added it since the unlocked lookup
+    idx = probe(shard.table.load(std::memory_order_relaxed), s, h);
+    if (idx != -1)
+        return idx;
+    return add_locked(shard, s, h);
+}
+
+void IdStringPool::add(std::string_view s, int idx)
+{
+    uint32_t h = hash(s);
+    Shard &shard = shards[h & (num_shards - 1)];
+#ifndef NPNR_DISABLE_THREADS
+    std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+    NPNR_ASSERT(probe(shard.table.load(std::memory_order_relaxed), s, h) == -1);
+    int added = add_locked(shard, s, h);
+    NPNR_ASSERT(added == idx);
+}
+
+NEXTPNR_NAMESPACE_END
@@ -0,0 +1,131 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef IDSTRING_POOL_H
+#define IDSTRING_POOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nextpnr_namespaces.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// The string table behind IdString, which may be used from several threads at once.
+//
+// The characters of every string are appended to an arena of large blocks, and each index maps to a view into it.
+// Neither the views nor the arena ever move, so looking up a string by index needs no lock. The reverse map is split
+// into shards, each an open-addressing hash table. Finding a string that is already interned doesn't lock either; only
+// adding a new string takes the lock of its shard, plus a short global lock to append it. Tables replaced when a shard
+// grows are kept until the pool is destroyed, as other threads might still be probing them.
+//
+// get() returns a std::string, which is only created the first time it is asked for, so names only ever used through
+// view() or c_str() cost no extra allocation.
+//
+// Indices are handed out in the order strings are added, so they are only deterministic if all new strings are added
+// from one thread (or in a deterministic order).
+class IdStringPool
+{
+  public:
+    IdStringPool();
+    ~IdStringPool();
+    IdStringPool(const IdStringPool &) = delete;
+    IdStringPool &operator=(const IdStringPool &) = delete;
+
+    // Returns the index of s, adding it if it isn't in the pool yet
+    int intern(std::string_view s);
+    // Adds s, which must not be in the pool yet, and checks that it gets index idx
+    void add(std::string_view s, int idx);
+    // Returns the index of s, or -1 if it isn't in the pool
+    int find(std::string_view s) const;
+
+    std::string_view view(int idx) const
+    {
+        const Entry &e = entry(idx);
+        return std::string_view(e.data, e.size);
+    }
+    // NUL terminated
+    const char *c_str(int idx) const { return entry(idx).data; }
+    const std::string &get(int idx) const;
+    int size() const { return count.load(std::memory_order_acquire); }
+
+  private:
+    static constexpr int chunk_bits = 15;
+    static constexpr int chunk_size = 1 << chunk_bits;
+    static constexpr int max_chunks = 1 << 16;
+    static constexpr int shard_bits = 6;
+    static constexpr int num_shards = 1 << shard_bits;
+    static constexpr size_t arena_block_size = 1 << 20;
+
+    struct Entry
+    {
+        const char *data = nullptr;
+        uint32_t size = 0;
+        // Created by the first get()
+        mutable std::atomic<std::string *> str{nullptr};
+    };
+
+    // Each slot is (hash << 32) | (index + 1), or 0 if empty
+    struct Table
+    {
+        explicit Table(uint32_t size) : mask(size - 1), slots(new std::atomic<uint64_t>[size]) {}
+        uint32_t mask;
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+    };
+
+    struct Shard
+    {
+        std::atomic<Table *> table{nullptr};
+        std::vector<std::unique_ptr<Table>> tables;
+        uint32_t entries = 0;
+#ifndef NPNR_DISABLE_THREADS
+        std::mutex mutex;
+#endif
+    };
+
+    // Entries [0, count) are complete; count is only advanced once an entry has been written
+    std::unique_ptr<std::atomic<Entry *>[]> chunks;
+    std::atomic<int> count{0};
+    std::unique_ptr<Shard[]> shards;
+    // Only touched while holding append_mutex
+    std::vector<std::unique_ptr<char[]>> arena;
+    char *arena_next = nullptr;
+    size_t arena_left = 0;
+#ifndef NPNR_DISABLE_THREADS
+    std::mutex append_mutex;
+#endif
+
+    static uint32_t hash(std::string_view s);
+    const Entry &entry(int idx) const;
+    int probe(const Table *table, std::string_view s, uint32_t h) const;
+    void insert_slot(Table *table, uint32_t h, int idx);
+    Table *grow(Shard &shard);
+    const char *store(std::string_view s);
+    int append(std::string_view s);
+    int add_locked(Shard &shard, std::string_view s, uint32_t h);
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif /* IDSTRING_POOL_H */
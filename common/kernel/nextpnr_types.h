@@ -32,6 +32,7 @@
 #include "indexed_store.h"
 #include "nextpnr_base_types.h"
 #include "nextpnr_namespaces.h"
+#include "object_pool.h"
 #include "property.h"
 
 NEXTPNR_NAMESPACE_BEGIN
@@ -171,6 +172,10 @@ struct NetInfo : ArchNetInfo
     std::unique_ptr<ClockConstraint> clkconstr;
 
     Region *region = nullptr;
+
+    // Nets are allocated in blocks, see object_pool.h
+    static void *operator new(std::size_t size) { return object_pool<NetInfo>::allocate(size); }
+    static void operator delete(void *ptr, std::size_t size) { object_pool<NetInfo>::deallocate(ptr, size); }
 };
 
 enum PortType
@@ -305,6 +310,10 @@ struct CellInfo : ArchCellInfo
     void copyPortTo(IdString port, CellInfo *other, IdString other_port);
     void copyPortBusTo(IdString old_name, int old_offset, bool old_brackets, CellInfo *new_cell, IdString new_name,
                        int new_offset, bool new_brackets, int width);
+
+    // Cells are allocated in blocks, see object_pool.h
+    static void *operator new(std::size_t size) { return object_pool<CellInfo>::allocate(size); }
+    static void operator delete(void *ptr, std::size_t size) { object_pool<CellInfo>::deallocate(ptr, size); }
 };
 
 struct ClockConstraint
@@ -0,0 +1,126 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#ifndef NPNR_DISABLE_THREADS
+#include <mutex>
+#endif
+
+#include "nextpnr_namespaces.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Allocator for objects of one type that are created and destroyed in large numbers, like cells and nets. Objects are
+// carved out of blocks of increasing size, rather than each being a separate heap allocation, so objects created
+// one after the other also end up next to each other in memory. Freed objects go onto a free list for reuse.
+//
+// This is meant to back a class-specific operator new/delete, so std::unique_ptr<T> and friends keep working as usual:
+//
+//     static void *operator new(std::size_t size) { return object_pool<T>::allocate(size); }
+//     static void operator delete(void *ptr, std::size_t size) { object_pool<T>::deallocate(ptr, size); }
+//
+// Blocks are only released when the process exits, so the memory use of the pool is that of the largest number of
+// objects alive at once. Derived classes with a different size fall back to the global operator new/delete.
+template <typename T> class object_pool
+{
+  public:
+    static void *allocate(std::size_t size)
+    {
+        if (size != sizeof(T))
+            return ::operator new(size);
+        return get().alloc();
+    }
+
+    static void deallocate(void *ptr, std::size_t size)
+    {
+        if (ptr == nullptr)
+            return;
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+        get().free(ptr);
+    }
+
+  private:
+    union slot
+    {
+        slot *next_free;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr std::size_t min_block_size = 64;
+    static constexpr std::size_t max_block_size = 4096;
+
+    std::vector<std::unique_ptr<slot[]>> blocks;
+    std::size_t next_block_size = min_block_size;
+    slot *block_next = nullptr, *block_end = nullptr;
+    slot *free_list = nullptr;
+#ifndef NPNR_DISABLE_THREADS
+    std::mutex mutex;
+#endif
+
+    // Never destroyed, as objects might still be freed during static destruction
+    static object_pool &get()
+    {
+        static object_pool *pool = new object_pool();
+        return *pool;
+    }
+
+    void *alloc()
+    {
+#ifndef NPNR_DISABLE_THREADS
+        std::lock_guard<std::mutex> lock(mutex);
+#endif
+        if (free_list != nullptr) {
+            slot *s = free_list;
+            free_list = s->next_free;
+            return s->storage;
+        }
+        if (block_next == block_end) {
+            blocks.emplace_back(new slot[next_block_size]);
+            block_next = blocks.back().get();
+            block_end = block_next + next_block_size;
+            next_block_size = std::min(2 * next_block_size, max_block_size);
+        }
+        return (block_next++)->storage;
+    }
+
+    void free(void *ptr)
+    {
+#ifndef NPNR_DISABLE_THREADS
+        std::lock_guard<std::mutex> lock(mutex);
+#endif
+        slot *s = reinterpret_cast<slot *>(ptr);
+        s->next_free = free_list;
+        free_list = s;
+    }
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
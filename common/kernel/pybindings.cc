@@ -26,7 +26,9 @@
 #include "log.h"
 #include "nextpnr.h"
 #include "rust.h"
+#include "timing.h"
 
+#include <cmath>
 #include <fstream>
 #include <memory>
 #include <signal.h>
@@ -86,6 +88,181 @@ template <> struct string_converter<Property>
 
 std::string loc_repr_py(Loc loc) { return stringf("Loc(%d, %d, %d)", loc.x, loc.y, loc.z); }
 
+// Read-only numpy view of an array owned by a snapshot, which the view keeps alive
+template <typename T> py::array_t<T> snapshot_array(py::object snapshot, const std::vector<T> &data)
+{
+    py::array_t<T> result({py::ssize_t(data.size())}, {py::ssize_t(sizeof(T))}, data.data(), snapshot);
+    result.attr("setflags")(py::arg("write") = false);
+    return result;
+}
+
+// numpy array holding a copy of a vector
+template <typename T> py::array_t<T> vector_array(const std::vector<T> &data)
+{
+    return py::array_t<T>({py::ssize_t(data.size())}, {py::ssize_t(sizeof(T))}, data.data());
+}
+
+py::list cell_names_py(Context &ctx)
+{
+    py::list result;
+    for (auto &cell : ctx.cells)
+        result.append(cell.first.str(&ctx));
+    return result;
+}
+
+py::list net_names_py(Context &ctx)
+{
+    py::list result;
+    for (auto &net : ctx.nets)
+        result.append(net.first.str(&ctx));
+    return result;
+}
+
+py::array_t<int32_t> cell_locations_py(Context &ctx)
+{
+    py::array_t<int32_t> result({py::ssize_t(ctx.cells.size()), py::ssize_t(3)});
+    auto loc = result.mutable_unchecked<2>();
+    py::ssize_t i = 0;
+    for (auto &cell : ctx.cells) {
+        BelId bel = cell.second->bel;
+        Loc l = (bel == BelId()) ? Loc(-1, -1, -1) : ctx.getBelLocation(bel);
+        loc(i, 0) = l.x;
+        loc(i, 1) = l.y;
+        loc(i, 2) = l.z;
+        ++i;
+    }
+    return result;
+}
+
+py::tuple cell_bel_types_py(Context &ctx)
+{
+    py::array_t<int32_t> result(py::ssize_t(ctx.cells.size()));
+    auto type_idx = result.mutable_unchecked<1>();
+    dict<IdString, int32_t> type_to_idx;
+    py::list names;
+    py::ssize_t i = 0;
+    for (auto &cell : ctx.cells) {
+        BelId bel = cell.second->bel;
+        int32_t idx = -1;
+        if (bel != BelId()) {
+            IdString type = ctx.getBelType(bel);
+            auto inserted = type_to_idx.emplace(type, int32_t(type_to_idx.size()));
+            if (inserted.second)
+                names.append(type.str(&ctx));
+            idx = inserted.first->second;
+        }
+        type_idx(i++) = idx;
+    }
+    return py::make_tuple(result, names);
+}
+
+py::array_t<int32_t> net_fanouts_py(Context &ctx)
+{
+    py::array_t<int32_t> result(py::ssize_t(ctx.nets.size()));
+    auto fanout = result.mutable_unchecked<1>();
+    py::ssize_t i = 0;
+    for (auto &net : ctx.nets)
+        fanout(i++) = int32_t(net.second->users.entries());
+    return result;
+}
+
+py::tuple pin_nets_py(Context &ctx)
+{
+    dict<IdString, int32_t> net_to_idx;
+    for (auto &net : ctx.nets)
+        net_to_idx.emplace(net.first, int32_t(net_to_idx.size()));
+    std::vector<int32_t> cells, nets, types;
+    int32_t cell_idx = 0;
+    for (auto &cell : ctx.cells) {
+        for (auto &port : cell.second->ports) {
+            if (port.second.net == nullptr)
+                continue;
+            cells.push_back(cell_idx);
+            nets.push_back(net_to_idx.at(port.second.net->name));
+            types.push_back(int32_t(port.second.type));
+        }
+        ++cell_idx;
+    }
+    return py::make_tuple(vector_array(cells), vector_array(nets), vector_array(types));
+}
+
+py::tuple arc_timing_py(Context &ctx)
+{
+    TimingAnalyser tmg(&ctx);
+    tmg.setup();
+    std::vector<int32_t> nets, users;
+    std::vector<float> delays, crits;
+    int32_t net_idx = 0;
+    for (auto &net : ctx.nets) {
+        NetInfo *ni = net.second.get();
+        int32_t user_idx = 0;
+        for (auto &usr : ni->users) {
+            nets.push_back(net_idx);
+            users.push_back(user_idx++);
+            bool placed = ni->driver.cell != nullptr && ni->driver.cell->bel != BelId() && usr.cell->bel != BelId();
+            delays.push_back(placed ? ctx.getDelayNS(ctx.getNetinfoRouteDelay(ni, usr)) : NAN);
+            crits.push_back(tmg.get_criticality(CellPortKey(usr)));
+        }
+        ++net_idx;
+    }
+    return py::make_tuple(vector_array(nets), vector_array(users), vector_array(delays), vector_array(crits));
+}
+
+void place_cells_py(Context &ctx, py::sequence cells, py::sequence bels, PlaceStrength strength)
+{
+    if (cells.size() != bels.size())
+        throw std::invalid_argument("placeCells: cells and bels must have the same length");
+    // Look everything up first, so that a bad name doesn't leave the placement half changed
+    std::vector<std::pair<CellInfo *, BelId>> moves;
+    moves.reserve(cells.size());
+    pool<IdString> seen_cells;
+    for (size_t i = 0; i < cells.size(); i++) {
+        std::string cell_name = py::str(cells[i]);
+        std::string bel_name = py::str(bels[i]);
+        auto found = ctx.cells.find(ctx.id(cell_name));
+        if (found == ctx.cells.end())
+            throw std::invalid_argument("placeCells: no cell named '" + cell_name + "'");
+        if (!seen_cells.insert(found->first).second)
+            throw std::invalid_argument("placeCells: cell '" + cell_name + "' is given more than once");
+        BelId bel = ctx.getBelByNameStr(bel_name);
+        if (bel == BelId())
+            throw std::invalid_argument("placeCells: no bel named '" + bel_name + "'");
+        CellInfo *cell = found->second.get();
+        if (!ctx.isValidBelForCellType(cell->type, bel))
+            throw std::invalid_argument("placeCells: bel '" + bel_name + "' cannot take cell '" + cell_name +
+                                        "' of type '" + cell->type.str(&ctx) + "'");
+        moves.emplace_back(cell, bel);
+    }
+    std::vector<std::pair<BelId, PlaceStrength>> old_bels;
+    for (auto &move : moves) {
+        old_bels.emplace_back(move.first->bel, move.first->belStrength);
+        if (move.first->bel != BelId())
+            ctx.unbindBel(move.first->bel);
+    }
+    std::string error;
+    pool<BelId> used_bels;
+    for (auto &move : moves) {
+        if (!used_bels.insert(move.second).second || !ctx.checkBelAvail(move.second)) {
+            error = stringf("placeCells: bel '%s' for cell '%s' is not available", ctx.nameOfBel(move.second),
+                            ctx.nameOf(move.first));
+            break;
+        }
+    }
+    if (!error.empty()) {
+        for (size_t i = 0; i < moves.size(); i++)
+            if (old_bels.at(i).first != BelId())
+                ctx.bindBel(old_bels.at(i).first, moves.at(i).first, old_bels.at(i).second);
+        throw std::invalid_argument(error);
+    }
+    for (auto &move : moves)
+        ctx.bindBel(move.second, move.first, strength);
+}
+
+#define SNAPSHOT_ARRAY(name)                                                                                           \
+    def_property_readonly(#name, [](py::object self) {                                                                 \
+        return snapshot_array(self, self.cast<const RoutingGraphSnapshot &>().name);                                   \
+    })
+
 PYBIND11_EMBEDDED_MODULE(MODULE_NAME, m)
 {
     py::register_exception_translator([](std::exception_ptr p) {
@@ -247,6 +424,25 @@ PYBIND11_EMBEDDED_MODULE(MODULE_NAME, m)
     readwrite_wrapper<PipMap &, decltype(&PipMap::strength), &PipMap::strength, pass_through<PlaceStrength>,
                       pass_through<PlaceStrength>>::def_wrap(pm_cls, "strength");
 
+    py::class_<RoutingGraphSnapshot>(m, "RoutingGraphSnapshot")
+            .def_property_readonly("num_wires", [](const RoutingGraphSnapshot &g) { return g.wires.size(); })
+            .def_property_readonly("num_pips", [](const RoutingGraphSnapshot &g) { return g.pips.size(); })
+            .def_property_readonly("num_nets", [](const RoutingGraphSnapshot &g) { return g.nets.size(); })
+            .SNAPSHOT_ARRAY(pip_src)
+            .SNAPSHOT_ARRAY(pip_dst)
+            .SNAPSHOT_ARRAY(downhill_begin)
+            .SNAPSHOT_ARRAY(net_source)
+            .SNAPSHOT_ARRAY(sink_begin)
+            .SNAPSHOT_ARRAY(sink_wire)
+            .def(
+                    "wire_name",
+                    [](const RoutingGraphSnapshot &g, int idx) { return g.wire_name(idx).str(g.ctx); },
+                    "Name of wire number idx, or an empty string if no wire has that number (dense wire numbers may "
+                    "have gaps). Raises IndexError if idx is not below num_wires.")
+            .def("pip_name",
+                 [](const RoutingGraphSnapshot &g, int idx) { return g.ctx->getPipName(g.pips.at(idx)).str(g.ctx); })
+            .def("net_name", [](const RoutingGraphSnapshot &g, int idx) { return g.nets.at(idx)->name.str(g.ctx); });
+
     m.def("parse_json", parse_json_shim);
     m.def("load_design", load_design_shim, py::return_value_policy::take_ownership);
 #ifdef USE_RUST
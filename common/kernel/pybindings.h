@@ -24,9 +24,11 @@
 #include <Python.h>
 #include <iostream>
 #include <pybind11/embed.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <stdexcept>
 #include <utility>
+#include "graph_snapshot.h"
 #include "pycontainers.h"
 #include "pywrappers.h"
 
@@ -57,6 +59,24 @@ void deinit_python();
 
 void execute_python_file(const char *python_file);
 
+// Bulk accessors for scripts that work on the whole design at once, returning numpy arrays rather than one wrapped
+// object per cell, net or arc. Cells and nets are numbered in the order of ctx.cells and ctx.nets, as returned by
+// getCellNames and getNetNames
+py::list cell_names_py(Context &ctx);
+py::list net_names_py(Context &ctx);
+// (x, y, z) of each cell's bel, -1 for unplaced cells
+py::array_t<int32_t> cell_locations_py(Context &ctx);
+// Index into a list of bel type names for each cell, -1 for unplaced cells; returns (indices, names)
+py::tuple cell_bel_types_py(Context &ctx);
+py::array_t<int32_t> net_fanouts_py(Context &ctx);
+// Cell index, net index and PortType of every connected cell port; returns (cells, nets, types)
+py::tuple pin_nets_py(Context &ctx);
+// Net index, user index, routed (or predicted) delay in ns and setup criticality of every arc; delays are NaN for arcs
+// with an unplaced end. Runs a timing analysis; returns (nets, users, delays, criticalities)
+py::tuple arc_timing_py(Context &ctx);
+// Binds each cell to the bel of the same position, moving it off any bel it is already on
+void place_cells_py(Context &ctx, py::sequence cells, py::sequence bels, PlaceStrength strength);
+
 // Defauld IdString conversions
 namespace PythonConversion {
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "design_name_index.h"
 #include "log.h"
 #include "nextpnr.h"
 
@@ -94,8 +95,9 @@ struct SDCParser
     int pos = 0;
     int lineno = 1;
     Context *ctx;
+    DesignNameIndex names;
 
-    SDCParser(const std::string &buf, Context *ctx) : buf(buf), ctx(ctx) {};
+    SDCParser(const std::string &buf, Context *ctx) : buf(buf), ctx(ctx), names(ctx) {};
 
     inline bool eof() const { return pos == int(buf.size()); }
 
@@ -250,21 +252,36 @@ struct SDCParser
         return args;
     }
 
-    SdcValue cmd_get_nets(const std::vector<SdcValue> &arguments)
+    // Names given to a get_* command, and whether -regexp was given
+    std::vector<std::string> get_query_names(const std::vector<SdcValue> &arguments, const char *cmd, bool &regexp)
     {
-        std::vector<SdcEntity> nets;
+        std::vector<std::string> query;
+        regexp = false;
         for (int i = 1; i < int(arguments.size()); i++) {
             auto &arg = arguments.at(i);
             if (!arg.is_string)
-                log_error("get_nets expected string arguments (line %d)\n", lineno);
-            std::string s = arg.str;
-            if (s.at(0) == '-')
-                log_error("unsupported argument '%s' to get_nets (line %d)\n", s.c_str(), lineno);
-            IdString id = ctx->id(s);
-            if (ctx->nets.count(id) || ctx->net_aliases.count(id))
-                nets.emplace_back(SdcEntity::ENTITY_NET, ctx->net_aliases.count(id) ? ctx->net_aliases.at(id) : id);
+                log_error("%s expected string arguments (line %d)\n", cmd, lineno);
+            const std::string &s = arg.str;
+            if (s == "-regexp")
+                regexp = true;
+            else if (s.at(0) == '-')
+                log_error("unsupported argument '%s' to %s (line %d)\n", s.c_str(), cmd, lineno);
             else
+                query.push_back(s);
+        }
+        return query;
+    }
+
+    SdcValue cmd_get_nets(const std::vector<SdcValue> &arguments)
+    {
+        std::vector<SdcEntity> nets;
+        bool regexp;
+        for (auto &s : get_query_names(arguments, "get_nets", regexp)) {
+            auto found = names.get_nets(s, regexp);
+            if (found.empty())
                 log_warning("get_nets argument '%s' matched no objects.\n", s.c_str());
+            for (auto net : found)
+                nets.emplace_back(SdcEntity::ENTITY_NET, net);
         }
         return nets;
     }
@@ -272,55 +289,38 @@ struct SDCParser
     SdcValue cmd_get_ports(const std::vector<SdcValue> &arguments)
     {
         std::vector<SdcEntity> ports;
-        for (int i = 1; i < int(arguments.size()); i++) {
-            auto &arg = arguments.at(i);
-            if (!arg.is_string)
-                log_error("get_ports expected string arguments (line %d)\n", lineno);
-            std::string s = arg.str;
-            if (s.at(0) == '-')
-                log_error("unsupported argument '%s' to get_ports (line %d)\n", s.c_str(), lineno);
-            IdString id = ctx->id(s);
-            if (ctx->ports.count(id))
-                ports.emplace_back(SdcEntity::ENTITY_PORT, id);
-        }
+        bool regexp;
+        for (auto &s : get_query_names(arguments, "get_ports", regexp))
+            for (auto port : names.get_ports(s, regexp))
+                ports.emplace_back(SdcEntity::ENTITY_PORT, port);
         return ports;
     }
 
     SdcValue cmd_get_cells(const std::vector<SdcValue> &arguments)
     {
         std::vector<SdcEntity> cells;
-        for (int i = 1; i < int(arguments.size()); i++) {
-            auto &arg = arguments.at(i);
-            if (!arg.is_string)
-                log_error("get_cells expected string arguments (line %d)\n", lineno);
-            std::string s = arg.str;
-            if (s.at(0) == '-')
-                log_error("unsupported argument '%s' to get_cells (line %d)\n", s.c_str(), lineno);
-            IdString id = ctx->id(s);
-            if (ctx->cells.count(id))
-                cells.emplace_back(SdcEntity::ENTITY_CELL, id);
-        }
+        bool regexp;
+        for (auto &s : get_query_names(arguments, "get_cells", regexp))
+            for (auto cell : names.get_cells(s, regexp))
+                cells.emplace_back(SdcEntity::ENTITY_CELL, cell);
         return cells;
     }
 
     SdcValue cmd_get_pins(const std::vector<SdcValue> &arguments)
     {
         std::vector<SdcEntity> pins;
-        for (int i = 1; i < int(arguments.size()); i++) {
-            auto &arg = arguments.at(i);
-            if (!arg.is_string)
-                log_error("get_pins expected string arguments (line %d)\n", lineno);
-            std::string s = arg.str;
-            if (s.at(0) == '-')
-                log_error("unsupported argument '%s' to get_pins (line %d)\n", s.c_str(), lineno);
-            auto pos = s.rfind('/');
-            if (pos == std::string::npos)
+        bool regexp;
+        for (auto &s : get_query_names(arguments, "get_pins", regexp)) {
+            if (s.rfind('/') == std::string::npos)
                 log_error("expected / in cell pin name '%s' (line %d)\n", s.c_str(), lineno);
-            pins.emplace_back(SdcEntity::ENTITY_PIN, ctx->id(s.substr(0, pos)), ctx->id(s.substr(pos + 1)));
-            if (pins.back().get_net(ctx) == nullptr) {
-                log_warning("cell pin '%s' not found\n", s.c_str());
-                pins.pop_back();
+            size_t count = pins.size();
+            for (auto &pin : names.get_pins(s, regexp)) {
+                pins.emplace_back(SdcEntity::ENTITY_PIN, pin.first, pin.second);
+                if (pins.back().get_net(ctx) == nullptr)
+                    pins.pop_back();
             }
+            if (pins.size() == count)
+                log_warning("cell pin '%s' not found\n", s.c_str());
         }
         return pins;
     }
@@ -17,6 +17,12 @@
  *
  */
 
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <sstream>
+#include "log.h"
 #include "nextpnr.h"
 #include "util.h"
 
@@ -79,11 +85,9 @@ struct Interconnect
 struct SDFWriter
 {
     bool cvc_mode = false;
-    std::vector<Cell> cells;
-    std::vector<Interconnect> conn;
     std::string sdfversion, design, vendor, program;
 
-    std::string format_name(const std::string &name)
+    std::string format_name(const std::string &name) const
     {
         std::string fmt = "\"";
         for (char c : name) {
@@ -95,7 +99,7 @@ struct SDFWriter
         return fmt;
     }
 
-    std::string escape_name(const std::string &name)
+    std::string escape_name(const std::string &name) const
     {
         std::string esc;
         for (char c : name) {
@@ -106,7 +110,7 @@ struct SDFWriter
         return esc;
     }
 
-    std::string timing_check_name(TimingCheck::CheckType type)
+    std::string timing_check_name(TimingCheck::CheckType type) const
     {
         switch (type) {
         case TimingCheck::SETUPHOLD:
@@ -120,14 +124,14 @@ struct SDFWriter
         }
     }
 
-    void write_delay(std::ostream &out, const RiseFallDelay &delay)
+    void write_delay(std::ostream &out, const RiseFallDelay &delay) const
     {
         write_delay(out, delay.rise);
         out << " ";
         write_delay(out, delay.fall);
     }
 
-    void write_delay(std::ostream &out, const MinMaxTyp &delay)
+    void write_delay(std::ostream &out, const MinMaxTyp &delay) const
     {
         if (cvc_mode)
             out << "(" << int(delay.min) << ":" << int(delay.typ) << ":" << int(delay.max) << ")";
@@ -135,7 +139,7 @@ struct SDFWriter
             out << "(" << delay.min << ":" << delay.typ << ":" << delay.max << ")";
     }
 
-    void write_port(std::ostream &out, const CellPort &port)
+    void write_port(std::ostream &out, const CellPort &port) const
     {
         if (cvc_mode)
             out << escape_name(port.cell) + "." + escape_name(port.port);
@@ -143,12 +147,13 @@ struct SDFWriter
             out << escape_name(port.cell + "/" + port.port);
     }
 
-    void write_portedge(std::ostream &out, const PortAndEdge &pe)
+    void write_portedge(std::ostream &out, const PortAndEdge &pe) const
     {
         out << "(" << (pe.edge == RISING_EDGE ? "posedge" : "negedge") << " " << escape_name(pe.port) << ")";
     }
 
-    void write(std::ostream &out)
+    // Everything up to the interconnect delays, which are written as the delays of the main design "cell"
+    void write_header(std::ostream &out) const
     {
         out << "(DELAYFILE" << std::endl;
         // Headers and  metadata
@@ -158,66 +163,113 @@ struct SDFWriter
         out << "  (PROGRAM " << format_name(program) << ")" << std::endl;
         out << "  (DIVIDER " << (cvc_mode ? "." : "/") << ")" << std::endl;
         out << "  (TIMESCALE 1ps)" << std::endl;
-        // Write interconnect delays, with the main design begin a "cell"
         out << "  (CELL" << std::endl;
         out << "    (CELLTYPE " << format_name(design) << ")" << std::endl;
         out << "    (INSTANCE )" << std::endl;
         out << "    (DELAY" << std::endl;
         out << "      (ABSOLUTE" << std::endl;
-        for (auto &ic : conn) {
-            out << "        (INTERCONNECT ";
-            write_port(out, ic.from);
-            out << " ";
-            write_port(out, ic.to);
-            out << " ";
-            write_delay(out, ic.delay);
-            out << ")" << std::endl;
-        }
+    }
+
+    void write_interconnect(std::ostream &out, const Interconnect &ic) const
+    {
+        out << "        (INTERCONNECT ";
+        write_port(out, ic.from);
+        out << " ";
+        write_port(out, ic.to);
+        out << " ";
+        write_delay(out, ic.delay);
+        out << ")" << std::endl;
+    }
+
+    void write_interconnect_end(std::ostream &out) const
+    {
         out << "      )" << std::endl;
         out << "    )" << std::endl;
         out << "  )" << std::endl;
-        // Write cells
-        for (auto &cell : cells) {
-            out << "  (CELL" << std::endl;
-            out << "    (CELLTYPE " << format_name(cell.celltype) << ")" << std::endl;
-            out << "    (INSTANCE " << escape_name(cell.instance) << ")" << std::endl;
-            // IOPATHs (combinational delay and clock-to-q)
-            if (!cell.iopaths.empty()) {
-                out << "    (DELAY" << std::endl;
-                out << "      (ABSOLUTE" << std::endl;
-                for (auto &path : cell.iopaths) {
-                    out << "        (IOPATH " << escape_name(path.from) << " " << escape_name(path.to) << " ";
-                    write_delay(out, path.delay);
-                    out << ")" << std::endl;
-                }
-                out << "      )" << std::endl;
-                out << "    )" << std::endl;
+    }
+
+    void write_cell(std::ostream &out, const Cell &cell) const
+    {
+        out << "  (CELL" << std::endl;
+        out << "    (CELLTYPE " << format_name(cell.celltype) << ")" << std::endl;
+        out << "    (INSTANCE " << escape_name(cell.instance) << ")" << std::endl;
+        // IOPATHs (combinational delay and clock-to-q)
+        if (!cell.iopaths.empty()) {
+            out << "    (DELAY" << std::endl;
+            out << "      (ABSOLUTE" << std::endl;
+            for (auto &path : cell.iopaths) {
+                out << "        (IOPATH " << escape_name(path.from) << " " << escape_name(path.to) << " ";
+                write_delay(out, path.delay);
+                out << ")" << std::endl;
             }
-            // Timing Checks (setup/hold, period, width)
-            if (!cell.checks.empty()) {
-                out << "    (TIMINGCHECK" << std::endl;
-                for (auto &check : cell.checks) {
-                    out << "      (" << timing_check_name(check.type) << " ";
-                    write_portedge(out, check.from);
+            out << "      )" << std::endl;
+            out << "    )" << std::endl;
+        }
+        // Timing Checks (setup/hold, period, width)
+        if (!cell.checks.empty()) {
+            out << "    (TIMINGCHECK" << std::endl;
+            for (auto &check : cell.checks) {
+                out << "      (" << timing_check_name(check.type) << " ";
+                write_portedge(out, check.from);
+                out << " ";
+                if (check.type == TimingCheck::SETUPHOLD) {
+                    write_portedge(out, check.to);
                     out << " ";
-                    if (check.type == TimingCheck::SETUPHOLD) {
-                        write_portedge(out, check.to);
-                        out << " ";
-                    }
-                    if (check.type == TimingCheck::SETUPHOLD)
-                        write_delay(out, check.delay);
-                    else
-                        write_delay(out, check.delay.rise);
-                    out << ")" << std::endl;
                 }
-                out << "    )" << std::endl;
+                if (check.type == TimingCheck::SETUPHOLD)
+                    write_delay(out, check.delay);
+                else
+                    write_delay(out, check.delay.rise);
+                out << ")" << std::endl;
             }
             out << "    )" << std::endl;
         }
-        out << ")" << std::endl;
+        out << "    )" << std::endl;
     }
+
+    void write_footer(std::ostream &out) const { out << ")" << std::endl; }
 };
 
+// Writes records [0, count) in chunks, in order. For each chunk, gather(begin, end) runs on the calling thread and
+// returns everything the chunk needs from the arch; format(out, batch) then turns that into text on the thread pool.
+// Only a bounded number of chunks are in flight at once, so memory use doesn't grow with the design. Returns the number
+// of bytes written
+template <typename G, typename F>
+size_t write_chunked(ThreadPool &pool, std::ostream &out, size_t count, size_t chunk_size, const G &gather,
+                     const F &format)
+{
+    std::deque<std::future<std::string>> in_flight;
+    const size_t max_in_flight = 2 * pool.size() + 1;
+    size_t bytes = 0;
+    auto write_front = [&]() {
+        std::string text = in_flight.front().get();
+        in_flight.pop_front();
+        out.write(text.data(), text.size());
+        bytes += text.size();
+    };
+    try {
+        for (size_t begin = 0; begin < count; begin += chunk_size) {
+            size_t end = std::min(count, begin + chunk_size);
+            auto batch = std::make_shared<decltype(gather(begin, end))>(gather(begin, end));
+            in_flight.push_back(pool.async([&format, batch]() {
+                std::ostringstream ss;
+                format(ss, *batch);
+                return ss.str();
+            }));
+            while (in_flight.size() > max_in_flight)
+                write_front();
+        }
+        while (!in_flight.empty())
+            write_front();
+    } catch (...) {
+        // The chunks still in flight refer to format, so they must finish before it goes away
+        for (auto &chunk : in_flight)
+            chunk.wait();
+        throw;
+    }
+    return bytes;
+}
+
 } // namespace SDF
 
 void Context::writeSDF(std::ostream &out, bool cvc_mode) const
@@ -254,9 +306,47 @@ void Context::writeSDF(std::ostream &out, bool cvc_mode) const
         return rf;
     };
 
-    for (const auto &cell : cells) {
+    auto start = std::chrono::high_resolution_clock::now();
+    ThreadPool &pool = threadPool();
+
+    std::vector<const CellInfo *> cell_list;
+    cell_list.reserve(cells.size());
+    for (const auto &cell : cells)
+        cell_list.push_back(cell.second.get());
+    std::vector<const NetInfo *> net_list;
+    size_t interconnect_count = 0;
+    for (auto &net : nets) {
+        const NetInfo *ni = net.second.get();
+        if (ni->driver.cell == nullptr)
+            continue;
+        net_list.push_back(ni);
+        interconnect_count += ni->users.entries();
+    }
+
+    // Interconnect delays only need the routing delay queries, which are safe to make from several threads at once (as
+    // router2 does), so each chunk of nets is both queried and formatted on the pool
+    auto net_range = [](size_t begin, size_t end) { return std::make_pair(begin, end); };
+    auto write_nets = [&](std::ostream &ss, const std::pair<size_t, size_t> &range) {
+        for (size_t i = range.first; i < range.second; i++) {
+            const NetInfo *ni = net_list.at(i);
+            for (auto &usr : ni->users) {
+                Interconnect ic;
+                ic.from.cell = ni->driver.cell->name.str(this);
+                ic.from.port = ni->driver.port.str(this);
+                ic.to.cell = usr.cell->name.str(this);
+                ic.to.port = usr.port.str(this);
+                // FIXME: min/max routing delay
+                ic.delay = convert_delay(getNetinfoRouteDelayQuad(ni, usr));
+                wr.write_interconnect(ss, ic);
+            }
+        }
+    };
+
+    // The cell timing queries may use unlocked caches in the arch (ECP5 does), so cells are collected on this thread
+    // and only formatted on the pool
+    auto get_cell = [&](size_t i) {
         Cell sc;
-        const CellInfo *ci = cell.second.get();
+        const CellInfo *ci = cell_list.at(i);
         sc.instance = ci->name.str(this);
         sc.celltype = ci->type.str(this);
         for (auto port : ci->ports) {
@@ -310,25 +400,43 @@ void Context::writeSDF(std::ostream &out, bool cvc_mode) const
                 }
             }
         }
-        wr.cells.push_back(sc);
-    }
+        return sc;
+    };
+    auto get_cells = [&](size_t begin, size_t end) {
+        std::vector<Cell> batch;
+        batch.reserve(end - begin);
+        for (size_t i = begin; i < end; i++)
+            batch.push_back(get_cell(i));
+        return batch;
+    };
+    auto write_cells = [&](std::ostream &ss, const std::vector<Cell> &batch) {
+        for (auto &sc : batch)
+            wr.write_cell(ss, sc);
+    };
 
-    for (auto &net : nets) {
-        NetInfo *ni = net.second.get();
-        if (ni->driver.cell == nullptr)
-            continue;
-        for (auto &usr : ni->users) {
-            Interconnect ic;
-            ic.from.cell = ni->driver.cell->name.str(this);
-            ic.from.port = ni->driver.port.str(this);
-            ic.to.cell = usr.cell->name.str(this);
-            ic.to.port = usr.port.str(this);
-            // FIXME: min/max routing delay
-            ic.delay = convert_delay(getNetinfoRouteDelayQuad(ni, usr));
-            wr.conn.push_back(ic);
-        }
-    }
-    wr.write(out);
+    size_t bytes = 0;
+    auto write_text = [&](const std::string &text) {
+        out.write(text.data(), text.size());
+        bytes += text.size();
+    };
+    std::ostringstream header;
+    wr.write_header(header);
+    write_text(header.str());
+    // Chunks of a few tens of KiB of text each
+    bytes += write_chunked(pool, out, net_list.size(), 64, net_range, write_nets);
+    std::ostringstream middle;
+    wr.write_interconnect_end(middle);
+    write_text(middle.str());
+    bytes += write_chunked(pool, out, cell_list.size(), 128, get_cells, write_cells);
+    std::ostringstream footer;
+    wr.write_footer(footer);
+    write_text(footer.str());
+    out.flush();
+
+    double time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    log_info("Wrote SDF with %zu interconnects and %zu cells (%.02f MiB) in %.02fs, %.02f MiB/s on %d threads\n",
+             interconnect_count, cell_list.size(), bytes / 1048576.0, time, bytes / 1048576.0 / std::max(time, 1e-6),
+             pool.size());
 }
 
 NEXTPNR_NAMESPACE_END
@@ -0,0 +1,214 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+NEXTPNR_NAMESPACE_BEGIN
+
+#ifndef NPNR_DISABLE_THREADS
+
+namespace {
+// The pool and queue of the worker running on this thread, if any
+thread_local const ThreadPool *worker_pool = nullptr;
+thread_local int worker_queue = -1;
+} // namespace
+
+ThreadPool::ThreadPool(int size) : pool_size(std::max(size, 1))
+{
+    for (int i = 0; i < pool_size; i++)
+        queues.emplace_back(new Queue());
+    for (int i = 0; i < pool_size - 1; i++)
+        workers.emplace_back([this, i]() { worker(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        shutdown = true;
+    }
+    sleep_cv.notify_all();
+    for (auto &w : workers)
+        w.join();
+}
+
+int ThreadPool::current_queue() const { return (worker_pool == this) ? worker_queue : int(queues.size()) - 1; }
+
+void ThreadPool::enqueue(std::function<void()> task)
+{
+    if (workers.empty()) {
+        task();
+        return;
+    }
+    {
+        Queue &q = *queues.at(current_queue());
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1);
+    {
+        // Taking the lock makes sure a worker that just found nothing to do is waiting before we notify it
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    sleep_cv.notify_one();
+}
+
+bool ThreadPool::run_one()
+{
+    if (queued.load() == 0)
+        return false;
+    int own = current_queue();
+    std::function<void()> task;
+    {
+        // Newest task from our own queue first, as it's most likely to still be in cache
+        Queue &q = *queues.at(own);
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        }
+    }
+    for (int i = 1; !task && i < int(queues.size()); i++) {
+        // Otherwise steal the oldest task from another queue
+        Queue &q = *queues.at((own + i) % queues.size());
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+    }
+    if (!task)
+        return false;
+    queued.fetch_sub(1);
+    task();
+    return true;
+}
+
+void ThreadPool::worker(int idx)
+{
+    worker_pool = this;
+    worker_queue = idx;
+    while (true) {
+        if (run_one())
+            continue;
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleep_cv.wait(lock, [this]() { return queued.load() > 0 || shutdown; });
+        if (shutdown && queued.load() == 0)
+            break;
+    }
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++remaining;
+    }
+    pool.enqueue([this, task = std::move(task)]() {
+        std::exception_ptr task_error;
+        try {
+            task();
+        } catch (...) {
+            task_error = std::current_exception();
+        }
+        // Everything is done under the lock, as the group may be destroyed as soon as the waiter sees remaining == 0
+        std::lock_guard<std::mutex> lock(mutex);
+        if (task_error && !error)
+            error = task_error;
+        --remaining;
+        // Wake the waiter even if other tasks are left, so it can help with any tasks this one queued
+        cv.notify_all();
+    });
+}
+
+void TaskGroup::wait_all()
+{
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (remaining == 0)
+                return;
+        }
+        if (pool.run_one())
+            continue;
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return remaining == 0 || pool.queued.load() > 0; });
+    }
+}
+
+#else
+
+ThreadPool::ThreadPool(int) : pool_size(1) {}
+
+ThreadPool::~ThreadPool() {}
+
+void ThreadPool::enqueue(std::function<void()> task) { task(); }
+
+void TaskGroup::run(std::function<void()> task)
+{
+    try {
+        task();
+    } catch (...) {
+        if (!error)
+            error = std::current_exception();
+    }
+}
+
+void TaskGroup::wait_all() {}
+
+#endif
+
+void ThreadPool::parallel_for(int begin, int end, const std::function<void(int)> &func, int grain)
+{
+    if (grain <= 0)
+        grain = std::max((end - begin) / (4 * pool_size), 1);
+    int blocks = (end - begin + grain - 1) / grain;
+    if (blocks <= 1 || pool_size == 1) {
+        for (int i = begin; i < end; i++)
+            func(i);
+        return;
+    }
+    // Blocks are handed out dynamically, so threads that get cheap blocks go on to take more of them
+    std::atomic<int> next_block{0};
+    auto run_blocks = [&]() {
+        for (int b = next_block.fetch_add(1); b < blocks; b = next_block.fetch_add(1))
+            for (int i = begin + b * grain; i < std::min(begin + (b + 1) * grain, end); i++)
+                func(i);
+    };
+    TaskGroup group(*this);
+    for (int i = 0; i < std::min(blocks, pool_size); i++)
+        group.run(run_blocks);
+    group.wait();
+}
+
+TaskGroup::~TaskGroup() { wait_all(); }
+
+void TaskGroup::wait()
+{
+    wait_all();
+    if (error) {
+        std::exception_ptr to_throw = error;
+        error = nullptr;
+        std::rethrow_exception(to_throw);
+    }
+}
+
+NEXTPNR_NAMESPACE_END
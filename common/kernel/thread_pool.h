@@ -0,0 +1,131 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#ifndef NPNR_DISABLE_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#include "nextpnr_namespaces.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Work-stealing thread pool shared by all parallel passes, owned by the Context (see Context::threadPool).
+//
+// A pool of size N has N - 1 worker threads; a thread waiting on the pool (in TaskGroup::wait or parallel_for) runs
+// queued tasks itself, so at most N threads are busy at once. Each worker has its own queue: tasks a worker creates go
+// to the back of its queue and are taken from there (so nested work stays on the same core), idle workers steal from
+// the front of the other queues. With a size of 1, or when threads are disabled, every task is run straight away on the
+// thread that creates it.
+//
+// Tasks must not block on other tasks except through TaskGroup::wait, which keeps running queued tasks while it
+// waits; blocking in std::future::get from inside a task can deadlock once all workers are busy.
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(int size);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Maximum number of threads running tasks at once
+    int size() const { return pool_size; }
+
+    // Queues a task; prefer TaskGroup or async, which also report exceptions
+    void enqueue(std::function<void()> task);
+
+    // Runs func asynchronously, returning its result (or exception) through a future
+    template <typename F> auto async(F &&func) -> std::future<decltype(func())>
+    {
+        using R = decltype(func());
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+        std::future<R> result = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return result;
+    }
+
+    // Calls func(i) for every i in [begin, end), in blocks of grain consecutive indices, and waits for all of them. A
+    // grain of 0 picks a block size that gives each thread a few blocks.
+    void parallel_for(int begin, int end, const std::function<void(int)> &func, int grain = 0);
+
+  private:
+    friend class TaskGroup;
+
+    int pool_size;
+#ifndef NPNR_DISABLE_THREADS
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    // One queue per worker, plus a shared one for tasks queued by other threads
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<int> queued{0};
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    bool shutdown = false;
+
+    int current_queue() const;
+    bool run_one();
+    void worker(int idx);
+#endif
+};
+
+// A set of tasks that can be waited for together. Tasks may add more tasks to the group they are part of. If any of
+// them throws, the first exception is rethrown by wait().
+class TaskGroup
+{
+  public:
+    explicit TaskGroup(ThreadPool &pool) : pool(pool) {}
+    // Waits for outstanding tasks, discarding any exception
+    ~TaskGroup();
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    void run(std::function<void()> task);
+    void wait();
+
+  private:
+    ThreadPool &pool;
+    int remaining = 0;
+    std::exception_ptr error;
+#ifndef NPNR_DISABLE_THREADS
+    std::mutex mutex;
+    std::condition_variable cv;
+#endif
+
+    void wait_all();
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
@@ -36,28 +36,47 @@ TimingAnalyser::TimingAnalyser(Context *ctx) : ctx(ctx)
     domain_to_id.emplace(key, 0);
     domains.emplace_back(key);
     async_clock_id = 0;
+    incremental = ctx->setting<bool>("timing/incremental", true);
+    threads = ctx->setting<int>("threads", 8);
 };
 
 void TimingAnalyser::setup(bool update_net_timings, bool update_histogram, bool update_crit_paths)
 {
     init_ports();
     get_cell_delays();
+    build_graph();
     topo_sort();
     setup_port_domains();
     identify_related_domains();
+    setup_levels();
+    have_times = false;
+    for (auto &port : changed_ports)
+        ports.at(port).route_delay_changed = false;
+    changed_ports.clear();
     run(true, update_net_timings, update_histogram, update_crit_paths);
 }
 
 void TimingAnalyser::run(bool update_route_delays, bool update_net_timings, bool update_histogram,
                          bool update_crit_paths)
 {
-    reset_times();
     if (update_route_delays)
         get_route_delays();
-    walk_forward();
-    walk_backward();
-    compute_slack();
-    compute_criticality();
+    if (!run_incremental()) {
+        if (levelised) {
+            run_levelised();
+        } else {
+            reset_times();
+            walk_forward();
+            walk_backward();
+            compute_slack();
+            compute_criticality();
+        }
+    }
+    for (auto &port : changed_ports)
+        ports.at(port).route_delay_changed = false;
+    changed_ports.clear();
+    have_times = true;
+    last_setup_only = setup_only;
 
     // Ensure we clear all timing results if any of them has been marked as
     // as to be updated. This is done so we ensure it's not possible to have
@@ -85,9 +104,13 @@ void TimingAnalyser::init_ports()
     for (auto &cell : ctx->cells) {
         CellInfo *ci = cell.second.get();
         for (auto &port : ci->ports) {
-            auto &data = ports[CellPortKey(ci->name, port.first)];
+            CellPortKey key(ci->name, port.first);
+            auto inserted = port_to_id.emplace(key, port_id_t(ports.size()));
+            if (inserted.second)
+                ports.emplace_back();
+            auto &data = ports.at(inserted.first->second);
             data.type = port.second.type;
-            data.cell_port = CellPortKey(ci->name, port.first);
+            data.cell_port = key;
         }
     }
 }
@@ -96,12 +119,12 @@ void TimingAnalyser::get_cell_delays()
 {
     auto async_clk_key = domains.at(async_clock_id);
 
-    for (auto &port : ports) {
-        CellInfo *ci = cell_info(port.first);
-        auto &pi = port_info(port.first);
-        auto &pd = port.second;
+    for (port_id_t port = 0; port < port_id_t(ports.size()); port++) {
+        CellInfo *ci = cell_info(port);
+        auto &pi = port_info(port);
+        auto &pd = ports.at(port);
 
-        IdString name = port.first.port;
+        IdString name = pd.cell_port.port;
         // Ignore dangling ports altogether for timing purposes
         if (!pi.net)
             continue;
@@ -176,35 +199,68 @@ void TimingAnalyser::get_route_delays()
         for (auto &usr : ni->users) {
             if (usr.cell->bel == BelId())
                 continue;
-            ports.at(CellPortKey(usr)).route_delay = DelayPair(ctx->getNetinfoRouteDelay(ni, usr));
+            set_route_delay(port_to_id.at(CellPortKey(usr)), DelayPair(ctx->getNetinfoRouteDelay(ni, usr)));
         }
     }
 }
 
-void TimingAnalyser::set_route_delay(CellPortKey port, DelayPair value) { ports.at(port).route_delay = value; }
+void TimingAnalyser::set_route_delay(CellPortKey port, DelayPair value) { set_route_delay(port_to_id.at(port), value); }
 
-void TimingAnalyser::topo_sort()
+void TimingAnalyser::set_route_delay(port_id_t port, DelayPair value)
 {
-    TopoSort<CellPortKey> topo;
-    for (auto &port : ports) {
-        auto &pd = port.second;
-        // All ports are nodes
-        topo.node(port.first);
+    auto &pd = ports.at(port);
+    if (pd.route_delay.min_delay == value.min_delay && pd.route_delay.max_delay == value.max_delay)
+        return;
+    pd.route_delay = value;
+    if (!pd.route_delay_changed) {
+        pd.route_delay_changed = true;
+        changed_ports.push_back(port);
+    }
+}
+
+void TimingAnalyser::build_graph()
+{
+    // Collect the fan-out edges of every port and count fan-in; both are put in walk order once the topological
+    // order is known
+    fanout_start.assign(1, 0);
+    fanout.clear();
+    std::vector<int> fanin_count(ports.size(), 0);
+    for (port_id_t port = 0; port < port_id_t(ports.size()); port++) {
+        auto &pd = ports.at(port);
         if (pd.type == PORT_IN) {
             // inputs: combinational arcs through the cell are edges
             for (auto &arc : pd.cell_arcs) {
                 if (arc.type != CellArc::COMBINATIONAL)
                     continue;
-                topo.edge(port.first, CellPortKey(port.first.cell, arc.other_port));
+                fanout.push_back(
+                        TimingEdge{port_to_id.at(CellPortKey(pd.cell_port.cell, arc.other_port)), false, arc.value});
             }
         } else if (pd.type == PORT_OUT) {
             // output: routing arcs are edges
-            const NetInfo *pn = port_info(port.first).net;
+            const NetInfo *pn = port_info(port).net;
             if (pn != nullptr) {
                 for (auto &usr : pn->users)
-                    topo.edge(port.first, CellPortKey(usr));
+                    fanout.push_back(TimingEdge{port_to_id.at(CellPortKey(usr)), true, DelayQuad()});
             }
         }
+        for (int i = fanout_start.back(); i < int(fanout.size()); i++)
+            ++fanin_count.at(fanout.at(i).port);
+        fanout_start.push_back(int(fanout.size()));
+    }
+    fanin_start.assign(ports.size() + 1, 0);
+    for (port_id_t port = 0; port < port_id_t(ports.size()); port++)
+        fanin_start.at(port + 1) = fanin_start.at(port) + fanin_count.at(port);
+    fanin.resize(fanout.size());
+}
+
+void TimingAnalyser::topo_sort()
+{
+    TopoSort<port_id_t> topo;
+    for (port_id_t port = 0; port < port_id_t(ports.size()); port++) {
+        // All ports are nodes
+        topo.node(port);
+        for (int i = fanout_start.at(port); i < fanout_start.at(port + 1); i++)
+            topo.edge(port, fanout.at(i).port);
     }
 
     bool ignore_loops = bool_or_default(ctx->settings, ctx->id("timing/ignoreLoops"), false);
@@ -215,8 +271,8 @@ void TimingAnalyser::topo_sort()
         for (auto &loop : topo.loops) {
             log_info("    loop %d:\n", ++i);
             for (auto &port : loop) {
-                log_info("        %s.%s (%s)\n", ctx->nameOf(port.cell), ctx->nameOf(port.port),
-                         ctx->nameOf(port_info(port).net));
+                log_info("        %s.%s (%s)\n", ctx->nameOf(ports.at(port).cell_port.cell),
+                         ctx->nameOf(ports.at(port).cell_port.port), ctx->nameOf(port_info(port).net));
             }
         }
 
@@ -227,6 +283,28 @@ void TimingAnalyser::topo_sort()
     }
     have_loops = !no_loops;
     std::swap(topological_order, topo.sorted);
+
+    // Sort fan-in by topological order of the source, and fan-out by reverse topological order of the sink, so that
+    // pulling along them visits edges in the same order as pushing along them in topological order
+    std::vector<int> cursor(fanin_start.begin(), fanin_start.end() - 1);
+    std::vector<int> old_fanout_start(fanout_start);
+    std::vector<TimingEdge> old_fanout(fanout);
+    for (auto port : topological_order)
+        for (int i = old_fanout_start.at(port); i < old_fanout_start.at(port + 1); i++) {
+            auto &edge = old_fanout.at(i);
+            fanin.at(cursor.at(edge.port)++) = TimingEdge{port, edge.is_route, edge.cell_delay};
+        }
+    std::vector<int> fanout_count(ports.size(), 0);
+    for (auto &edge : fanin)
+        ++fanout_count.at(edge.port);
+    for (port_id_t port = 0; port < port_id_t(ports.size()); port++)
+        fanout_start.at(port + 1) = fanout_start.at(port) + fanout_count.at(port);
+    cursor.assign(fanout_start.begin(), fanout_start.end() - 1);
+    for (auto port : reversed_range(topological_order))
+        for (int i = fanin_start.at(port); i < fanin_start.at(port + 1); i++) {
+            auto &edge = fanin.at(i);
+            fanout.at(cursor.at(edge.port)++) = TimingEdge{port, edge.is_route, edge.cell_delay};
+        }
 }
 
 void TimingAnalyser::setup_port_domains()
@@ -235,86 +313,77 @@ void TimingAnalyser::setup_port_domains()
         d.startpoints.clear();
         d.endpoints.clear();
     }
+    std::vector<std::vector<domain_id_t>> arrival_domains(ports.size()), required_domains(ports.size());
+    auto add_domain = [&](std::vector<domain_id_t> &doms, domain_id_t dom) {
+        if (std::find(doms.begin(), doms.end(), dom) != doms.end())
+            return;
+        doms.push_back(dom);
+        updated_domains = true;
+    };
     bool first_iter = true;
     do {
         // Go forward through the topological order (domains from the PoV of arrival time)
         updated_domains = false;
         for (auto port : topological_order) {
             auto &pd = ports.at(port);
-            auto &pi = port_info(port);
-            if (pi.type == PORT_OUT) {
-                if (first_iter) {
-                    for (auto &fanin : pd.cell_arcs) {
-                        domain_id_t dom;
-                        // registered outputs are startpoints
-                        if (fanin.type == CellArc::CLK_TO_Q)
-                            dom = domain_id(port.cell, fanin.other_port, fanin.edge);
-                        else if (fanin.type == CellArc::STARTPOINT)
-                            dom = async_clock_id;
-                        else
-                            continue;
-                        // create per-domain data
-                        pd.arrival[dom];
-                        domains.at(dom).startpoints.emplace_back(port, fanin.other_port);
-                    }
-                }
-                // copy domains across routing
-                if (pi.net != nullptr)
-                    for (auto &usr : pi.net->users)
-                        copy_domains(port, CellPortKey(usr), false);
-            } else {
-                // copy domains from input to output
-                for (auto &fanout : pd.cell_arcs) {
-                    if (fanout.type != CellArc::COMBINATIONAL)
+            if (first_iter && pd.type == PORT_OUT) {
+                for (auto &fanin : pd.cell_arcs) {
+                    domain_id_t dom;
+                    // registered outputs are startpoints
+                    if (fanin.type == CellArc::CLK_TO_Q)
+                        dom = domain_id(pd.cell_port.cell, fanin.other_port, fanin.edge);
+                    else if (fanin.type == CellArc::STARTPOINT)
+                        dom = async_clock_id;
+                    else
                         continue;
-                    copy_domains(port, CellPortKey(port.cell, fanout.other_port), false);
+                    // create per-domain data
+                    add_domain(arrival_domains.at(port), dom);
+                    domains.at(dom).startpoints.emplace_back(port, fanin.other_port);
                 }
             }
+            // copy domains across routing (outputs) and from input to output (inputs)
+            for (int i = fanout_start.at(port); i < fanout_start.at(port + 1); i++)
+                for (auto dom : arrival_domains.at(port))
+                    add_domain(arrival_domains.at(fanout.at(i).port), dom);
         }
         // Go backward through the topological order (domains from the PoV of required time)
         for (auto port : reversed_range(topological_order)) {
             auto &pd = ports.at(port);
-            auto &pi = port_info(port);
-            if (pi.type == PORT_OUT) {
-                // copy domains from output to input
-                for (auto &fanin : pd.cell_arcs) {
-                    if (fanin.type != CellArc::COMBINATIONAL)
+            if (first_iter && pd.type != PORT_OUT) {
+                for (auto &fanout : pd.cell_arcs) {
+                    domain_id_t dom;
+                    // registered inputs are endpoints
+                    if (fanout.type == CellArc::SETUP)
+                        dom = domain_id(pd.cell_port.cell, fanout.other_port, fanout.edge);
+                    else if (fanout.type == CellArc::ENDPOINT)
+                        dom = async_clock_id;
+                    else
                         continue;
-                    copy_domains(port, CellPortKey(port.cell, fanin.other_port), true);
-                }
-            } else {
-                if (first_iter) {
-                    for (auto &fanout : pd.cell_arcs) {
-                        domain_id_t dom;
-                        // registered inputs are endpoints
-                        if (fanout.type == CellArc::SETUP)
-                            dom = domain_id(port.cell, fanout.other_port, fanout.edge);
-                        else if (fanout.type == CellArc::ENDPOINT)
-                            dom = async_clock_id;
-                        else
-                            continue;
-                        // create per-domain data
-                        pd.required[dom];
-                        domains.at(dom).endpoints.emplace_back(port, fanout.other_port);
-                    }
+                    // create per-domain data
+                    add_domain(required_domains.at(port), dom);
+                    domains.at(dom).endpoints.emplace_back(port, fanout.other_port);
                 }
-                // copy port to driver
-                if (pi.net != nullptr && pi.net->driver.cell != nullptr)
-                    copy_domains(port, CellPortKey(pi.net->driver), true);
             }
-        }
-        // Iterate over ports and find domain pairs
-        for (auto port : topological_order) {
-            auto &pd = ports.at(port);
-            for (auto &arr : pd.arrival)
-                for (auto &req : pd.required) {
-                    pd.domain_pairs[domain_pair_id(arr.first, req.first)];
-                }
+            // copy domains from output to input (outputs) and from port to driver (inputs)
+            for (int i = fanin_start.at(port); i < fanin_start.at(port + 1); i++)
+                for (auto dom : required_domains.at(port))
+                    add_domain(required_domains.at(fanin.at(i).port), dom);
         }
         first_iter = false;
         // If there are loops, repeat the process until a fixed point is reached, as there might be unusual ways to
         // visit points, which would result in a missing domain key and therefore crash later on
     } while (have_loops && updated_domains);
+    // Iterate over ports and find domain pairs
+    std::vector<std::vector<domain_id_t>> pair_domains(ports.size());
+    for (auto port : topological_order) {
+        for (auto launch : arrival_domains.at(port))
+            for (auto capture : required_domains.at(port))
+                pair_domains.at(port).push_back(domain_pair_id(launch, capture));
+    }
+    arrival.build(arrival_domains);
+    required.build(required_domains);
+    port_domain_pairs.build(pair_domains);
+
     for (auto &dp : domain_pairs) {
         auto &launch_data = domains.at(dp.key.launch);
         auto &capture_data = domains.at(dp.key.capture);
@@ -498,39 +567,46 @@ void TimingAnalyser::identify_related_domains()
             clock_delays[std::make_pair(c1.first, c2.first)] = delay;
         }
     }
+
+    // Cache clock-to-clock delay per domain pair, so slack computation doesn't need to look it up
+    for (auto &dp : domain_pairs) {
+        auto clocks = std::make_pair(domains.at(dp.key.launch).key.clock, domains.at(dp.key.capture).key.clock);
+        auto found = clock_delays.find(clocks);
+        dp.clock_to_clock = (found != clock_delays.end()) ? found->second : 0;
+    }
 }
 
 void TimingAnalyser::reset_times()
 {
     static const auto init_delay =
             DelayPair(std::numeric_limits<delay_t>::max(), std::numeric_limits<delay_t>::lowest());
-    for (auto &port : ports) {
-        auto do_reset = [&](dict<domain_id_t, ArrivReqTime> &times) {
-            for (auto &t : times) {
-                t.second.value = init_delay;
-                t.second.path_length = 0;
-                t.second.bwd_min = CellPortKey();
-                t.second.bwd_max = CellPortKey();
-            }
-        };
-        do_reset(port.second.arrival);
-        do_reset(port.second.required);
-        for (auto &dp : port.second.domain_pairs) {
-            dp.second.setup_slack = std::numeric_limits<delay_t>::max();
-            dp.second.hold_slack = std::numeric_limits<delay_t>::max();
-            dp.second.max_path_length = 0;
-            dp.second.criticality = 0;
+    auto do_reset = [&](std::vector<ArrivReqTime> &times) {
+        for (auto &t : times) {
+            t.value = init_delay;
+            t.path_length = 0;
+            t.bwd_min = -1;
+            t.bwd_max = -1;
         }
-        port.second.worst_crit = 0;
-        port.second.worst_setup_slack = std::numeric_limits<delay_t>::max();
-        port.second.worst_hold_slack = std::numeric_limits<delay_t>::max();
+    };
+    do_reset(arrival.data);
+    do_reset(required.data);
+    for (auto &dp : port_domain_pairs.data) {
+        dp.setup_slack = std::numeric_limits<delay_t>::max();
+        dp.hold_slack = std::numeric_limits<delay_t>::max();
+        dp.max_path_length = 0;
+        dp.criticality = 0;
+    }
+    for (auto &pd : ports) {
+        pd.worst_crit = 0;
+        pd.worst_setup_slack = std::numeric_limits<delay_t>::max();
+        pd.worst_hold_slack = std::numeric_limits<delay_t>::max();
     }
 }
 
-void TimingAnalyser::set_arrival_time(CellPortKey target, domain_id_t domain, DelayPair arrival, int path_length,
-                                      CellPortKey prev)
+void TimingAnalyser::set_arrival_time(port_id_t target, domain_id_t domain, DelayPair arrival, int path_length,
+                                      port_id_t prev)
 {
-    auto &arr = ports.at(target).arrival.at(domain);
+    auto &arr = this->arrival.at(target, domain);
     if (arrival.max_delay > arr.value.max_delay) {
         arr.value.max_delay = arrival.max_delay;
         arr.bwd_max = prev;
@@ -542,10 +618,10 @@ void TimingAnalyser::set_arrival_time(CellPortKey target, domain_id_t domain, De
     arr.path_length = std::max(arr.path_length, path_length);
 }
 
-void TimingAnalyser::set_required_time(CellPortKey target, domain_id_t domain, DelayPair required, int path_length,
-                                       CellPortKey prev)
+void TimingAnalyser::set_required_time(port_id_t target, domain_id_t domain, DelayPair required, int path_length,
+                                       port_id_t prev)
 {
-    auto &req = ports.at(target).required.at(domain);
+    auto &req = this->required.at(target, domain);
     if (required.min_delay < req.value.min_delay) {
         req.value.min_delay = required.min_delay;
         req.bwd_min = prev;
@@ -560,48 +636,24 @@ void TimingAnalyser::set_required_time(CellPortKey target, domain_id_t domain, D
 void TimingAnalyser::walk_forward()
 {
     // Assign initial arrival time to domain startpoints
-    for (domain_id_t dom_id = 0; dom_id < domain_id_t(domains.size()); ++dom_id) {
-        auto &dom = domains.at(dom_id);
-        for (auto &sp : dom.startpoints) {
-            auto &pd = ports.at(sp.first);
-            DelayPair init_arrival(0);
-            CellPortKey clock_key;
-            // TODO: clock routing delay, if analysis of that is enabled
-            if (sp.second != IdString()) {
-                // clocked startpoints have a clock-to-out time
-                for (auto &fanin : pd.cell_arcs) {
-                    if (fanin.type == CellArc::CLK_TO_Q && fanin.other_port == sp.second) {
-                        init_arrival = init_arrival + fanin.value.delayPair();
-                        break;
-                    }
-                }
-                clock_key = CellPortKey(sp.first.cell, sp.second);
-            }
-            set_arrival_time(sp.first, dom_id, init_arrival, 1, clock_key);
-        }
+    for (auto p : topological_order) {
+        for (auto &seed : ports.at(p).arrival_seeds)
+            set_arrival_time(p, seed.domain, seed.value, 1, seed.clock_port);
     }
     // Walk forward in topological order
     for (auto p : topological_order) {
-        auto &pd = ports.at(p);
-        for (auto &arr : pd.arrival) {
-            if (pd.type == PORT_OUT) {
-                // Output port: propagate delay through net, adding route delay
-                NetInfo *net = port_info(p).net;
-                if (net != nullptr)
-                    for (auto &usr : net->users) {
-                        CellPortKey usr_key(usr);
-                        auto &usr_pd = ports.at(usr_key);
-                        set_arrival_time(usr_key, arr.first, arr.second.value + usr_pd.route_delay,
-                                         arr.second.path_length, p);
-                    }
-            } else if (pd.type == PORT_IN) {
-                // Input port; propagate delay through cell, adding combinational delay
-                for (auto &fanout : pd.cell_arcs) {
-                    if (fanout.type != CellArc::COMBINATIONAL)
-                        continue;
-                    set_arrival_time(CellPortKey(p.cell, fanout.other_port), arr.first,
-                                     arr.second.value + fanout.value.delayPair(), arr.second.path_length + 1, p);
-                }
+        for (int i = arrival.start.at(p); i < arrival.start.at(p + 1); i++) {
+            auto &arr = arrival.data.at(i);
+            // Output ports propagate delay through the net, adding route delay; input ports through the cell,
+            // adding combinational delay
+            for (int j = fanout_start.at(p); j < fanout_start.at(p + 1); j++) {
+                auto &edge = fanout.at(j);
+                if (edge.is_route)
+                    set_arrival_time(edge.port, arrival.domain.at(i), arr.value + ports.at(edge.port).route_delay,
+                                     arr.path_length, p);
+                else
+                    set_arrival_time(edge.port, arrival.domain.at(i), arr.value + edge.cell_delay.delayPair(),
+                                     arr.path_length + 1, p);
             }
         }
     }
@@ -610,48 +662,25 @@ void TimingAnalyser::walk_forward()
 void TimingAnalyser::walk_backward()
 {
     // Assign initial required time to domain endpoints
-    // Note that clock frequency will be considered later in the analysis for, for now all required times are normalised
-    // to 0ns
-    for (domain_id_t dom_id = 0; dom_id < domain_id_t(domains.size()); ++dom_id) {
-        auto &dom = domains.at(dom_id);
-        for (auto &ep : dom.endpoints) {
-            auto &pd = ports.at(ep.first);
-            DelayPair init_setuphold(0);
-            CellPortKey clock_key;
-            // TODO: clock routing delay, if analysis of that is enabled
-            if (ep.second != IdString()) {
-                // Add setup/hold time, if this endpoint is clocked
-                for (auto &fanin : pd.cell_arcs) {
-                    if (fanin.type == CellArc::SETUP && fanin.other_port == ep.second)
-                        init_setuphold.min_delay -= fanin.value.maxDelay();
-                    if (fanin.type == CellArc::HOLD && fanin.other_port == ep.second)
-                        init_setuphold.max_delay -= fanin.value.maxDelay();
-                }
-                clock_key = CellPortKey(ep.first.cell, ep.second);
-            }
-            set_required_time(ep.first, dom_id, init_setuphold, 1, clock_key);
-        }
+    for (auto p : topological_order) {
+        for (auto &seed : ports.at(p).required_seeds)
+            set_required_time(p, seed.domain, seed.value, 1, seed.clock_port);
     }
     // Walk backwards in topological order
     for (auto p : reversed_range(topological_order)) {
         auto &pd = ports.at(p);
-        for (auto &req : pd.required) {
-            if (pd.type == PORT_IN) {
-                // Input port: propagate delay back through net, subtracting route delay
-                NetInfo *net = port_info(p).net;
-                if (net != nullptr && net->driver.cell != nullptr)
-                    set_required_time(CellPortKey(net->driver), req.first,
-                                      req.second.value - DelayPair(pd.route_delay.maxDelay()), req.second.path_length,
-                                      p);
-            } else if (pd.type == PORT_OUT) {
-                // Output port : propagate delay back through cell, subtracting combinational delay
-                for (auto &fanin : pd.cell_arcs) {
-                    if (fanin.type != CellArc::COMBINATIONAL)
-                        continue;
-                    set_required_time(CellPortKey(p.cell, fanin.other_port), req.first,
-                                      req.second.value - DelayPair(fanin.value.maxDelay()), req.second.path_length + 1,
-                                      p);
-                }
+        for (int i = required.start.at(p); i < required.start.at(p + 1); i++) {
+            auto &req = required.data.at(i);
+            // Input ports propagate delay back through the net, subtracting route delay; output ports back through
+            // the cell, subtracting combinational delay
+            for (int j = fanin_start.at(p); j < fanin_start.at(p + 1); j++) {
+                auto &edge = fanin.at(j);
+                if (edge.is_route)
+                    set_required_time(edge.port, required.domain.at(i),
+                                      req.value - DelayPair(pd.route_delay.maxDelay()), req.path_length, p);
+                else
+                    set_required_time(edge.port, required.domain.at(i),
+                                      req.value - DelayPair(edge.cell_delay.maxDelay()), req.path_length + 1, p);
             }
         }
     }
@@ -662,15 +691,14 @@ dict<domain_id_t, delay_t> TimingAnalyser::max_delay_by_domain_pairs()
     dict<domain_id_t, delay_t> domain_delay;
 
     for (auto p : topological_order) {
-        auto &pd = ports.at(p);
-        for (auto &req : pd.required) {
-            auto &capture = req.first;
-            for (auto &arr : pd.arrival) {
-                auto &launch = arr.first;
+        for (int i = required.start.at(p); i < required.start.at(p + 1); i++) {
+            auto capture = required.domain.at(i);
+            for (int j = arrival.start.at(p); j < arrival.start.at(p + 1); j++) {
+                auto launch = arrival.domain.at(j);
 
                 auto dp = domain_pair_id(launch, capture);
 
-                delay_t delay = arr.second.value.maxDelay() - req.second.value.minDelay();
+                delay_t delay = arrival.data.at(j).value.maxDelay() - required.data.at(i).value.minDelay();
                 if (!domain_delay.count(dp) || domain_delay.at(dp) < delay)
                     domain_delay[dp] = delay;
             }
@@ -680,63 +708,366 @@ dict<domain_id_t, delay_t> TimingAnalyser::max_delay_by_domain_pairs()
     return domain_delay;
 }
 
+void TimingAnalyser::compute_port_slack(port_id_t port)
+{
+    auto &pd = ports.at(port);
+    pd.worst_setup_slack = std::numeric_limits<delay_t>::max();
+    pd.worst_hold_slack = std::numeric_limits<delay_t>::max();
+    for (int i = port_domain_pairs.start.at(port); i < port_domain_pairs.start.at(port + 1); i++) {
+        auto &pdp = port_domain_pairs.data.at(i);
+        auto &dp = domain_pairs.at(port_domain_pairs.domain.at(i));
+        auto &arr = arrival.at(port, dp.key.launch);
+        auto &req = required.at(port, dp.key.capture);
+        pdp.setup_slack = 0 - (arr.value.maxDelay() - req.value.minDelay() + dp.clock_to_clock);
+        pdp.hold_slack = setup_only ? std::numeric_limits<delay_t>::max()
+                                    : (arr.value.minDelay() - req.value.maxDelay() + dp.clock_to_clock);
+        pdp.max_path_length = arr.path_length + req.path_length;
+        if (dp.key.launch == dp.key.capture)
+            pd.worst_setup_slack = std::min(pd.worst_setup_slack, dp.period.minDelay() + pdp.setup_slack);
+        if (!setup_only)
+            pd.worst_hold_slack = std::min(pd.worst_hold_slack, pdp.hold_slack);
+    }
+}
+
 void TimingAnalyser::compute_slack()
 {
-    for (auto &dp : domain_pairs) {
+    // Per-thread worst slacks, merged at the end
+    std::vector<std::vector<std::pair<delay_t, delay_t>>> thread_worst(
+            std::max(1, threads), std::vector<std::pair<delay_t, delay_t>>(
+                                          domain_pairs.size(), std::make_pair(std::numeric_limits<delay_t>::max(),
+                                                                              std::numeric_limits<delay_t>::max())));
+    for_each_levelised(topological_order, {0, int(topological_order.size())}, [&](int thread, port_id_t port) {
+        compute_port_slack(port);
+        auto &worst = thread_worst.at(thread);
+        for (int i = port_domain_pairs.start.at(port); i < port_domain_pairs.start.at(port + 1); i++) {
+            auto &pdp = port_domain_pairs.data.at(i);
+            auto &w = worst.at(port_domain_pairs.domain.at(i));
+            w.first = std::min(w.first, pdp.setup_slack);
+            if (!setup_only)
+                w.second = std::min(w.second, pdp.hold_slack);
+        }
+    });
+    for (size_t i = 0; i < domain_pairs.size(); i++) {
+        auto &dp = domain_pairs.at(i);
         dp.worst_setup_slack = std::numeric_limits<delay_t>::max();
         dp.worst_hold_slack = std::numeric_limits<delay_t>::max();
+        for (auto &worst : thread_worst) {
+            dp.worst_setup_slack = std::min(dp.worst_setup_slack, worst.at(i).first);
+            dp.worst_hold_slack = std::min(dp.worst_hold_slack, worst.at(i).second);
+        }
     }
-    for (auto p : topological_order) {
-        auto &pd = ports.at(p);
-        for (auto &pdp : pd.domain_pairs) {
-            auto &dp = domain_pairs.at(pdp.first);
-
-            // Get clock names
-            const auto &launch_clock = domains.at(dp.key.launch).key.clock;
-            const auto &capture_clock = domains.at(dp.key.capture).key.clock;
-
-            // Get clock-to-clock delay if any
-            delay_t clock_to_clock = 0;
-            auto clocks = std::make_pair(launch_clock, capture_clock);
-            if (clock_delays.count(clocks)) {
-                clock_to_clock = clock_delays.at(clocks);
-            }
+}
 
-            auto &arr = pd.arrival.at(dp.key.launch);
-            auto &req = pd.required.at(dp.key.capture);
-            pdp.second.setup_slack = 0 - (arr.value.maxDelay() - req.value.minDelay() + clock_to_clock);
-            if (!setup_only)
-                pdp.second.hold_slack = arr.value.minDelay() - req.value.maxDelay() + clock_to_clock;
-            pdp.second.max_path_length = arr.path_length + req.path_length;
-            if (dp.key.launch == dp.key.capture)
-                pd.worst_setup_slack = std::min(pd.worst_setup_slack, dp.period.minDelay() + pdp.second.setup_slack);
-            dp.worst_setup_slack = std::min(dp.worst_setup_slack, pdp.second.setup_slack);
-            if (!setup_only) {
-                pd.worst_hold_slack = std::min(pd.worst_hold_slack, pdp.second.hold_slack);
-                dp.worst_hold_slack = std::min(dp.worst_hold_slack, pdp.second.hold_slack);
-            }
-        }
+void TimingAnalyser::compute_port_criticality(port_id_t port)
+{
+    auto &pd = ports.at(port);
+    pd.worst_crit = 0;
+    for (int i = port_domain_pairs.start.at(port); i < port_domain_pairs.start.at(port + 1); i++) {
+        auto &pdp = port_domain_pairs.data.at(i);
+        auto &dp = domain_pairs.at(port_domain_pairs.domain.at(i));
+        pdp.criticality = 0;
+        // Do not set criticality for asynchronous paths
+        if (domains.at(dp.key.launch).key.is_async() || domains.at(dp.key.capture).key.is_async())
+            continue;
+
+        float crit = 1.0f - (float(pdp.setup_slack) - float(dp.worst_setup_slack)) / float(-dp.worst_setup_slack);
+        crit = std::min(crit, 1.0f);
+        crit = std::max(crit, 0.0f);
+        pdp.criticality = crit;
+        pd.worst_crit = std::max(pd.worst_crit, crit);
     }
 }
 
 void TimingAnalyser::compute_criticality()
 {
+    for_each_levelised(topological_order, {0, int(topological_order.size())},
+                       [&](int, port_id_t port) { compute_port_criticality(port); });
+}
+
+void TimingAnalyser::setup_levels()
+{
+    // Arrival and required seeds at startpoints and endpoints
+    for (auto &pd : ports) {
+        pd.arrival_seeds.clear();
+        pd.required_seeds.clear();
+        pd.arrival_level = -1;
+        pd.required_level = -1;
+    }
+    for (domain_id_t dom_id = 0; dom_id < domain_id_t(domains.size()); ++dom_id) {
+        auto &dom = domains.at(dom_id);
+        for (auto &sp : dom.startpoints) {
+            auto &pd = ports.at(sp.first);
+            DelayPair init_arrival(0);
+            port_id_t clock_port = -1;
+            // TODO: clock routing delay, if analysis of that is enabled
+            if (sp.second != IdString()) {
+                // clocked startpoints have a clock-to-out time
+                for (auto &fanin : pd.cell_arcs) {
+                    if (fanin.type == CellArc::CLK_TO_Q && fanin.other_port == sp.second) {
+                        init_arrival = init_arrival + fanin.value.delayPair();
+                        break;
+                    }
+                }
+                clock_port = port_to_id.at(CellPortKey(pd.cell_port.cell, sp.second));
+            }
+            pd.arrival_seeds.push_back(TimingSeed{dom_id, init_arrival, clock_port});
+        }
+        // Note that clock frequency will be considered later in the analysis for, for now all required times are
+        // normalised to 0ns
+        for (auto &ep : dom.endpoints) {
+            auto &pd = ports.at(ep.first);
+            DelayPair init_setuphold(0);
+            port_id_t clock_port = -1;
+            // TODO: clock routing delay, if analysis of that is enabled
+            if (ep.second != IdString()) {
+                // Add setup/hold time, if this endpoint is clocked
+                for (auto &fanin : pd.cell_arcs) {
+                    if (fanin.type == CellArc::SETUP && fanin.other_port == ep.second)
+                        init_setuphold.min_delay -= fanin.value.maxDelay();
+                    if (fanin.type == CellArc::HOLD && fanin.other_port == ep.second)
+                        init_setuphold.max_delay -= fanin.value.maxDelay();
+                }
+                clock_port = port_to_id.at(CellPortKey(pd.cell_port.cell, ep.second));
+            }
+            pd.required_seeds.push_back(TimingSeed{dom_id, init_setuphold, clock_port});
+        }
+    }
+
+    levelised = false;
+    arrival_order.clear();
+    required_order.clear();
+    arrival_level_start.clear();
+    required_level_start.clear();
+    // The serial walk is used for designs with loops, as the visit order then matters
+    if (have_loops)
+        return;
+
+    // Ports in the same level don't depend on each other
+    int max_arrival_level = 0, max_required_level = 0;
     for (auto p : topological_order) {
         auto &pd = ports.at(p);
-        for (auto &pdp : pd.domain_pairs) {
-            auto &dp = domain_pairs.at(pdp.first);
-            // Do not set criticality for asynchronous paths
-            if (domains.at(dp.key.launch).key.is_async() || domains.at(dp.key.capture).key.is_async())
+        pd.arrival_level = 0;
+        for (int i = fanin_start.at(p); i < fanin_start.at(p + 1); i++)
+            pd.arrival_level = std::max(pd.arrival_level, ports.at(fanin.at(i).port).arrival_level + 1);
+        max_arrival_level = std::max(max_arrival_level, pd.arrival_level);
+    }
+    for (auto p : reversed_range(topological_order)) {
+        auto &pd = ports.at(p);
+        pd.required_level = 0;
+        for (int i = fanout_start.at(p); i < fanout_start.at(p + 1); i++)
+            pd.required_level = std::max(pd.required_level, ports.at(fanout.at(i).port).required_level + 1);
+        max_required_level = std::max(max_required_level, pd.required_level);
+    }
+    // Bucket ports by level, keeping topological order within a level
+    auto bucket = [&](bool backward, int max_level, std::vector<port_id_t> &order, std::vector<int> &level_start) {
+        level_start.assign(max_level + 2, 0);
+        for (auto p : topological_order)
+            ++level_start.at((backward ? ports.at(p).required_level : ports.at(p).arrival_level) + 1);
+        for (int l = 0; l <= max_level; l++)
+            level_start.at(l + 1) += level_start.at(l);
+        std::vector<int> cursor(level_start.begin(), level_start.end() - 1);
+        order.resize(topological_order.size());
+        for (auto p : topological_order)
+            order.at(cursor.at(backward ? ports.at(p).required_level : ports.at(p).arrival_level)++) = p;
+    };
+    bucket(false, max_arrival_level, arrival_order, arrival_level_start);
+    bucket(true, max_required_level, required_order, required_level_start);
+    levelised = true;
+}
+
+void TimingAnalyser::propagate_arrival(port_id_t port)
+{
+    static const auto init_delay =
+            DelayPair(std::numeric_limits<delay_t>::max(), std::numeric_limits<delay_t>::lowest());
+    auto &pd = ports.at(port);
+    for (int i = arrival.start.at(port); i < arrival.start.at(port + 1); i++) {
+        auto &arr = arrival.data.at(i);
+        arr.value = init_delay;
+        arr.path_length = 0;
+        arr.bwd_min = -1;
+        arr.bwd_max = -1;
+    }
+    for (auto &seed : pd.arrival_seeds)
+        set_arrival_time(port, seed.domain, seed.value, 1, seed.clock_port);
+    for (int i = fanin_start.at(port); i < fanin_start.at(port + 1); i++) {
+        auto &edge = fanin.at(i);
+        DelayPair delay = edge.is_route ? pd.route_delay : edge.cell_delay.delayPair();
+        int path_inc = edge.is_route ? 0 : 1;
+        for (int j = arrival.start.at(edge.port); j < arrival.start.at(edge.port + 1); j++) {
+            auto &arr = arrival.data.at(j);
+            set_arrival_time(port, arrival.domain.at(j), arr.value + delay, arr.path_length + path_inc, edge.port);
+        }
+    }
+}
+
+void TimingAnalyser::propagate_required(port_id_t port)
+{
+    static const auto init_delay =
+            DelayPair(std::numeric_limits<delay_t>::max(), std::numeric_limits<delay_t>::lowest());
+    auto &pd = ports.at(port);
+    for (int i = required.start.at(port); i < required.start.at(port + 1); i++) {
+        auto &req = required.data.at(i);
+        req.value = init_delay;
+        req.path_length = 0;
+        req.bwd_min = -1;
+        req.bwd_max = -1;
+    }
+    for (auto &seed : pd.required_seeds)
+        set_required_time(port, seed.domain, seed.value, 1, seed.clock_port);
+    for (int i = fanout_start.at(port); i < fanout_start.at(port + 1); i++) {
+        auto &edge = fanout.at(i);
+        DelayPair delay(edge.is_route ? ports.at(edge.port).route_delay.maxDelay() : edge.cell_delay.maxDelay());
+        int path_inc = edge.is_route ? 0 : 1;
+        for (int j = required.start.at(edge.port); j < required.start.at(edge.port + 1); j++) {
+            auto &req = required.data.at(j);
+            set_required_time(port, required.domain.at(j), req.value - delay, req.path_length + path_inc, edge.port);
+        }
+    }
+}
+
+void TimingAnalyser::for_each_levelised(const std::vector<port_id_t> &order, const std::vector<int> &level_start,
+                                        std::function<void(int, port_id_t)> func)
+{
+    // Not worth using threads for small graphs
+    int n_threads = (order.size() >= 20000) ? threads : 1;
+    if (n_threads > 1) {
+        for (size_t l = 0; (l + 1) < level_start.size(); l++) {
+            int begin = level_start.at(l), end = level_start.at(l + 1);
+            if ((end - begin) < 256) {
+                for (int i = begin; i < end; i++)
+                    func(0, order.at(i));
                 continue;
+            }
+            // Task t visits every n_threads'th port of the level, so t can index per-thread scratch data
+            ctx->threadPool().parallel_for(
+                    0, n_threads,
+                    [&](int t) {
+                        for (int i = begin + t; i < end; i += n_threads)
+                            func(t, order.at(i));
+                    },
+                    1);
+        }
+        return;
+    }
+    for (auto port : order)
+        func(0, port);
+}
+
+void TimingAnalyser::run_levelised()
+{
+    for_each_levelised(arrival_order, arrival_level_start, [&](int, port_id_t port) { propagate_arrival(port); });
+    for_each_levelised(required_order, required_level_start, [&](int, port_id_t port) { propagate_required(port); });
+    compute_slack();
+    compute_criticality();
+}
 
-            float crit =
-                    1.0f - (float(pdp.second.setup_slack) - float(dp.worst_setup_slack)) / float(-dp.worst_setup_slack);
-            crit = std::min(crit, 1.0f);
-            crit = std::max(crit, 0.0f);
-            pdp.second.criticality = crit;
-            pd.worst_crit = std::max(pd.worst_crit, crit);
+bool TimingAnalyser::run_incremental()
+{
+    if (!incremental || !levelised || !have_times || setup_only != last_setup_only)
+        return false;
+    // Give up and do a full run once the cones cover a sizeable part of the design
+    size_t limit = ports.size() / 4;
+    std::vector<port_id_t> fwd_cone, bwd_cone;
+    auto visit = [&](std::vector<port_id_t> &cone, port_id_t port) {
+        auto &pd = ports.at(port);
+        if (!pd.in_cone) {
+            pd.in_cone = true;
+            cone.push_back(port);
+        }
+    };
+    // A changed route delay affects the arrival time at the sink and everything downstream of it...
+    for (auto port : changed_ports)
+        visit(fwd_cone, port);
+    for (size_t i = 0; i < fwd_cone.size() && fwd_cone.size() <= limit; i++) {
+        port_id_t p = fwd_cone.at(i);
+        for (int j = fanout_start.at(p); j < fanout_start.at(p + 1); j++)
+            visit(fwd_cone, fanout.at(j).port);
+    }
+    for (auto port : fwd_cone)
+        ports.at(port).in_cone = false;
+    // ...and the required time at the driver and everything upstream of it
+    auto visit_bwd = [&](port_id_t p) {
+        for (int j = fanin_start.at(p); j < fanin_start.at(p + 1); j++)
+            visit(bwd_cone, fanin.at(j).port);
+    };
+    for (auto port : changed_ports)
+        visit_bwd(port);
+    for (size_t i = 0; i < bwd_cone.size() && (fwd_cone.size() + bwd_cone.size()) <= limit; i++)
+        visit_bwd(bwd_cone.at(i));
+    for (auto port : bwd_cone)
+        ports.at(port).in_cone = false;
+    if ((fwd_cone.size() + bwd_cone.size()) > limit)
+        return false;
+
+    // Re-propagate the cones in level order
+    auto sort_cone = [&](std::vector<port_id_t> &cone, bool backward, std::vector<int> &level_start) {
+        auto level = [&](port_id_t p) { return backward ? ports.at(p).required_level : ports.at(p).arrival_level; };
+        std::stable_sort(cone.begin(), cone.end(), [&](port_id_t a, port_id_t b) { return level(a) < level(b); });
+        level_start.clear();
+        for (int i = 0; i < int(cone.size()); i++) {
+            if (i == 0 || level(cone.at(i)) != level(cone.at(i - 1)))
+                level_start.push_back(i);
+        }
+        level_start.push_back(int(cone.size()));
+    };
+    std::vector<int> fwd_level_start, bwd_level_start;
+    sort_cone(fwd_cone, false, fwd_level_start);
+    sort_cone(bwd_cone, true, bwd_level_start);
+    for_each_levelised(fwd_cone, fwd_level_start, [&](int, port_id_t port) { propagate_arrival(port); });
+    for_each_levelised(bwd_cone, bwd_level_start, [&](int, port_id_t port) { propagate_required(port); });
+
+    // Update slack of affected ports, tracking whether the worst slack of a domain pair might have got better
+    std::vector<port_id_t> affected;
+    for (auto &cone : {std::cref(fwd_cone), std::cref(bwd_cone)})
+        for (auto port : cone.get())
+            visit(affected, port);
+    std::vector<delay_t> old_worst_setup;
+    for (auto &dp : domain_pairs)
+        old_worst_setup.push_back(dp.worst_setup_slack);
+    bool rescan = false;
+    std::vector<PortDomainPairData> old_slack;
+    for (auto port : affected) {
+        ports.at(port).in_cone = false;
+        int begin = port_domain_pairs.start.at(port), end = port_domain_pairs.start.at(port + 1);
+        old_slack.assign(port_domain_pairs.data.begin() + begin, port_domain_pairs.data.begin() + end);
+        compute_port_slack(port);
+        for (int i = begin; i < end; i++) {
+            auto &pdp = port_domain_pairs.data.at(i);
+            auto &dp = domain_pairs.at(port_domain_pairs.domain.at(i));
+            auto &old = old_slack.at(i - begin);
+            if ((old.setup_slack == dp.worst_setup_slack && pdp.setup_slack > old.setup_slack) ||
+                (!setup_only && old.hold_slack == dp.worst_hold_slack && pdp.hold_slack > old.hold_slack))
+                rescan = true;
+            dp.worst_setup_slack = std::min(dp.worst_setup_slack, pdp.setup_slack);
+            if (!setup_only)
+                dp.worst_hold_slack = std::min(dp.worst_hold_slack, pdp.hold_slack);
+        }
+    }
+    if (rescan) {
+        for (auto &dp : domain_pairs) {
+            dp.worst_setup_slack = std::numeric_limits<delay_t>::max();
+            dp.worst_hold_slack = std::numeric_limits<delay_t>::max();
+        }
+        for (int i = 0; i < int(port_domain_pairs.data.size()); i++) {
+            auto &pdp = port_domain_pairs.data.at(i);
+            auto &dp = domain_pairs.at(port_domain_pairs.domain.at(i));
+            dp.worst_setup_slack = std::min(dp.worst_setup_slack, pdp.setup_slack);
+            if (!setup_only)
+                dp.worst_hold_slack = std::min(dp.worst_hold_slack, pdp.hold_slack);
         }
     }
+
+    // Criticality is relative to the worst slack; so if that moved, everything needs updating
+    bool worst_changed = false;
+    for (size_t i = 0; i < domain_pairs.size(); i++)
+        worst_changed |= (domain_pairs.at(i).worst_setup_slack != old_worst_setup.at(i));
+    if (worst_changed) {
+        compute_criticality();
+    } else {
+        for (auto port : affected)
+            compute_port_criticality(port);
+    }
+    return true;
 }
 
 void TimingAnalyser::build_detailed_net_timing_report()
@@ -749,10 +1080,10 @@ void TimingAnalyser::build_detailed_net_timing_report()
             auto &pd = ports.at(ep.first);
             const NetInfo *net = port_info(ep.first).net;
 
-            for (auto &arr : pd.arrival) {
-                auto &launch = domains.at(arr.first).key;
-                for (auto &req : pd.required) {
-                    auto &capture = domains.at(req.first).key;
+            for (int i = arrival.start.at(ep.first); i < arrival.start.at(ep.first + 1); i++) {
+                auto &launch = domains.at(arrival.domain.at(i)).key;
+                for (int j = required.start.at(ep.first); j < required.start.at(ep.first + 1); j++) {
+                    auto &capture = domains.at(required.domain.at(j)).key;
 
                     NetSinkTiming sink_timing;
                     sink_timing.clock_pair.start.clock = launch.clock;
@@ -760,7 +1091,7 @@ void TimingAnalyser::build_detailed_net_timing_report()
                     sink_timing.clock_pair.end.clock = capture.clock;
                     sink_timing.clock_pair.end.edge = capture.edge;
                     sink_timing.cell_port = std::make_pair(pd.cell_port.cell, pd.cell_port.port);
-                    sink_timing.delay = arr.second.value;
+                    sink_timing.delay = arrival.data.at(i).value;
 
                     net_timings[net->name].push_back(sink_timing);
                 }
@@ -769,26 +1100,26 @@ void TimingAnalyser::build_detailed_net_timing_report()
     }
 }
 
-std::vector<CellPortKey> TimingAnalyser::get_worst_eps(domain_id_t domain_pair, int count)
+std::vector<port_id_t> TimingAnalyser::get_worst_eps(domain_id_t domain_pair, int count)
 {
-    std::vector<CellPortKey> worst_eps;
+    std::vector<port_id_t> worst_eps;
     delay_t last_slack = std::numeric_limits<delay_t>::lowest();
     auto &dp = domain_pairs.at(domain_pair);
     auto &cap_d = domains.at(dp.key.capture);
     while (int(worst_eps.size()) < count) {
-        CellPortKey next;
+        port_id_t next = -1;
         delay_t next_slack = std::numeric_limits<delay_t>::max();
         for (auto ep : cap_d.endpoints) {
-            auto &pd = ports.at(ep.first);
-            if (!pd.domain_pairs.count(domain_pair))
+            int idx = port_domain_pairs.find(ep.first, domain_pair);
+            if (idx == -1)
                 continue;
-            delay_t ep_slack = pd.domain_pairs.at(domain_pair).setup_slack;
+            delay_t ep_slack = port_domain_pairs.data.at(idx).setup_slack;
             if (ep_slack < next_slack && ep_slack > last_slack) {
                 next = ep.first;
                 next_slack = ep_slack;
             }
         }
-        if (next == CellPortKey())
+        if (next == -1)
             break;
         worst_eps.push_back(next);
         last_slack = next_slack;
@@ -796,7 +1127,7 @@ std::vector<CellPortKey> TimingAnalyser::get_worst_eps(domain_id_t domain_pair,
     return worst_eps;
 }
 
-CriticalPath TimingAnalyser::build_critical_path_report(domain_id_t domain_pair, CellPortKey endpoint)
+CriticalPath TimingAnalyser::build_critical_path_report(domain_id_t domain_pair, port_id_t endpoint)
 {
     CriticalPath report;
 
@@ -830,7 +1161,7 @@ CriticalPath TimingAnalyser::build_critical_path_report(domain_id_t domain_pair,
     std::vector<PortRef> crit_path_rev;
     auto cursor = endpoint;
 
-    while (cursor != CellPortKey()) {
+    while (cursor != -1) {
         auto cell = cell_info(cursor);
         auto &port = port_info(cursor);
 
@@ -844,10 +1175,11 @@ CriticalPath TimingAnalyser::build_critical_path_report(domain_id_t domain_pair,
         if (portClass != TMG_CLOCK_INPUT && portClass != TMG_IGNORE && port.type == PortType::PORT_IN)
             crit_path_rev.emplace_back(PortRef{cell, port.name});
 
-        if (!ports.at(cursor).arrival.count(dp.key.launch))
+        int idx = arrival.find(cursor, dp.key.launch);
+        if (idx == -1)
             break;
 
-        cursor = ports.at(cursor).arrival.at(dp.key.launch).bwd_max;
+        cursor = arrival.data.at(idx).bwd_max;
     }
 
     auto crit_path = boost::adaptors::reverse(crit_path_rev);
@@ -1033,12 +1365,10 @@ void TimingAnalyser::build_slack_histogram_report()
 
     for (domain_id_t dom_id = 0; dom_id < domain_id_t(domains.size()); ++dom_id) {
         for (auto &ep : domains.at(dom_id).endpoints) {
-            auto &pd = ports.at(ep.first);
-
-            for (auto &req : pd.required) {
-                auto &capture = domains.at(req.first).key;
-                for (auto &arr : pd.arrival) {
-                    auto &launch = domains.at(arr.first).key;
+            for (int i = required.start.at(ep.first); i < required.start.at(ep.first + 1); i++) {
+                auto &capture = domains.at(required.domain.at(i)).key;
+                for (int j = arrival.start.at(ep.first); j < arrival.start.at(ep.first + 1); j++) {
+                    auto &launch = domains.at(arrival.domain.at(j)).key;
 
                     if (launch.clock != capture.clock || launch.is_async())
                         continue;
@@ -1050,7 +1380,7 @@ void TimingAnalyser::build_slack_histogram_report()
                     if (launch.edge != capture.edge)
                         clk_period = clk_period / 2;
 
-                    delay_t delay = arr.second.value.maxDelay() - req.second.value.minDelay();
+                    delay_t delay = arrival.data.at(j).value.maxDelay() - required.data.at(i).value.minDelay();
                     delay_t slack = clk_period - delay;
 
                     int slack_ps = ctx->getDelayNS(slack) * 1000;
@@ -1087,18 +1417,14 @@ domain_id_t TimingAnalyser::domain_pair_id(domain_id_t launch, domain_id_t captu
     return inserted.first->second;
 }
 
-void TimingAnalyser::copy_domains(const CellPortKey &from, const CellPortKey &to, bool backward)
+CellInfo *TimingAnalyser::cell_info(port_id_t port) { return ctx->cells.at(ports.at(port).cell_port.cell).get(); }
+
+PortInfo &TimingAnalyser::port_info(port_id_t port)
 {
-    auto &f = ports.at(from), &t = ports.at(to);
-    for (auto &dom : (backward ? f.required : f.arrival)) {
-        updated_domains |= (backward ? t.required : t.arrival).emplace(dom.first, ArrivReqTime{}).second;
-    }
+    auto &key = ports.at(port).cell_port;
+    return ctx->cells.at(key.cell)->ports.at(key.port);
 }
 
-CellInfo *TimingAnalyser::cell_info(const CellPortKey &key) { return ctx->cells.at(key.cell).get(); }
-
-PortInfo &TimingAnalyser::port_info(const CellPortKey &key) { return ctx->cells.at(key.cell)->ports.at(key.port); }
-
 void timing_analysis(Context *ctx, bool print_slack_histogram, bool print_fmax, bool print_path, bool warn_on_failure,
                      bool update_results)
 {
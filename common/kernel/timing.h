@@ -21,6 +21,7 @@
 #ifndef TIMING_H
 #define TIMING_H
 
+#include <functional>
 #include "nextpnr.h"
 
 NEXTPNR_NAMESPACE_BEGIN
@@ -59,6 +60,7 @@ struct ClockDomainKey
 };
 
 typedef int domain_id_t;
+typedef int port_id_t;
 
 struct ClockDomainPairKey
 {
@@ -84,13 +86,14 @@ struct TimingAnalyser
     // model), but want to re-run STA with their own calculated delays
     void set_route_delay(CellPortKey port, DelayPair value);
 
-    float get_criticality(CellPortKey port) const { return ports.at(port).worst_crit; }
-    float get_setup_slack(CellPortKey port) const { return ports.at(port).worst_setup_slack; }
+    float get_criticality(CellPortKey port) const { return ports.at(port_to_id.at(port)).worst_crit; }
+    float get_setup_slack(CellPortKey port) const { return ports.at(port_to_id.at(port)).worst_setup_slack; }
     float get_domain_setup_slack(CellPortKey port) const
     {
         delay_t slack = std::numeric_limits<delay_t>::max();
-        for (const auto &dp : ports.at(port).domain_pairs)
-            slack = std::min(slack, domain_pairs.at(dp.first).worst_setup_slack);
+        port_id_t id = port_to_id.at(port);
+        for (int i = port_domain_pairs.start.at(id); i < port_domain_pairs.start.at(id + 1); i++)
+            slack = std::min(slack, domain_pairs.at(port_domain_pairs.domain.at(i)).worst_setup_slack);
         return slack;
     }
 
@@ -101,12 +104,17 @@ struct TimingAnalyser
     bool setup_only = false;
     bool have_loops = false;
     bool updated_domains = false;
+    // Only re-propagate the fan-in/fan-out cones of ports whose route delay changed since the last run
+    bool incremental = true;
+    // Number of threads for levelised propagation; small designs are always analysed serially
+    int threads = 1;
 
   private:
     void init_ports();
     void get_cell_delays();
     void get_route_delays();
     void topo_sort();
+    void build_graph();
     void setup_port_domains();
     void identify_related_domains();
 
@@ -118,21 +126,36 @@ struct TimingAnalyser
     void compute_slack();
     void compute_criticality();
 
+    // Levelised, pull-based propagation; used when the timing graph is acyclic
+    void setup_levels();
+    bool run_incremental();
+    void run_levelised();
+    void propagate_arrival(port_id_t port);
+    void propagate_required(port_id_t port);
+    void compute_port_slack(port_id_t port);
+    void compute_port_criticality(port_id_t port);
+    // Calls func(thread, port) for each port in order; ports in the same level (delimited by level_start) may be
+    // processed concurrently
+    void for_each_levelised(const std::vector<port_id_t> &order, const std::vector<int> &level_start,
+                            std::function<void(int, port_id_t)> func);
+
+    void set_route_delay(port_id_t port, DelayPair value);
+
     void build_detailed_net_timing_report();
-    CriticalPath build_critical_path_report(domain_id_t domain_pair, CellPortKey endpoint);
+    CriticalPath build_critical_path_report(domain_id_t domain_pair, port_id_t endpoint);
     void build_crit_path_reports();
     void build_slack_histogram_report();
 
     dict<domain_id_t, delay_t> max_delay_by_domain_pairs();
 
     // get the N worst endpoints for a given domain pair
-    std::vector<CellPortKey> get_worst_eps(domain_id_t domain_pair, int count);
+    std::vector<port_id_t> get_worst_eps(domain_id_t domain_pair, int count);
 
     // Set arrival/required times if more/less than the current value
-    void set_arrival_time(CellPortKey target, domain_id_t domain, DelayPair arrival, int path_length,
-                          CellPortKey prev = CellPortKey());
-    void set_required_time(CellPortKey target, domain_id_t domain, DelayPair required, int path_length,
-                           CellPortKey prev = CellPortKey());
+    void set_arrival_time(port_id_t target, domain_id_t domain, DelayPair arrival, int path_length,
+                          port_id_t prev = -1);
+    void set_required_time(port_id_t target, domain_id_t domain, DelayPair required, int path_length,
+                           port_id_t prev = -1);
 
     // To avoid storing the domain tag structure (which could get large when considering more complex constrained tag
     // cases), assign each domain an ID and use that instead
@@ -141,8 +164,8 @@ struct TimingAnalyser
     struct ArrivReqTime
     {
         DelayPair value;
-        CellPortKey bwd_min, bwd_max;
-        int path_length;
+        port_id_t bwd_min = -1, bwd_max = -1;
+        int path_length = 0;
     };
     // Data per port-domain tuple
     struct PortDomainPairData
@@ -152,6 +175,39 @@ struct TimingAnalyser
         float criticality = 0;
     };
 
+    // Per-domain data for every port, stored contiguously. The entries of port i are [start[i], start[i+1]); ports
+    // only see a handful of domains so lookups are a linear scan
+    template <typename T> struct DomainTable
+    {
+        std::vector<int> start;
+        std::vector<domain_id_t> domain;
+        std::vector<T> data;
+
+        int find(port_id_t port, domain_id_t dom) const
+        {
+            for (int i = start.at(port); i < start.at(port + 1); i++)
+                if (domain[i] == dom)
+                    return i;
+            return -1;
+        }
+        T &at(port_id_t port, domain_id_t dom)
+        {
+            int i = find(port, dom);
+            NPNR_ASSERT(i != -1);
+            return data[i];
+        }
+        void build(const std::vector<std::vector<domain_id_t>> &port_domains)
+        {
+            start.assign(1, 0);
+            domain.clear();
+            for (auto &doms : port_domains) {
+                domain.insert(domain.end(), doms.begin(), doms.end());
+                start.push_back(int(domain.size()));
+            }
+            data.assign(domain.size(), T());
+        }
+    };
+
     // A cell timing arc, used to cache cell timings and reduce the number of potentially-expensive Arch API calls
     struct CellArc
     {
@@ -177,15 +233,29 @@ struct TimingAnalyser
                 : type(type), other_port(other_port), value(value), edge(edge) {};
     };
 
+    // An edge of the timing graph, stored in the fan-in list of its sink and the fan-out list of its source
+    struct TimingEdge
+    {
+        // the port at the other end of the edge
+        port_id_t port;
+        // Routing edges use the route delay of the sink port; cell edges the delay of the combinational arc
+        bool is_route;
+        DelayQuad cell_delay;
+    };
+
+    // Initial arrival time at a startpoint, or required time at an endpoint
+    struct TimingSeed
+    {
+        domain_id_t domain;
+        DelayPair value;
+        port_id_t clock_port;
+    };
+
     // Timing data for every cell port
     struct PerPort
     {
         CellPortKey cell_port;
         PortType type;
-        // per domain timings
-        dict<domain_id_t, ArrivReqTime> arrival;
-        dict<domain_id_t, ArrivReqTime> required;
-        dict<domain_id_t, PortDomainPairData> domain_pairs;
         // cell timing arcs to (outputs)/from (inputs)  from this port
         std::vector<CellArc> cell_arcs;
         // routing delay into this port (input ports only)
@@ -194,6 +264,10 @@ struct TimingAnalyser
         float worst_crit = 0;
         delay_t worst_setup_slack = std::numeric_limits<delay_t>::max(),
                 worst_hold_slack = std::numeric_limits<delay_t>::max();
+        std::vector<TimingSeed> arrival_seeds, required_seeds;
+        int arrival_level = -1, required_level = -1;
+        bool route_delay_changed = false;
+        bool in_cone = false;
     };
 
     struct PerDomain
@@ -201,7 +275,7 @@ struct TimingAnalyser
         PerDomain(ClockDomainKey key) : key(key) {};
         ClockDomainKey key;
         // these are pairs (signal port; clock port)
-        std::vector<std::pair<CellPortKey, IdString>> startpoints, endpoints;
+        std::vector<std::pair<port_id_t, IdString>> startpoints, endpoints;
     };
 
     struct PerDomainPair
@@ -210,25 +284,47 @@ struct TimingAnalyser
         ClockDomainPairKey key;
         DelayPair period{0};
         delay_t worst_setup_slack, worst_hold_slack;
+        // Delay between launch and capture clock, if they are related
+        delay_t clock_to_clock = 0;
     };
 
-    CellInfo *cell_info(const CellPortKey &key);
-    PortInfo &port_info(const CellPortKey &key);
+    CellInfo *cell_info(port_id_t port);
+    PortInfo &port_info(port_id_t port);
 
     domain_id_t domain_id(IdString cell, IdString clock_port, ClockEdge edge);
     domain_id_t domain_id(const NetInfo *net, ClockEdge edge);
     domain_id_t domain_pair_id(domain_id_t launch, domain_id_t capture);
 
-    void copy_domains(const CellPortKey &from, const CellPortKey &to, bool backwards);
+    // Ports are numbered densely in the order they are first seen; ids stay stable across calls to setup()
+    std::vector<PerPort> ports;
+    dict<CellPortKey, port_id_t> port_to_id;
+
+    // The timing graph in compressed sparse row form: the fan-in edges of port i are fanin[fanin_start[i]] up to
+    // fanin[fanin_start[i+1]], likewise for fan-out. Fan-in is sorted in topological order of the source, and fan-out
+    // in reverse topological order of the sink, matching the order the serial walks visit them
+    std::vector<int> fanin_start, fanout_start;
+    std::vector<TimingEdge> fanin, fanout;
+
+    // Per-domain timings
+    DomainTable<ArrivReqTime> arrival, required;
+    DomainTable<PortDomainPairData> port_domain_pairs;
 
-    dict<CellPortKey, PerPort> ports;
     dict<ClockDomainKey, domain_id_t> domain_to_id;
     dict<ClockDomainPairKey, domain_id_t> pair_to_id;
     std::vector<PerDomain> domains;
     std::vector<PerDomainPair> domain_pairs;
     dict<std::pair<IdString, IdString>, delay_t> clock_delays;
 
-    std::vector<CellPortKey> topological_order;
+    std::vector<port_id_t> topological_order;
+
+    // Ports sorted by arrival (forward) and required (backward) level, with the start index of each level
+    std::vector<port_id_t> arrival_order, required_order;
+    std::vector<int> arrival_level_start, required_level_start;
+    bool levelised = false;
+    // Whether the previous run left valid times that an incremental run can start from
+    bool have_times = false;
+    bool last_setup_only = false;
+    std::vector<port_id_t> changed_ports;
 
     domain_id_t async_clock_id;
 
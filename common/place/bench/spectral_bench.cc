@@ -0,0 +1,171 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+// Benchmark of the static placer's spectral solver against the plain oourafft 2D transforms it replaced.
+//
+// Usage: nextpnr-spectral-bench [threads [groups [reps [m...]]]]
+//
+// For each grid size m, solves `groups` random density maps (as the placer does once per cell group) `reps` times with
+// both implementations, and prints the average time per solve of all groups and the largest difference in the results.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "fftsg.h"
+#include "spectral_solver.h"
+#include "thread_pool.h"
+
+USING_NEXTPNR_NAMESPACE
+
+namespace {
+
+struct Grid
+{
+    explicit Grid(int m) : storage(size_t(m) * m), rows(m)
+    {
+        for (int x = 0; x < m; x++)
+            rows[x] = &storage[size_t(x) * m];
+    }
+    std::vector<float> storage;
+    std::vector<float *> rows;
+};
+
+struct Problem
+{
+    explicit Problem(int m) : density(m), phi(m), fx(m), fy(m) {}
+    Grid density, phi, fx, fy;
+};
+
+// The solve as StaticPlacer::run_fft did it before the spectral solver, with one shared set of oourafft tables
+void reference_solve(int m, Problem &p, std::vector<int> &ip, std::vector<float> &w)
+{
+    const float pi = 3.141592653589793f;
+    float **dens = p.density.rows.data();
+    ddct2d(m, m, -1, dens, nullptr, ip.data(), w.data());
+    for (int x = 0; x < m; x++)
+        dens[x][0] *= 0.5f;
+    for (int y = 0; y < m; y++)
+        dens[0][y] *= 0.5f;
+    for (int x = 0; x < m; x++)
+        for (int y = 0; y < m; y++)
+            dens[x][y] *= (4.0f / (m * m));
+    for (int x = 0; x < m; x++) {
+        float wx = pi * (x / float(m));
+        float wx2 = wx * wx;
+        for (int y = 0; y < m; y++) {
+            float wy = pi * (y / float(m));
+            float wy2 = wy * wy;
+            float phi = 0, ex = 0, ey = 0;
+            if (x != 0 || y != 0) {
+                phi = dens[x][y] / (wx2 + wy2);
+                ex = phi * wx;
+                ey = phi * wy;
+            }
+            p.phi.rows[x][y] = phi;
+            p.fx.rows[x][y] = ex;
+            p.fy.rows[x][y] = ey;
+        }
+    }
+    ddct2d(m, m, 1, p.phi.rows.data(), nullptr, ip.data(), w.data());
+    ddsct2d(m, m, 1, p.fx.rows.data(), nullptr, ip.data(), w.data());
+    ddcst2d(m, m, 1, p.fy.rows.data(), nullptr, ip.data(), w.data());
+}
+
+void load_input(std::vector<Problem> &problems, const std::vector<float> &input)
+{
+    for (auto &p : problems)
+        std::copy(input.begin(), input.end(), p.density.storage.begin());
+}
+
+float max_diff(const Grid &a, const Grid &b)
+{
+    float diff = 0;
+    for (size_t i = 0; i < a.storage.size(); i++)
+        diff = std::max(diff, std::abs(a.storage[i] - b.storage[i]));
+    return diff;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int threads = (argc > 1) ? std::atoi(argv[1]) : 1;
+    int groups = (argc > 2) ? std::atoi(argv[2]) : 3;
+    int reps = (argc > 3) ? std::atoi(argv[3]) : 5;
+    std::vector<int> sizes;
+    for (int i = 4; i < argc; i++)
+        sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty())
+        sizes = {256, 512, 1024, 2048};
+
+    ThreadPool pool(threads);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(0, 1);
+    printf("threads=%d groups=%d reps=%d\n", threads, groups, reps);
+    printf("%8s %14s %14s %8s %12s\n", "m", "oourafft (ms)", "spectral (ms)", "speedup", "max diff");
+    for (int m : sizes) {
+        std::vector<float> input(size_t(m) * m);
+        for (auto &v : input)
+            v = dist(rng);
+
+        std::vector<Problem> ref, res;
+        for (int g = 0; g < groups; g++) {
+            ref.emplace_back(m);
+            res.emplace_back(m);
+        }
+
+        std::vector<int> ip(int(std::round(std::sqrt(m))) + 2, 0);
+        std::vector<float> w(m * 3 / 2, 0);
+        double ref_time = 0;
+        for (int r = 0; r < reps; r++) {
+            load_input(ref, input);
+            auto start = std::chrono::high_resolution_clock::now();
+            for (auto &p : ref)
+                reference_solve(m, p, ip, w);
+            ref_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        std::vector<SpectralSolver> solvers(groups, SpectralSolver(m));
+        double new_time = 0;
+        for (int r = 0; r < reps; r++) {
+            load_input(res, input);
+            auto start = std::chrono::high_resolution_clock::now();
+            pool.parallel_for(0, groups, [&](int g) {
+                Problem &p = res.at(g);
+                solvers.at(g).solve(p.density.rows.data(), p.phi.rows.data(), p.fx.rows.data(), p.fy.rows.data(),
+                                    pool);
+            });
+            new_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        float diff = 0;
+        for (int g = 0; g < groups; g++) {
+            diff = std::max(diff, max_diff(ref.at(g).phi, res.at(g).phi));
+            diff = std::max(diff, max_diff(ref.at(g).fx, res.at(g).fx));
+            diff = std::max(diff, max_diff(ref.at(g).fy, res.at(g).fy));
+        }
+        printf("%8d %14.2f %14.2f %7.2fx %12g\n", m, 1000 * ref_time / reps, 1000 * new_time / reps,
+               ref_time / new_time, diff);
+    }
+    return 0;
+}
@@ -217,10 +217,32 @@ bool DetailPlacerThreadState::bounds_check(BelId bel)
     return true;
 }
 
+CellInfo *DetailPlacerThreadState::get_bound_bel_cell(BelId bel)
+{
+#if !defined(NPNR_DISABLE_THREADS)
+    std::shared_lock<std::shared_timed_mutex> l(g.archapi_mutex, std::defer_lock);
+    if (!ctx->isBelBindingPartitionSafe(bel))
+        l.lock();
+#endif
+    return ctx->getBoundBelCell(bel);
+}
+
+bool DetailPlacerThreadState::check_bel_avail(BelId bel)
+{
+#if !defined(NPNR_DISABLE_THREADS)
+    std::shared_lock<std::shared_timed_mutex> l(g.archapi_mutex, std::defer_lock);
+    if (!ctx->isBelBindingPartitionSafe(bel))
+        l.lock();
+#endif
+    return ctx->checkBelAvail(bel);
+}
+
 bool DetailPlacerThreadState::bind_move()
 {
 #if !defined(NPNR_DISABLE_THREADS)
-    std::unique_lock<std::shared_timed_mutex> l(g.archapi_mutex);
+    std::unique_lock<std::shared_timed_mutex> l(g.archapi_mutex, std::defer_lock);
+    if (move_needs_lock)
+        l.lock();
 #endif
     for (auto &entry : moved_cells) {
         ctx->unbindBel(entry.second.first);
@@ -241,7 +263,9 @@ bool DetailPlacerThreadState::bind_move()
 bool DetailPlacerThreadState::check_validity()
 {
 #if !defined(NPNR_DISABLE_THREADS)
-    std::shared_lock<std::shared_timed_mutex> l(g.archapi_mutex);
+    std::shared_lock<std::shared_timed_mutex> l(g.archapi_mutex, std::defer_lock);
+    if (move_needs_lock)
+        l.lock();
 #endif
     bool result = true;
     for (auto e : moved_cells) {
@@ -264,7 +288,9 @@ void DetailPlacerThreadState::revert_move()
     if (arch_state_dirty) {
         // If changes to the arch state were made, revert them by restoring original cell bindings
 #if !defined(NPNR_DISABLE_THREADS)
-        std::unique_lock<std::shared_timed_mutex> l(g.archapi_mutex);
+        std::unique_lock<std::shared_timed_mutex> l(g.archapi_mutex, std::defer_lock);
+        if (move_needs_lock)
+            l.lock();
 #endif
         for (auto &entry : moved_cells) {
             BelId curr_bound = ctx->cells.at(entry.first)->bel;
@@ -430,6 +456,7 @@ void DetailPlacerThreadState::compute_total_change()
 void DetailPlacerThreadState::reset_move_state()
 {
     moved_cells.clear();
+    move_needs_lock = false;
     cell_rel.clear();
     for (auto &axis : axes) {
         for (auto bc : axis.bounds_changed_nets) {
@@ -454,6 +481,8 @@ bool DetailPlacerThreadState::add_to_move(CellInfo *cell, BelId old_bel, BelId n
     if (!ctx->isValidBelForCellType(cell->type, new_bel))
         return false;
     NPNR_ASSERT(!moved_cells.count(cell->name));
+    if (!ctx->isBelBindingPartitionSafe(old_bel) || !ctx->isBelBindingPartitionSafe(new_bel))
+        move_needs_lock = true;
     moved_cells[cell->name] = std::make_pair(old_bel, new_bel);
     local_cell2bel[cell->name] = new_bel;
     compute_changes_for_cell(cell, old_bel, new_bel);
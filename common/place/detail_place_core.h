@@ -33,9 +33,11 @@ per-move structures; then to add all of the moved cells to the move with add_to_
 
 Evaluation of wirelength and timing changes of a move is done with compute_changes_for_cell and compute_total_change.
 
-bind_move will probationally bind the move using the arch API functions, acquiring a lock during this time to prevent
-races on non-thread-safe arch implementations, returning true if the bind succeeded or false if something went wrong
-and it should be aborted. check_validity must then be called to use the arch API validity check functions on the move.
+bind_move will probationally bind the move using the arch API functions, returning true if the bind succeeded or false
+if something went wrong and it should be aborted. check_validity must then be called to use the arch API validity check
+functions on the move. Partitions never overlap, so moves that only involve bels the arch declares partition-safe
+(isBelBindingPartitionSafe) are bound and checked without any locking; other moves hold a global lock during this
+time to prevent races on non-thread-safe arch implementations.
 
 Finally if the move meets criteria and is accepted then commit_move marks it as committed, otherwise revert_move
 aborts the entire move transaction.
@@ -171,6 +173,8 @@ struct DetailPlacerThreadState
 
     // Data on an inflight move
     dict<IdString, std::pair<BelId, BelId>> moved_cells; // cell -> (old; new)
+    // If the move involves any bels that aren't partition-safe, so the arch API lock must be held to bind it
+    bool move_needs_lock = false;
     // For cluster moves only
     std::vector<std::pair<CellInfo *, Loc>> cell_rel;
     // For incremental wirelength and delay updates
@@ -205,6 +209,9 @@ struct DetailPlacerThreadState
     void reset_move_state();
     // Add a cell change to the move
     bool add_to_move(CellInfo *cell, BelId old_bel, BelId new_bel);
+    // Arch API queries for a bel inside the partition, locking only if needed
+    CellInfo *get_bound_bel_cell(BelId bel);
+    bool check_bel_avail(BelId bel);
     // For an inflight move; attempt to actually apply the changes to the arch API
     bool bind_move();
     // Checks if the arch API bel validity for a move is accepted
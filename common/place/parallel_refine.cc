@@ -29,7 +29,6 @@
 #include <mutex>
 #include <queue>
 #include <shared_mutex>
-#include <thread>
 
 NEXTPNR_NAMESPACE_BEGIN
 
@@ -69,13 +68,7 @@ struct ThreadState : DetailPlacerThreadState
     {
         NPNR_ASSERT(moved_cells.empty());
         BelId old_bel = cell->bel;
-        CellInfo *bound = nullptr;
-        {
-#if !defined(NPNR_DISABLE_THREADS)
-            std::shared_lock<std::shared_timed_mutex> l(g.archapi_mutex);
-#endif
-            bound = ctx->getBoundBelCell(new_bel);
-        }
+        CellInfo *bound = get_bound_bel_cell(new_bel);
         if (bound && (bound->belStrength > STRENGTH_STRONG || bound->cluster != ClusterId()))
             return false;
         if (!add_to_move(cell, old_bel, new_bel))
@@ -125,13 +118,7 @@ struct ThreadState : DetailPlacerThreadState
                 if (used_bels.count(db.second))
                     goto fail;
                 used_bels.insert(db.second);
-                CellInfo *bound = nullptr;
-                {
-#if !defined(NPNR_DISABLE_THREADS)
-                    std::shared_lock<std::shared_timed_mutex> l(g.archapi_mutex);
-#endif
-                    bound = ctx->getBoundBelCell(db.second);
-                }
+                CellInfo *bound = get_bound_bel_cell(db.second);
                 if (bound) {
                     if (moved_cells.count(bound->name)) {
                         // Don't move a cell multiple times in the same go
@@ -157,16 +144,8 @@ struct ThreadState : DetailPlacerThreadState
                         if (!add_to_move(bound, bound->bel, old_bel))
                             goto fail;
                     }
-                } else {
-                    bool avail = false;
-                    {
-#if !defined(NPNR_DISABLE_THREADS)
-                        std::shared_lock<std::shared_timed_mutex> l(g.archapi_mutex);
-#endif
-                        avail = ctx->checkBelAvail(db.second);
-                    }
-                    if (!avail)
-                        goto fail;
+                } else if (!check_bel_avail(db.second)) {
+                    goto fail;
                 }
             }
         }
@@ -321,8 +300,8 @@ struct ThreadState : DetailPlacerThreadState
             int x = t.first, y = t.second;
             int lx = std::max(x - g.radius, p.x0), rx = std::min(x + g.radius, p.x1);
             int by = std::max(y - g.radius, p.y0), ty = std::min(y + g.radius, p.y1);
-            int xn = lx + ctx->rng((rx - lx) + 1);
-            int yn = by + ctx->rng((ty - by) + 1);
+            int xn = lx + rng.rng((rx - lx) + 1);
+            int yn = by + rng.rng((ty - by) + 1);
             ++n_move;
             if (do_tile_swap(x, y, xn, yn)) {
                 ++n_accept;
@@ -438,13 +417,7 @@ struct ParallelRefine
         }
 
         NPNR_ASSERT(parts.size() == t.size());
-        // TODO: thread pool to make this worthwhile...
-        std::vector<std::thread> workers;
-        for (size_t i = 0; i < t.size(); i++) {
-            workers.emplace_back([i, this]() { t.at(i).set_partition(parts.at(i)); });
-        }
-        for (auto &w : workers)
-            w.join();
+        ctx->threadPool().parallel_for(0, int(t.size()), [this](int i) { t.at(i).set_partition(parts.at(i)); }, 1);
     }
 
     void run()
@@ -459,6 +432,7 @@ struct ParallelRefine
         log_info("Running parallel refinement with %d threads.\n", int(t.size()));
         int iter = 1;
         bool done = false;
+        int64_t total_accept = 0;
         g.update_global_costs();
         double avg_wirelen = g.total_wirelen;
         wirelen_t min_wirelen = g.total_wirelen;
@@ -498,19 +472,22 @@ struct ParallelRefine
 
             do_partition();
 
-            std::vector<std::thread> workers;
-            workers.reserve(t.size());
-            for (int j = 0; j < int(t.size()); j++)
-                workers.emplace_back([this, j]() { t.at(j).run_iter(); });
-            for (auto &w : workers)
-                w.join();
+            // Bels are bound from all threads at once, so refresh the UI as a whole afterwards
+            ctx->belUiReloadSuspended = true;
+            ctx->threadPool().parallel_for(0, int(t.size()), [this](int j) { t.at(j).run_iter(); }, 1);
+            ctx->belUiReloadSuspended = false;
+            ctx->refreshUi();
+            for (auto &t_data : t)
+                total_accept += t_data.n_accept;
             g.tmg.run();
             g.update_global_costs();
             iter++;
             ctx->yield();
         }
         auto refine_end = std::chrono::high_resolution_clock::now();
-        log_info("Placement refine time %.02fs\n", std::chrono::duration<float>(refine_end - refine_start).count());
+        float refine_time = std::chrono::duration<float>(refine_end - refine_start).count();
+        log_info("Placement refine time %.02fs (%.0f accepted moves/s).\n", refine_time,
+                 total_accept / std::max(refine_time, 1e-3f));
     }
 };
 } // namespace
@@ -87,16 +87,23 @@ class SAPlacer
         }
 
         net_bounds.resize(ctx->nets.size());
-        net_arc_tcost.resize(ctx->nets.size());
         old_udata.reserve(ctx->nets.size());
         net_by_udata.reserve(ctx->nets.size());
         decltype(NetInfo::udata) n = 0;
         for (auto &net : ctx->nets) {
             old_udata.emplace_back(net.second->udata);
-            net_arc_tcost.at(n).resize(net.second->users.capacity());
             net.second->udata = n++;
             net_by_udata.push_back(net.second.get());
         }
+        old_cell_udata.reserve(ctx->cells.size());
+        cell_by_udata.reserve(ctx->cells.size());
+        decltype(CellInfo::udata) c = 0;
+        for (auto &cell : ctx->cells) {
+            old_cell_udata.emplace_back(cell.second->udata);
+            cell.second->udata = c++;
+            cell_by_udata.push_back(cell.second.get());
+        }
+        setup_flat_netlist();
         for (auto &region : ctx->region) {
             Region *r = region.second.get();
             BoundingBox bb;
@@ -132,6 +139,8 @@ class SAPlacer
     {
         for (auto &net : ctx->nets)
             net.second->udata = old_udata[net.second->udata];
+        for (auto &cell : ctx->cells)
+            cell.second->udata = old_cell_udata[cell.second->udata];
     }
 
     bool place(bool refine = false)
@@ -287,12 +296,14 @@ class SAPlacer
             }
 
             if (ctx->debug) {
-                // Verify correctness of incremental wirelen updates
+                // Verify correctness of incremental location and wirelen updates
+                for (auto ci : cell_by_udata)
+                    NPNR_ASSERT(cell_locs.at(ci->udata) == get_cell_loc(ci));
                 for (size_t i = 0; i < net_bounds.size(); i++) {
                     auto net = net_by_udata[i];
                     if (ignore_net(net))
                         continue;
-                    auto &incr = net_bounds.at(i), gold = get_net_bounds(net);
+                    auto &incr = net_bounds.at(i), gold = get_net_bounds(i);
                     NPNR_ASSERT(incr.x0 == gold.x0);
                     NPNR_ASSERT(incr.x1 == gold.x1);
                     NPNR_ASSERT(incr.y0 == gold.y0);
@@ -365,6 +376,9 @@ class SAPlacer
                     // temp = post_legalise_temp;
                     // diameter = std::min<int>(M, diameter * post_legalise_dia_scale);
                     ctx->shuffle(autoplaced);
+                    // Legalisation moves cells behind our back
+                    if (cfg.netShareWeight > 0)
+                        setup_nets_by_tile();
                 }
                 require_legal = false;
             }
@@ -556,8 +570,10 @@ class SAPlacer
         return true;
     swap_fail:
         ctx->bindBel(oldBel, cell, STRENGTH_WEAK);
+        update_cell_loc(cell);
         if (other_cell != nullptr) {
             ctx->bindBel(newBel, other_cell, STRENGTH_WEAK);
+            update_cell_loc(other_cell);
             if (cfg.netShareWeight > 0)
                 update_nets_by_tile(other_cell, ctx->getBelLocation(oldBel), ctx->getBelLocation(newBel));
         }
@@ -578,8 +594,10 @@ class SAPlacer
             ctx->unbindBel(newBel);
         ctx->unbindBel(oldBel);
         ctx->bindBel(newBel, cell, (cell->cluster != ClusterId()) ? STRENGTH_STRONG : STRENGTH_WEAK);
+        update_cell_loc(cell);
         if (bound != nullptr) {
             ctx->bindBel(oldBel, bound, (bound->cluster != ClusterId()) ? STRENGTH_STRONG : STRENGTH_WEAK);
+            update_cell_loc(bound);
             if (cfg.netShareWeight > 0)
                 update_nets_by_tile(bound, ctx->getBelLocation(newBel), ctx->getBelLocation(oldBel));
         }
@@ -593,6 +611,8 @@ class SAPlacer
     {
         std::vector<std::pair<CellInfo *, Loc>> cell_rel;
         dict<IdString, BelId> moved_cells;
+        // Cells that have been moved in nets_by_tile, and need moving back if the swap fails
+        std::vector<CellInfo *> share_moved_cells;
         double delta = 0;
         int orig_share_cost = total_net_share;
         moveChange.reset(this);
@@ -675,9 +695,11 @@ class SAPlacer
         for (const auto &mm : moved_cells) {
             CellInfo *cell = ctx->cells.at(mm.first).get();
             add_move_cell(moveChange, cell, moved_cells.at(cell->name));
-            if (cfg.netShareWeight > 0)
+            if (cfg.netShareWeight > 0) {
                 update_nets_by_tile(cell, ctx->getBelLocation(moved_cells.at(cell->name)),
                                     ctx->getBelLocation(cell->bel));
+                share_moved_cells.push_back(cell);
+            }
             if (!ctx->isBelLocationValid(cell->bel) || !cell->testRegion(cell->bel))
                 goto swap_fail;
         }
@@ -707,6 +729,9 @@ class SAPlacer
 #if CHAIN_DEBUG
         log_info("Swap failed\n");
 #endif
+        for (auto moved : share_moved_cells)
+            update_nets_by_tile(moved, ctx->getBelLocation(moved->bel),
+                                ctx->getBelLocation(moved_cells.at(moved->name)));
         for (auto cell_pair : moved_cells) {
             CellInfo *cell = ctx->cells.at(cell_pair.first).get();
             if (cell->bel != BelId()) {
@@ -722,6 +747,7 @@ class SAPlacer
             log_info("%d bind %s %s\n", __LINE__, ctx->nameOfBel(cell_pair.second), cell->name.c_str(ctx));
 #endif
             ctx->bindBel(cell_pair.second, cell, STRENGTH_WEAK);
+            update_cell_loc(cell);
         }
         return false;
     }
@@ -782,12 +808,12 @@ class SAPlacer
                ctx->getBelGlobalBuf(net->driver.cell->bel);
     }
 
-    // Get the bounding box for a net
-    inline BoundingBox get_net_bounds(NetInfo *net)
+    // Get the bounding box for a net, from the cached cell locations
+    inline BoundingBox get_net_bounds(int net)
     {
         BoundingBox bb;
-        NPNR_ASSERT(net->driver.cell != nullptr);
-        Loc dloc = net->driver.cell->getLocation();
+        NPNR_ASSERT(net_driver[net] != -1);
+        Loc dloc = cell_locs[net_driver[net]];
         bb.x0 = dloc.x;
         bb.x1 = dloc.x;
         bb.y0 = dloc.y;
@@ -796,10 +822,10 @@ class SAPlacer
         bb.nx1 = 1;
         bb.ny0 = 1;
         bb.ny1 = 1;
-        for (auto user : net->users) {
-            if (!user.cell->isPseudo() && user.cell->bel == BelId())
+        for (int i = net_user_start[net]; i < net_user_start[net + 1]; i++) {
+            const Loc &uloc = cell_locs[net_users[i].cell];
+            if (uloc.x == -1)
                 continue;
-            Loc uloc = user.cell->getLocation();
             if (bb.x0 == uloc.x)
                 ++bb.nx0;
             else if (uloc.x < bb.x0) {
@@ -830,30 +856,54 @@ class SAPlacer
     }
 
     // Get the timing cost for an arc of a net
-    inline double get_timing_cost(NetInfo *net, const PortRef &user)
+    inline double get_timing_cost(int net, int user)
     {
-        int cc;
-        if (net->driver.cell == nullptr)
-            return 0;
-        if (ctx->getPortTimingClass(net->driver.cell, net->driver.port, cc) == TMG_IGNORE)
+        // Arcs that don't matter for timing have no weight, so there is no need to predict their delay
+        float weight = net_arc_weight[net_arc_start[net] + user];
+        if (weight == 0)
             return 0;
+        NetInfo *ni = net_by_udata[net];
+        double delay = ctx->getDelayNS(ctx->predictArcDelay(ni, ni->users.at(store_index<PortRef>(user))));
+        return delay * weight;
+    }
 
-        float crit = tmg.get_criticality(CellPortKey(user));
-        double delay = ctx->getDelayNS(ctx->predictArcDelay(net, user));
-        return delay * std::pow(crit, crit_exp);
+    // Set up the timing weight (criticality ^ crit_exp) of the arcs of a net, after criticalities have changed
+    void setup_arc_weights(int net)
+    {
+        NetInfo *ni = net_by_udata[net];
+        int cc;
+        bool ignore = ni->driver.cell == nullptr ||
+                      ctx->getPortTimingClass(ni->driver.cell, ni->driver.port, cc) == TMG_IGNORE;
+        for (auto usr : ni->users.enumerate()) {
+            float &weight = net_arc_weight[net_arc_start[net] + usr.index.idx()];
+            if (ignore) {
+                weight = 0;
+            } else {
+                float crit = tmg.get_criticality(CellPortKey(usr.value));
+                weight = std::pow(crit, crit_exp);
+            }
+        }
     }
 
     // Set up the cost maps
     void setup_costs()
     {
-        for (auto &net : ctx->nets) {
-            NetInfo *ni = net.second.get();
-            if (ignore_net(ni))
+        // Cells may have been moved outside of the annealer (by legalisation) since last time
+        for (auto ci : cell_by_udata)
+            update_cell_loc(ci);
+        for (int n = 0; n < int(net_by_udata.size()); n++) {
+            NetInfo *ni = net_by_udata[n];
+            net_ignored[n] = ignore_net(ni);
+            if (net_ignored[n])
                 continue;
-            net_bounds[ni->udata] = get_net_bounds(ni);
-            if (cfg.timing_driven && int(ni->users.entries()) < cfg.timingFanoutThresh)
-                for (auto usr : ni->users.enumerate())
-                    net_arc_tcost[ni->udata][usr.index.idx()] = get_timing_cost(ni, usr.value);
+            net_bounds[n] = get_net_bounds(n);
+            if (net_timing[n]) {
+                setup_arc_weights(n);
+                for (int i = net_user_start[n]; i < net_user_start[n + 1]; i++) {
+                    int idx = net_users[i].idx;
+                    net_arc_tcost[net_arc_start[n] + idx] = get_timing_cost(n, idx);
+                }
+            }
         }
     }
 
@@ -870,11 +920,8 @@ class SAPlacer
     double total_timing_cost()
     {
         double cost = 0;
-        for (const auto &net : net_arc_tcost) {
-            for (auto arc_cost : net) {
-                cost += arc_cost;
-            }
-        }
+        for (auto arc_cost : net_arc_tcost)
+            cost += arc_cost;
         return cost;
     }
 
@@ -891,25 +938,25 @@ class SAPlacer
         };
 
         std::vector<decltype(NetInfo::udata)> bounds_changed_nets_x, bounds_changed_nets_y;
-        std::vector<std::pair<decltype(NetInfo::udata), store_index<PortRef>>> changed_arcs;
+        // Net and user index of each changed arc
+        std::vector<std::pair<decltype(NetInfo::udata), int>> changed_arcs;
 
         std::vector<BoundChangeType> already_bounds_changed_x, already_bounds_changed_y;
-        std::vector<std::vector<bool>> already_changed_arcs;
+        // Indexed the same way as net_arc_tcost
+        std::vector<bool> already_changed_arcs;
 
         std::vector<BoundingBox> new_net_bounds;
-        std::vector<std::pair<std::pair<decltype(NetInfo::udata), store_index<PortRef>>, double>> new_arc_costs;
+        // Index into net_arc_tcost and the new cost
+        std::vector<std::pair<int, double>> new_arc_costs;
 
         wirelen_t wirelen_delta = 0;
         double timing_delta = 0;
 
         void init(SAPlacer *p)
         {
-            already_bounds_changed_x.resize(p->ctx->nets.size());
-            already_bounds_changed_y.resize(p->ctx->nets.size());
-            already_changed_arcs.resize(p->ctx->nets.size());
-            for (auto &net : p->ctx->nets) {
-                already_changed_arcs.at(net.second->udata).resize(net.second->users.capacity());
-            }
+            already_bounds_changed_x.resize(p->net_by_udata.size());
+            already_bounds_changed_y.resize(p->net_by_udata.size());
+            already_changed_arcs.resize(p->net_arc_tcost.size());
             new_net_bounds = p->net_bounds;
         }
 
@@ -924,7 +971,7 @@ class SAPlacer
                 already_bounds_changed_y[bc] = NO_CHANGE;
             }
             for (const auto &tc : changed_arcs)
-                already_changed_arcs[tc.first][tc.second.idx()] = false;
+                already_changed_arcs[p->net_arc_start[tc.first] + tc.second] = false;
             bounds_changed_nets_x.clear();
             bounds_changed_nets_y.clear();
             changed_arcs.clear();
@@ -939,46 +986,46 @@ class SAPlacer
     {
         Loc curr_loc = ctx->getBelLocation(cell->bel);
         Loc old_loc = ctx->getBelLocation(old_bel);
+        cell_locs[cell->udata] = curr_loc;
         // Check net bounds
-        for (const auto &port : cell->ports) {
-            NetInfo *pn = port.second.net;
-            if (pn == nullptr)
+        for (int i = cell_pin_start[cell->udata]; i < cell_pin_start[cell->udata + 1]; i++) {
+            const FlatPin &pin = cell_pins[i];
+            int net = pin.net;
+            if (net == -1 || net_ignored[net])
                 continue;
-            if (ignore_net(pn))
-                continue;
-            BoundingBox &curr_bounds = mc.new_net_bounds[pn->udata];
+            BoundingBox &curr_bounds = mc.new_net_bounds[net];
             // Incremental bounding box updates
             // Note that everything other than full updates are applied immediately rather than being queued,
             // so further updates to the same net in the same move are dealt with correctly.
             // If a full update is already queued, this can be considered a no-op
-            if (mc.already_bounds_changed_x[pn->udata] != MoveChangeData::FULL_RECOMPUTE) {
+            if (mc.already_bounds_changed_x[net] != MoveChangeData::FULL_RECOMPUTE) {
                 // Bounds x0
                 if (curr_loc.x < curr_bounds.x0) {
                     // Further out than current bounds x0
                     curr_bounds.x0 = curr_loc.x;
                     curr_bounds.nx0 = 1;
-                    if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE) {
+                    if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE) {
                         // Checking already_bounds_changed_x ensures that each net is only added once
                         // to bounds_changed_nets, lest we add its HPWL change multiple times skewing the
                         // overall cost change
-                        mc.already_bounds_changed_x[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_x.push_back(pn->udata);
+                        mc.already_bounds_changed_x[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_x.push_back(net);
                     }
                 } else if (curr_loc.x == curr_bounds.x0 && old_loc.x > curr_bounds.x0) {
                     curr_bounds.nx0++;
-                    if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE) {
-                        mc.already_bounds_changed_x[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_x.push_back(pn->udata);
+                    if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE) {
+                        mc.already_bounds_changed_x[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_x.push_back(net);
                     }
                 } else if (old_loc.x == curr_bounds.x0 && curr_loc.x > curr_bounds.x0) {
-                    if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE)
-                        mc.bounds_changed_nets_x.push_back(pn->udata);
+                    if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE)
+                        mc.bounds_changed_nets_x.push_back(net);
                     if (curr_bounds.nx0 == 1) {
-                        mc.already_bounds_changed_x[pn->udata] = MoveChangeData::FULL_RECOMPUTE;
+                        mc.already_bounds_changed_x[net] = MoveChangeData::FULL_RECOMPUTE;
                     } else {
                         curr_bounds.nx0--;
-                        if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE)
-                            mc.already_bounds_changed_x[pn->udata] = MoveChangeData::CELL_MOVED_INWARDS;
+                        if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE)
+                            mc.already_bounds_changed_x[net] = MoveChangeData::CELL_MOVED_INWARDS;
                     }
                 }
 
@@ -987,56 +1034,56 @@ class SAPlacer
                     // Further out than current bounds x1
                     curr_bounds.x1 = curr_loc.x;
                     curr_bounds.nx1 = 1;
-                    if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE) {
+                    if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE) {
                         // Checking already_bounds_changed_x ensures that each net is only added once
                         // to bounds_changed_nets, lest we add its HPWL change multiple times skewing the
                         // overall cost change
-                        mc.already_bounds_changed_x[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_x.push_back(pn->udata);
+                        mc.already_bounds_changed_x[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_x.push_back(net);
                     }
                 } else if (curr_loc.x == curr_bounds.x1 && old_loc.x < curr_bounds.x1) {
                     curr_bounds.nx1++;
-                    if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE) {
-                        mc.already_bounds_changed_x[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_x.push_back(pn->udata);
+                    if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE) {
+                        mc.already_bounds_changed_x[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_x.push_back(net);
                     }
                 } else if (old_loc.x == curr_bounds.x1 && curr_loc.x < curr_bounds.x1) {
-                    if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE)
-                        mc.bounds_changed_nets_x.push_back(pn->udata);
+                    if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE)
+                        mc.bounds_changed_nets_x.push_back(net);
                     if (curr_bounds.nx1 == 1) {
-                        mc.already_bounds_changed_x[pn->udata] = MoveChangeData::FULL_RECOMPUTE;
+                        mc.already_bounds_changed_x[net] = MoveChangeData::FULL_RECOMPUTE;
                     } else {
                         curr_bounds.nx1--;
-                        if (mc.already_bounds_changed_x[pn->udata] == MoveChangeData::NO_CHANGE)
-                            mc.already_bounds_changed_x[pn->udata] = MoveChangeData::CELL_MOVED_INWARDS;
+                        if (mc.already_bounds_changed_x[net] == MoveChangeData::NO_CHANGE)
+                            mc.already_bounds_changed_x[net] = MoveChangeData::CELL_MOVED_INWARDS;
                     }
                 }
             }
-            if (mc.already_bounds_changed_y[pn->udata] != MoveChangeData::FULL_RECOMPUTE) {
+            if (mc.already_bounds_changed_y[net] != MoveChangeData::FULL_RECOMPUTE) {
                 // Bounds y0
                 if (curr_loc.y < curr_bounds.y0) {
                     // Further out than current bounds y0
                     curr_bounds.y0 = curr_loc.y;
                     curr_bounds.ny0 = 1;
-                    if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE) {
-                        mc.already_bounds_changed_y[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_y.push_back(pn->udata);
+                    if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE) {
+                        mc.already_bounds_changed_y[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_y.push_back(net);
                     }
                 } else if (curr_loc.y == curr_bounds.y0 && old_loc.y > curr_bounds.y0) {
                     curr_bounds.ny0++;
-                    if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE) {
-                        mc.already_bounds_changed_y[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_y.push_back(pn->udata);
+                    if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE) {
+                        mc.already_bounds_changed_y[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_y.push_back(net);
                     }
                 } else if (old_loc.y == curr_bounds.y0 && curr_loc.y > curr_bounds.y0) {
-                    if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE)
-                        mc.bounds_changed_nets_y.push_back(pn->udata);
+                    if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE)
+                        mc.bounds_changed_nets_y.push_back(net);
                     if (curr_bounds.ny0 == 1) {
-                        mc.already_bounds_changed_y[pn->udata] = MoveChangeData::FULL_RECOMPUTE;
+                        mc.already_bounds_changed_y[net] = MoveChangeData::FULL_RECOMPUTE;
                     } else {
                         curr_bounds.ny0--;
-                        if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE)
-                            mc.already_bounds_changed_y[pn->udata] = MoveChangeData::CELL_MOVED_INWARDS;
+                        if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE)
+                            mc.already_bounds_changed_y[net] = MoveChangeData::CELL_MOVED_INWARDS;
                     }
                 }
 
@@ -1045,45 +1092,43 @@ class SAPlacer
                     // Further out than current bounds y1
                     curr_bounds.y1 = curr_loc.y;
                     curr_bounds.ny1 = 1;
-                    if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE) {
-                        mc.already_bounds_changed_y[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_y.push_back(pn->udata);
+                    if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE) {
+                        mc.already_bounds_changed_y[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_y.push_back(net);
                     }
                 } else if (curr_loc.y == curr_bounds.y1 && old_loc.y < curr_bounds.y1) {
                     curr_bounds.ny1++;
-                    if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE) {
-                        mc.already_bounds_changed_y[pn->udata] = MoveChangeData::CELL_MOVED_OUTWARDS;
-                        mc.bounds_changed_nets_y.push_back(pn->udata);
+                    if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE) {
+                        mc.already_bounds_changed_y[net] = MoveChangeData::CELL_MOVED_OUTWARDS;
+                        mc.bounds_changed_nets_y.push_back(net);
                     }
                 } else if (old_loc.y == curr_bounds.y1 && curr_loc.y < curr_bounds.y1) {
-                    if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE)
-                        mc.bounds_changed_nets_y.push_back(pn->udata);
+                    if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE)
+                        mc.bounds_changed_nets_y.push_back(net);
                     if (curr_bounds.ny1 == 1) {
-                        mc.already_bounds_changed_y[pn->udata] = MoveChangeData::FULL_RECOMPUTE;
+                        mc.already_bounds_changed_y[net] = MoveChangeData::FULL_RECOMPUTE;
                     } else {
                         curr_bounds.ny1--;
-                        if (mc.already_bounds_changed_y[pn->udata] == MoveChangeData::NO_CHANGE)
-                            mc.already_bounds_changed_y[pn->udata] = MoveChangeData::CELL_MOVED_INWARDS;
+                        if (mc.already_bounds_changed_y[net] == MoveChangeData::NO_CHANGE)
+                            mc.already_bounds_changed_y[net] = MoveChangeData::CELL_MOVED_INWARDS;
                     }
                 }
             }
 
-            if (cfg.timing_driven && int(pn->users.entries()) < cfg.timingFanoutThresh) {
-                // Output ports - all arcs change timing
-                if (port.second.type == PORT_OUT) {
-                    int cc;
-                    TimingPortClass cls = ctx->getPortTimingClass(cell, port.first, cc);
-                    if (cls != TMG_IGNORE)
-                        for (auto usr : pn->users.enumerate())
-                            if (!mc.already_changed_arcs[pn->udata][usr.index.idx()]) {
-                                mc.changed_arcs.emplace_back(std::make_pair(pn->udata, usr.index));
-                                mc.already_changed_arcs[pn->udata][usr.index.idx()] = true;
-                            }
-                } else if (port.second.type == PORT_IN) {
-                    auto usr_idx = port.second.user_idx;
-                    if (!mc.already_changed_arcs[pn->udata][usr_idx.idx()]) {
-                        mc.changed_arcs.emplace_back(std::make_pair(pn->udata, usr_idx));
-                        mc.already_changed_arcs[pn->udata][usr_idx.idx()] = true;
+            if (net_timing[net]) {
+                if (pin.user == FlatPin::ALL_USERS) {
+                    // Output ports - all arcs change timing
+                    for (int j = net_user_start[net]; j < net_user_start[net + 1]; j++) {
+                        int idx = net_users[j].idx;
+                        if (!mc.already_changed_arcs[net_arc_start[net] + idx]) {
+                            mc.changed_arcs.emplace_back(net, idx);
+                            mc.already_changed_arcs[net_arc_start[net] + idx] = true;
+                        }
+                    }
+                } else if (pin.user != FlatPin::NO_USERS) {
+                    if (!mc.already_changed_arcs[net_arc_start[net] + pin.user]) {
+                        mc.changed_arcs.emplace_back(net, pin.user);
+                        mc.already_changed_arcs[net_arc_start[net] + pin.user] = true;
                     }
                 }
             }
@@ -1094,12 +1139,12 @@ class SAPlacer
     {
         for (const auto &bc : md.bounds_changed_nets_x) {
             if (md.already_bounds_changed_x[bc] == MoveChangeData::FULL_RECOMPUTE)
-                md.new_net_bounds[bc] = get_net_bounds(net_by_udata[bc]);
+                md.new_net_bounds[bc] = get_net_bounds(bc);
         }
         for (const auto &bc : md.bounds_changed_nets_y) {
             if (md.already_bounds_changed_x[bc] != MoveChangeData::FULL_RECOMPUTE &&
                 md.already_bounds_changed_y[bc] == MoveChangeData::FULL_RECOMPUTE)
-                md.new_net_bounds[bc] = get_net_bounds(net_by_udata[bc]);
+                md.new_net_bounds[bc] = get_net_bounds(bc);
         }
 
         for (const auto &bc : md.bounds_changed_nets_x)
@@ -1110,12 +1155,12 @@ class SAPlacer
 
         if (cfg.timing_driven) {
             for (const auto &tc : md.changed_arcs) {
-                double old_cost = net_arc_tcost.at(tc.first).at(tc.second.idx());
-                double new_cost =
-                        get_timing_cost(net_by_udata.at(tc.first), net_by_udata.at(tc.first)->users.at(tc.second));
-                md.new_arc_costs.emplace_back(std::make_pair(tc, new_cost));
+                int arc = net_arc_start[tc.first] + tc.second;
+                double old_cost = net_arc_tcost[arc];
+                double new_cost = get_timing_cost(tc.first, tc.second);
+                md.new_arc_costs.emplace_back(arc, new_cost);
                 md.timing_delta += (new_cost - old_cost);
-                md.already_changed_arcs[tc.first][tc.second.idx()] = false;
+                md.already_changed_arcs[arc] = false;
             }
         }
     }
@@ -1127,7 +1172,7 @@ class SAPlacer
         for (const auto &bc : md.bounds_changed_nets_y)
             net_bounds[bc] = md.new_net_bounds[bc];
         for (const auto &tc : md.new_arc_costs)
-            net_arc_tcost[tc.first.first].at(tc.first.second.idx()) = tc.second;
+            net_arc_tcost[tc.first] = tc.second;
         curr_wirelen_cost += md.wirelen_delta;
         curr_timing_cost += md.timing_delta;
     }
@@ -1135,23 +1180,33 @@ class SAPlacer
     // Simple routeability driven placement
     const int large_cell_thresh = 50;
     int total_net_share = 0;
-    std::vector<std::vector<dict<IdString, int>>> nets_by_tile;
+    // Number of pins on each net in each tile, indexed by tile_index and net udata
+    std::vector<dict<int, int>> nets_by_tile;
+    int tile_index(Loc loc) const { return loc.x * (max_y + 1) + loc.y; }
     void setup_nets_by_tile()
     {
         total_net_share = 0;
-        nets_by_tile.resize(max_x + 1, std::vector<dict<IdString, int>>(max_y + 1));
-        for (auto &cell : ctx->cells) {
-            CellInfo *ci = cell.second.get();
-            if (ci->isPseudo() || (int(ci->ports.size()) > large_cell_thresh))
-                continue;
-            Loc loc = ctx->getBelLocation(ci->bel);
-            auto &nbt = nets_by_tile.at(loc.x).at(loc.y);
-            for (const auto &port : ci->ports) {
-                if (port.second.net == nullptr)
+        nets_by_tile.clear();
+        nets_by_tile.resize((max_x + 1) * (max_y + 1));
+        for (auto ci : cell_by_udata) {
+            bool small_cell = int(ci->ports.size()) <= large_cell_thresh;
+            for (int i = cell_pin_start[ci->udata]; i < cell_pin_start[ci->udata + 1]; i++) {
+                FlatPin &pin = cell_pins[i];
+                if (pin.net == -1) {
+                    pin.share = false;
                     continue;
-                if (port.second.net->driver.cell == nullptr || ctx->getBelGlobalBuf(port.second.net->driver.cell->bel))
+                }
+                CellInfo *driver = net_by_udata[pin.net]->driver.cell;
+                pin.share = small_cell && driver != nullptr && !ctx->getBelGlobalBuf(driver->bel);
+            }
+            if (ci->isPseudo() || !small_cell)
+                continue;
+            auto &nbt = nets_by_tile.at(tile_index(ctx->getBelLocation(ci->bel)));
+            for (int i = cell_pin_start[ci->udata]; i < cell_pin_start[ci->udata + 1]; i++) {
+                const FlatPin &pin = cell_pins[i];
+                if (!pin.share)
                     continue;
-                int &s = nbt[port.second.net->name];
+                int &s = nbt[pin.net];
                 if (s > 0)
                     ++total_net_share;
                 ++s;
@@ -1161,23 +1216,20 @@ class SAPlacer
 
     int update_nets_by_tile(CellInfo *ci, Loc old_loc, Loc new_loc)
     {
-        if (int(ci->ports.size()) > large_cell_thresh)
-            return 0;
         int loss = 0, gain = 0;
-        auto &nbt_old = nets_by_tile.at(old_loc.x).at(old_loc.y);
-        auto &nbt_new = nets_by_tile.at(new_loc.x).at(new_loc.y);
+        auto &nbt_old = nets_by_tile.at(tile_index(old_loc));
+        auto &nbt_new = nets_by_tile.at(tile_index(new_loc));
 
-        for (const auto &port : ci->ports) {
-            if (port.second.net == nullptr)
-                continue;
-            if (port.second.net->driver.cell == nullptr || ctx->getBelGlobalBuf(port.second.net->driver.cell->bel))
+        for (int i = cell_pin_start[ci->udata]; i < cell_pin_start[ci->udata + 1]; i++) {
+            const FlatPin &pin = cell_pins[i];
+            if (!pin.share)
                 continue;
-            int &o = nbt_old[port.second.net->name];
+            int &o = nbt_old[pin.net];
             --o;
             NPNR_ASSERT(o >= 0);
             if (o > 0)
                 ++loss;
-            int &n = nbt_new[port.second.net->name];
+            int &n = nbt_new[pin.net];
             if (n > 0)
                 ++gain;
             ++n;
@@ -1195,8 +1247,81 @@ class SAPlacer
 
     // Map nets to their bounding box (so we can skip recompute for moves that do not exceed the bounds
     std::vector<BoundingBox> net_bounds;
-    // Map net arcs to their timing cost (criticality * delay ns)
-    std::vector<std::vector<double>> net_arc_tcost;
+    // Map net arcs to their timing cost (criticality * delay ns); the arcs of net n start at net_arc_start[n] and are
+    // indexed by user index
+    std::vector<double> net_arc_tcost;
+    // Timing weight of each arc, as used for the timing cost and indexed the same way
+    std::vector<float> net_arc_weight;
+
+    // The netlist, compiled into flat arrays so that evaluating a move only needs to touch dense memory. Cells and nets
+    // are both numbered by udata.
+    struct FlatPin
+    {
+        static const int ALL_USERS = -1, NO_USERS = -2;
+        // Net connected to the pin, or -1
+        int net = -1;
+        // Timing arcs affected when the cell moves: the user index of an input, ALL_USERS for an output that drives
+        // timing arcs, otherwise NO_USERS
+        int user = NO_USERS;
+        // If the pin counts towards the net share of its tile
+        bool share = false;
+    };
+    struct NetUser
+    {
+        int cell, idx;
+    };
+    // The pins of cell c are cell_pins[cell_pin_start[c]] to cell_pins[cell_pin_start[c + 1] - 1], in port order
+    std::vector<int> cell_pin_start;
+    std::vector<FlatPin> cell_pins;
+    // Likewise, the users of each net, and the driver cell (or -1)
+    std::vector<int> net_user_start;
+    std::vector<NetUser> net_users;
+    std::vector<int> net_driver;
+    std::vector<int> net_arc_start;
+    // If timing costs are tracked for the net, and if it is ignored for the current iteration
+    std::vector<bool> net_timing, net_ignored;
+    // Location of each cell, updated as cells are moved; x is -1 for cells that aren't placed
+    std::vector<Loc> cell_locs;
+
+    void setup_flat_netlist()
+    {
+        for (auto ci : cell_by_udata) {
+            cell_pin_start.push_back(int(cell_pins.size()));
+            for (const auto &port : ci->ports) {
+                FlatPin pin;
+                if (port.second.net != nullptr) {
+                    pin.net = port.second.net->udata;
+                    int cc;
+                    if (port.second.type == PORT_OUT && ctx->getPortTimingClass(ci, port.first, cc) != TMG_IGNORE)
+                        pin.user = FlatPin::ALL_USERS;
+                    else if (port.second.type == PORT_IN && !port.second.user_idx.empty())
+                        pin.user = port.second.user_idx.idx();
+                }
+                cell_pins.push_back(pin);
+            }
+        }
+        cell_pin_start.push_back(int(cell_pins.size()));
+        for (auto ni : net_by_udata) {
+            net_user_start.push_back(int(net_users.size()));
+            for (auto usr : ni->users.enumerate())
+                net_users.push_back(NetUser{usr.value.cell->udata, usr.index.idx()});
+            net_driver.push_back(ni->driver.cell ? ni->driver.cell->udata : -1);
+            net_arc_start.push_back(int(net_arc_tcost.size()));
+            net_arc_tcost.resize(net_arc_tcost.size() + ni->users.capacity());
+            net_timing.push_back(cfg.timing_driven && int(ni->users.entries()) < cfg.timingFanoutThresh);
+        }
+        net_user_start.push_back(int(net_users.size()));
+        net_arc_start.push_back(int(net_arc_tcost.size()));
+        net_arc_weight.resize(net_arc_tcost.size());
+        net_ignored.resize(net_by_udata.size());
+        cell_locs.resize(cell_by_udata.size());
+    }
+
+    Loc get_cell_loc(const CellInfo *ci) const
+    {
+        return (ci->isPseudo() || ci->bel != BelId()) ? ci->getLocation() : Loc();
+    }
+    void update_cell_loc(const CellInfo *ci) { cell_locs[ci->udata] = get_cell_loc(ci); }
 
     // Fast lookup for cell to clusters
     dict<ClusterId, std::vector<CellInfo *>> cluster2cell;
@@ -1218,6 +1343,8 @@ class SAPlacer
     pool<BelId> locked_bels;
     std::vector<NetInfo *> net_by_udata;
     std::vector<decltype(NetInfo::udata)> old_udata;
+    std::vector<CellInfo *> cell_by_udata;
+    std::vector<decltype(CellInfo::udata)> old_cell_udata;
     bool require_legal = true;
     const int legalise_dia = 4;
     Placer1Cfg cfg;
@@ -32,8 +32,7 @@
  */
 
 #include "placer_heap.h"
-#include <Eigen/Core>
-#include <Eigen/IterativeLinearSolvers>
+#include <array>
 #include <boost/optional.hpp>
 #include <chrono>
 #include <deque>
@@ -48,99 +47,18 @@
 #include "place_common.h"
 #include "placer1.h"
 #include "scope_lock.h"
+#include "sparse_solver.h"
 #include "timing.h"
 #include "util.h"
 
 NEXTPNR_NAMESPACE_BEGIN
 
-namespace {
-// A simple internal representation for a sparse system of equations Ax = rhs
-// This is designed to decouple the functions that build the matrix to the engine that
-// solves it, and the representation that requires
-template <typename T> struct EquationSystem
-{
-
-    EquationSystem(size_t rows, size_t cols)
-    {
-        A.resize(cols);
-        rhs.resize(rows);
-    }
-
-    // Simple sparse format, easy to convert to CCS for solver
-    std::vector<std::vector<std::pair<int, T>>> A; // col -> (row, x[row, col]) sorted by row
-    std::vector<T> rhs;                            // RHS vector
-    void reset()
-    {
-        for (auto &col : A)
-            col.clear();
-        std::fill(rhs.begin(), rhs.end(), T());
-    }
-
-    void add_coeff(int row, int col, T val)
-    {
-        auto &Ac = A.at(col);
-        // Binary search
-        int b = 0, e = int(Ac.size()) - 1;
-        while (b <= e) {
-            int i = (b + e) / 2;
-            if (Ac.at(i).first == row) {
-                Ac.at(i).second += val;
-                return;
-            }
-            if (Ac.at(i).first > row)
-                e = i - 1;
-            else
-                b = i + 1;
-        }
-        Ac.insert(Ac.begin() + b, std::make_pair(row, val));
-    }
-
-    void add_rhs(int row, T val) { rhs[row] += val; }
-
-    void solve(std::vector<T> &x, float tolerance)
-    {
-        using namespace Eigen;
-        if (x.empty())
-            return;
-        NPNR_ASSERT(x.size() == A.size());
-
-        VectorXd vx(x.size()), vb(rhs.size());
-        SparseMatrix<T> mat(A.size(), A.size());
-
-        std::vector<int> colnnz;
-        for (auto &Ac : A)
-            colnnz.push_back(int(Ac.size()));
-        mat.reserve(colnnz);
-        for (int col = 0; col < int(A.size()); col++) {
-            auto &Ac = A.at(col);
-            for (auto &el : Ac)
-                mat.insert(el.first, col) = el.second;
-        }
-
-        for (int i = 0; i < int(x.size()); i++)
-            vx[i] = x.at(i);
-        for (int i = 0; i < int(rhs.size()); i++)
-            vb[i] = rhs.at(i);
-
-        ConjugateGradient<SparseMatrix<T>, Lower | Upper> solver;
-        solver.setTolerance(tolerance);
-        VectorXd xr = solver.compute(mat).solveWithGuess(vb, vx);
-        for (int i = 0; i < int(x.size()); i++)
-            x.at(i) = xr[i];
-        // for (int i = 0; i < int(x.size()); i++)
-        //    log_info("x[%d] = %f\n", i, x.at(i));
-    }
-};
-
-} // namespace
-
 class HeAPPlacer
 {
   public:
     HeAPPlacer(Context *ctx, PlacerHeapCfg cfg)
             : ctx(ctx), cfg(cfg), fast_bels(ctx, /*check_bel_available=*/true, -1), tmg(ctx)
     {
-        Eigen::initParallel();
         tmg.setup_only = true;
         tmg.setup();
 
@@ -164,14 +82,10 @@ class HeAPPlacer
         for (int i = 0; i < 4; i++) {
             setup_solve_cells();
             auto solve_startt = std::chrono::high_resolution_clock::now();
-#ifdef NPNR_DISABLE_THREADS
-            build_solve_direction(false, -1);
+            TaskGroup solve(ctx->threadPool());
+            solve.run([&]() { build_solve_direction(false, -1); });
             build_solve_direction(true, -1);
-#else
-            boost::thread xaxis([&]() { build_solve_direction(false, -1); });
-            build_solve_direction(true, -1);
-            xaxis.join();
-#endif
+            solve.wait();
             auto solve_endt = std::chrono::high_resolution_clock::now();
             solve_time += std::chrono::duration<double>(solve_endt - solve_startt).count();
 
@@ -233,14 +147,12 @@ class HeAPPlacer
                 auto solve_startt = std::chrono::high_resolution_clock::now();
 
                 // Build the connectivity matrix and run the solver; multithreaded between x and y axes if applicable
-#ifndef NPNR_DISABLE_THREADS
                 if (solve_cells.size() >= 500) {
-                    boost::thread xaxis([&]() { build_solve_direction(false, (iter == 0) ? -1 : iter); });
+                    TaskGroup solve(ctx->threadPool());
+                    solve.run([&]() { build_solve_direction(false, (iter == 0) ? -1 : iter); });
                     build_solve_direction(true, (iter == 0) ? -1 : iter);
-                    xaxis.join();
-                } else
-#endif
-                {
+                    solve.wait();
+                } else {
                     build_solve_direction(false, (iter == 0) ? -1 : iter);
                     build_solve_direction(true, (iter == 0) ? -1 : iter);
                 }
@@ -405,6 +317,10 @@ class HeAPPlacer
 
     dict<ClusterId, std::vector<CellInfo *>> cluster2cells;
     dict<ClusterId, int> chain_size;
+    // The x and y systems for each set of buckets solved for, kept so the matrix pattern is reused between iterations.
+    // Keyed by the set itself (empty when solving for all cells), so a new set never picks up an unrelated pattern
+    dict<pool<BelBucketId>, std::array<SparseSystem, 2>> systems;
+    std::array<SparseSystem, 2> *solve_systems = nullptr;
     // Performance counting
     double solve_time = 0, cl_time = 0, sl_time = 0;
 
@@ -510,10 +426,11 @@ class HeAPPlacer
     // Build and solve in one direction
     void build_solve_direction(bool yaxis, int iter)
     {
+        SparseSystem &es = solve_systems->at(yaxis ? 1 : 0);
         for (int i = 0; i < 5; i++) {
-            EquationSystem<double> esx(solve_cells.size(), solve_cells.size());
-            build_equations(esx, yaxis, iter);
-            solve_equations(esx, yaxis);
+            build_equations(es, yaxis, iter);
+            // Later passes start from the unrounded solution of the one before
+            solve_equations(es, yaxis, i > 0);
         }
     }
 
@@ -643,6 +560,7 @@ class HeAPPlacer
     {
         int row = 0;
         solve_cells.clear();
+        solve_systems = &systems[buckets ? *buckets : pool<BelBucketId>()];
         // First clear the udata of all cells
         for (auto &cell : ctx->cells) {
             cell.second->udata = dont_solve;
@@ -689,7 +607,7 @@ class HeAPPlacer
     }
 
     // Build the system of equations for either X or Y
-    void build_equations(EquationSystem<double> &es, bool yaxis, int iter = -1)
+    void build_equations(SparseSystem &es, bool yaxis, int iter = -1)
     {
         // Return the x or y position of a cell, depending on ydir
         auto cell_pos = [&](CellInfo *cell) { return yaxis ? cell_locs.at(cell->name).y : cell_locs.at(cell->name).x; };
@@ -697,7 +615,7 @@ class HeAPPlacer
             return yaxis ? cell_locs.at(cell->name).legal_y : cell_locs.at(cell->name).legal_x;
         };
 
-        es.reset();
+        es.reset(int(solve_cells.size()));
 
         for (auto &net : ctx->nets) {
             NetInfo *ni = net.second.get();
@@ -781,16 +699,22 @@ class HeAPPlacer
                 es.add_rhs(row, weight * l_pos);
             }
         }
+        es.finalise();
     }
 
     // Build the system of equations for either X or Y
-    void solve_equations(EquationSystem<double> &es, bool yaxis)
+    void solve_equations(SparseSystem &es, bool yaxis, bool from_raw = false)
     {
-        // Return the x or y position of a cell, depending on ydir
-        auto cell_pos = [&](CellInfo *cell) { return yaxis ? cell_locs.at(cell->name).y : cell_locs.at(cell->name).x; };
+        // Return the x or y position of a cell, depending on ydir, to start the solver from
+        auto cell_pos = [&](CellInfo *cell) -> double {
+            const CellLocation &loc = cell_locs.at(cell->name);
+            if (from_raw)
+                return yaxis ? loc.rawy : loc.rawx;
+            return yaxis ? loc.y : loc.x;
+        };
         std::vector<double> vals;
         std::transform(solve_cells.begin(), solve_cells.end(), std::back_inserter(vals), cell_pos);
-        es.solve(vals, cfg.solverTolerance);
+        es.solve(vals, cfg.solverTolerance, ctx->threadPool());
         for (size_t i = 0; i < vals.size(); i++)
             if (yaxis) {
                 cell_locs.at(solve_cells.at(i)->name).rawy = vals.at(i);
@@ -831,6 +755,110 @@ class HeAPPlacer
         return hpwl;
     }
 
+    // Fast input wirelength metric for a cell placed at a given location
+    int input_length(const CellInfo *ci, int x, int y) const
+    {
+        int input_len = 0;
+        for (auto &port : ci->ports) {
+            auto &p = port.second;
+            if (p.type != PORT_IN || p.net == nullptr || p.net->driver.cell == nullptr)
+                continue;
+            CellInfo *drv = p.net->driver.cell;
+            auto drv_loc = cell_locs.find(drv->name);
+            if (drv_loc == cell_locs.end())
+                continue;
+            if (drv_loc->second.global)
+                continue;
+            input_len += std::abs(drv_loc->second.x - x) + std::abs(drv_loc->second.y - y);
+        }
+        return input_len;
+    }
+
+    // First pass of strict legalisation for cells without relative constraints. The grid is split into square
+    // regions which are processed in parallel; each cell takes the free bel with the lowest input wirelength in the
+    // nearest ring of tiles around it with any, but only looks within the region its solver location is in, so
+    // regions never compete for a bel. Nothing is bound until all regions are done, after which the chosen bels are
+    // bound serially and checked for validity like in the serial legaliser. Returns the cells left unplaced, as their
+    // region had no free bel or the bel turned out to be invalid.
+    std::vector<CellInfo *> legalise_regions_parallel(const std::vector<CellInfo *> &cells, bool require_validity)
+    {
+        const int region_size = 16;
+        int regions_x = max_x / region_size + 1, regions_y = max_y / region_size + 1;
+        struct RegionCell
+        {
+            CellInfo *cell;
+            FastBels::FastBelsData *fb;
+            BelId bel;
+        };
+        std::vector<std::vector<RegionCell>> regions(regions_x * regions_y);
+        for (auto ci : cells) {
+            FastBels::FastBelsData *fb;
+            fast_bels.getBelsForCellType(ci->type, &fb);
+            const CellLocation &loc = cell_locs.at(ci->name);
+            int rx = std::max(0, std::min(max_x, loc.x)) / region_size;
+            int ry = std::max(0, std::min(max_y, loc.y)) / region_size;
+            regions.at(ry * regions_x + rx).push_back(RegionCell{ci, fb, BelId()});
+        }
+
+        ctx->threadPool().parallel_for(0, int(regions.size()), [&](int idx) {
+            int x0 = (idx % regions_x) * region_size, y0 = (idx / regions_x) * region_size;
+            int x1 = std::min(max_x, x0 + region_size - 1), y1 = std::min(max_y, y0 + region_size - 1);
+            // Bels taken by earlier cells in this region; nothing is bound yet
+            pool<BelId> claimed;
+            for (auto &rc : regions.at(idx)) {
+                CellInfo *ci = rc.cell;
+                const CellLocation &loc = cell_locs.at(ci->name);
+                int best_inp_len = std::numeric_limits<int>::max();
+                for (int radius = 0; radius < region_size && rc.bel == BelId(); radius++) {
+                    for (int x = std::max(x0, loc.x - radius); x <= std::min(x1, loc.x + radius); x++) {
+                        if (x >= int(rc.fb->size()))
+                            break;
+                        for (int y = std::max(y0, loc.y - radius); y <= std::min(y1, loc.y + radius); y++) {
+                            if (y >= int(rc.fb->at(x).size()))
+                                break;
+                            // Tiles closer than radius were already searched
+                            if (std::abs(x - loc.x) != radius && std::abs(y - loc.y) != radius)
+                                continue;
+                            for (auto bel : rc.fb->at(x).at(y)) {
+                                if (!ci->testRegion(bel) || !ctx->checkBelAvail(bel) || claimed.count(bel))
+                                    continue;
+                                // All bels in a tile have the same input wirelength, so the first free one will do
+                                int input_len = input_length(ci, x, y);
+                                if (input_len < best_inp_len) {
+                                    best_inp_len = input_len;
+                                    rc.bel = bel;
+                                }
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (rc.bel != BelId())
+                    claimed.insert(rc.bel);
+            }
+        });
+
+        std::vector<CellInfo *> unplaced;
+        for (auto &region : regions) {
+            for (auto &rc : region) {
+                if (rc.bel == BelId()) {
+                    unplaced.push_back(rc.cell);
+                    continue;
+                }
+                ctx->bindBel(rc.bel, rc.cell, STRENGTH_WEAK);
+                if (require_validity && !ctx->isBelLocationValid(rc.bel)) {
+                    ctx->unbindBel(rc.bel);
+                    unplaced.push_back(rc.cell);
+                    continue;
+                }
+                Loc loc = ctx->getBelLocation(rc.bel);
+                cell_locs[rc.cell->name].x = loc.x;
+                cell_locs[rc.cell->name].y = loc.y;
+            }
+        }
+        return unplaced;
+    }
+
     // Strict placement legalisation, performed after the initial HeAP spreading
     void legalise_placement_strict(bool require_validity = false)
     {
@@ -846,15 +874,27 @@ class HeAPPlacer
         }
 
         // At the moment we don't follow the full HeAP algorithm using cuts for legalisation, instead using
-        // the simple greedy largest-macro-first approach.
+        // the simple greedy largest-macro-first approach. Clusters are placed first; then, once the queue is empty,
+        // the other cells are placed region by region in parallel, and any that couldn't be placed that way are
+        // queued again for the serial legaliser.
         std::priority_queue<std::pair<int, IdString>> remaining;
+        std::vector<CellInfo *> unclustered;
         for (auto cell : solve_cells) {
-            remaining.emplace(chain_size[cell->name], cell->name);
+            if (cell->cluster == ClusterId())
+                unclustered.push_back(cell);
+            else
+                remaining.emplace(chain_size[cell->name], cell->name);
         }
         int ripup_radius = 2;
         int total_iters = 0;
         int total_iters_noreset = 0;
-        while (!remaining.empty()) {
+        while (!remaining.empty() || !unclustered.empty()) {
+            if (remaining.empty()) {
+                for (auto cell : legalise_regions_parallel(unclustered, require_validity))
+                    remaining.emplace(chain_size[cell->name], cell->name);
+                unclustered.clear();
+                continue;
+            }
             auto top = remaining.top();
             remaining.pop();
 
@@ -998,21 +1038,9 @@ class HeAPPlacer
                                 ctx->unbindBel(sz);
                                 if (bound != nullptr)
                                     ctx->bindBel(sz, bound, STRENGTH_WEAK);
-                                int input_len = 0;
                                 // Compute a fast input wirelength metric at this bel; and save if better than our last
                                 // try
-                                for (auto &port : ci->ports) {
-                                    auto &p = port.second;
-                                    if (p.type != PORT_IN || p.net == nullptr || p.net->driver.cell == nullptr)
-                                        continue;
-                                    CellInfo *drv = p.net->driver.cell;
-                                    auto drv_loc = cell_locs.find(drv->name);
-                                    if (drv_loc == cell_locs.end())
-                                        continue;
-                                    if (drv_loc->second.global)
-                                        continue;
-                                    input_len += std::abs(drv_loc->second.x - nx) + std::abs(drv_loc->second.y - ny);
-                                }
+                                int input_len = input_length(ci, nx, ny);
                                 if (input_len < best_inp_len) {
                                     best_inp_len = input_len;
                                     bestBel = sz;
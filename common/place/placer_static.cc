@@ -38,15 +38,7 @@
 #include "timing.h"
 #include "util.h"
 
-#include "fftsg.h"
-
-#ifndef NPNR_DISABLE_THREADS
-#include <atomic>
-#include <condition_variable>
-#include <mutex>
-#include <thread>
-
-#endif
+#include "spectral_solver.h"
 
 NEXTPNR_NAMESPACE_BEGIN
 
@@ -67,10 +59,11 @@ struct PlacerGroup
 
     array2d<double> conc_density; // excludes fillers and dark nodes
     array2d<double> density;
-    // FFT related data (TODO: should these be per group?)
+    // FFT related data
     FFTArray density_fft;
     FFTArray electro_phi;
     FFTArray electro_fx, electro_fy;
+    SpectralSolver spectral;
 
     double init_potential = 0;
     double curr_potential = 0;
@@ -152,93 +145,6 @@ struct PlacerNet
     int hpwl() { return (b1.x - b0.x) + (b1.y - b0.y); }
 };
 
-#ifdef NPNR_DISABLE_THREADS
-struct ThreadPool
-{
-    ThreadPool(int){};
-
-    void run(int N, std::function<void(int)> func)
-    {
-        for (int i = 0; i < N; i++)
-            func(i);
-    };
-};
-#else
-struct ThreadPool
-{
-    ThreadPool(int thread_count)
-    {
-        done.resize(thread_count, false);
-        for (int i = 0; i < thread_count; i++) {
-            threads.emplace_back([this, i]() { this->worker(i); });
-        }
-    }
-    std::vector<std::thread> threads;
-    std::condition_variable cv_start, cv_done;
-    std::mutex mutex;
-
-    bool work_available = false;
-    bool shutdown = false;
-    std::vector<bool> done;
-    std::function<void(int)> work;
-    int work_count;
-
-    ~ThreadPool()
-    {
-        {
-            std::lock_guard lk(mutex);
-            shutdown = true;
-        }
-        cv_start.notify_all();
-        for (auto &t : threads)
-            t.join();
-    }
-
-    void run(int N, std::function<void(int)> func)
-    {
-        {
-            std::lock_guard lk(mutex);
-            work = func;
-            work_count = N;
-            work_available = true;
-            std::fill(done.begin(), done.end(), false);
-        }
-        cv_start.notify_all();
-        {
-            std::unique_lock lk(mutex);
-            cv_done.wait(lk, [this] { return std::all_of(done.begin(), done.end(), [](bool x) { return x; }); });
-            work_available = false;
-        }
-    }
-
-    void worker(int idx)
-    {
-        while (true) {
-            std::unique_lock lk(mutex);
-            cv_start.wait(lk, [this, idx] { return (work_available && !done.at(idx)) || shutdown; });
-            if (shutdown) {
-                lk.unlock();
-                break;
-            } else if (work_available && !done.at(idx)) {
-                int work_per_thread = (work_count + int(threads.size()) - 1) / threads.size();
-                int begin = work_per_thread * idx;
-                int end = std::min(work_count, work_per_thread * (idx + 1));
-                lk.unlock();
-
-                for (int j = begin; j < end; j++) {
-                    work(j);
-                }
-
-                lk.lock();
-                done.at(idx) = true;
-                lk.unlock();
-                cv_done.notify_one();
-            }
-        }
-    }
-};
-#endif
-
 class StaticPlacer
 {
     Context *ctx;
@@ -253,7 +159,7 @@ class StaticPlacer
 
     FastBels fast_bels;
     TimingAnalyser tmg;
-    ThreadPool pool;
+    ThreadPool &pool;
 
     int width, height;
     int iter = 0;
@@ -566,9 +472,6 @@ class StaticPlacer
     int m;
     double bin_w, bin_h;
 
-    std::vector<float> cs_table_fft;
-    std::vector<int> work_area_fft;
-
     void prepare_density_bins()
     {
         // TODO: a m x m grid follows the paper and makes the DCTs easier, but is it actually ideal for non-square
@@ -583,10 +486,8 @@ class StaticPlacer
             g.electro_phi.reset(m, m, 0);
             g.electro_fx.reset(m, m, 0);
             g.electro_fy.reset(m, m, 0);
+            g.spectral = SpectralSolver(m);
         }
-        cs_table_fft.resize(m * 3 / 2, 0);
-        work_area_fft.resize(std::round(std::sqrt(m)) + 2, 0);
-        work_area_fft.at(0) = 0;
     }
 
     template <typename TFunc> void iter_slithers(RealPair pos, StaticRect rect, TFunc func)
@@ -697,44 +598,7 @@ class StaticPlacer
             g.density_fft.at(entry.x, entry.y) = entry.value;
         if (fft_debug || dump_density)
             g.density_fft.write_csv(stringf("out_bin_density_%d_%d.csv", iter, group));
-        // Based on
-        // https://github.com/ALIGN-analoglayout/ALIGN-public/blob/master/PlaceRouteHierFlow/EA_placer/FFT/fft.cpp
-        // initial DCT for coefficients
-        ddct2d(m, m, -1, g.density_fft.data(), nullptr, work_area_fft.data(), cs_table_fft.data());
-        // postprocess coefficients
-        for (int x = 0; x < m; x++)
-            g.density_fft.at(x, 0) *= 0.5f;
-        for (int y = 0; y < m; y++)
-            g.density_fft.at(0, y) *= 0.5f;
-        for (int x = 0; x < m; x++)
-            for (int y = 0; y < m; y++)
-                g.density_fft.at(x, y) *= (4.0f / (m * m));
-        // scale inputs to IDCT for potentials and field
-        for (int x = 0; x < m; x++) {
-            float wx = pi * (x / float(m));
-            float wx2 = wx * wx;
-            for (int y = 0; y < m; y++) {
-                float wy = pi * (y / float(m));
-                float wy2 = wy * wy;
-
-                float dens = g.density_fft.at(x, y);
-                float phi = 0, ex = 0, ey = 0;
-
-                if (x != 0 || y != 0) { // avoid divide by zero...
-                    phi = dens / (wx2 + wy2);
-                    ex = phi * wx;
-                    ey = phi * wy;
-                }
-
-                g.electro_phi.at(x, y) = phi;
-                g.electro_fx.at(x, y) = ex;
-                g.electro_fy.at(x, y) = ey;
-            }
-        }
-        // IDCT for potential; 2D derivatives for field
-        ddct2d(m, m, 1, g.electro_phi.data(), nullptr, work_area_fft.data(), cs_table_fft.data());
-        ddsct2d(m, m, 1, g.electro_fx.data(), nullptr, work_area_fft.data(), cs_table_fft.data());
-        ddcst2d(m, m, 1, g.electro_fy.data(), nullptr, work_area_fft.data(), cs_table_fft.data());
+        g.spectral.solve(g.density_fft.data(), g.electro_phi.data(), g.electro_fx.data(), g.electro_fy.data(), pool);
         if (fft_debug) {
             g.electro_phi.write_csv(stringf("out_bin_phi_%d_%d.csv", iter, group));
             g.electro_fx.write_csv(stringf("out_bin_ex_%d_%d.csv", iter, group));
@@ -761,7 +625,7 @@ class StaticPlacer
     void update_nets(bool ref)
     {
         static constexpr float min_wirelen_force = -3000.f;
-        pool.run(2 * nets.size(), [&](int i) {
+        pool.parallel_for(0, 2 * int(nets.size()), [&](int i) {
             auto &net = nets.at(i / 2);
             auto axis = (i % 2) ? Axis::Y : Axis::X;
             if (net.skip)
@@ -857,7 +721,7 @@ class StaticPlacer
     void update_gradients(bool ref = true, bool set_prev = true, bool init_penalty = false)
     {
         // TODO: skip non-group cells more efficiently?
-        pool.run(groups.size(), [&](int group) {
+        pool.parallel_for(0, int(groups.size()), [&](int group) {
             compute_density(group, ref);
             run_fft(group);
         });
@@ -890,7 +754,7 @@ class StaticPlacer
             }
         }
         // Compute wirelength gradients for cells in parallel, this is a slow part
-        pool.run(gathered_wirelen_grad.size(), [&](int i) {
+        pool.parallel_for(0, int(gathered_wirelen_grad.size()), [&](int i) {
             auto &entry = gathered_wirelen_grad.at(i);
             CellInfo *ci = entry.first;
             float wl_gx = wirelen_grad(ci, Axis::X, ref);
@@ -1461,7 +1325,7 @@ class StaticPlacer
 
   public:
     StaticPlacer(Context *ctx, PlacerStaticCfg cfg)
-            : ctx(ctx), cfg(cfg), fast_bels(ctx, true, 8), tmg(ctx), pool(ctx->setting<int>("threads", 8))
+            : ctx(ctx), cfg(cfg), fast_bels(ctx, true, 8), tmg(ctx), pool(ctx->threadPool())
     {
         groups.resize(cfg.cell_groups.size());
         tmg.setup_only = true;
@@ -0,0 +1,315 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "sparse_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "nextpnr_assertions.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+void SparseSystem::reset(int n)
+{
+    if (n != this->n) {
+        // Different variables, so the old pattern is no use
+        this->n = n;
+        row_start.assign(n + 1, 0);
+        cols.clear();
+        vals.clear();
+        rhs.assign(n, 0);
+    } else {
+        std::fill(vals.begin(), vals.end(), 0);
+        std::fill(rhs.begin(), rhs.end(), 0);
+    }
+    extra.clear();
+}
+
+void SparseSystem::add_coeff(int row, int col, double val)
+{
+    auto begin = cols.begin() + row_start[row], end = cols.begin() + row_start[row + 1];
+    auto found = std::lower_bound(begin, end, col);
+    if (found != end && *found == col)
+        vals[found - cols.begin()] += val;
+    else
+        extra.push_back(Entry{row, col, val});
+}
+
+void SparseSystem::finalise()
+{
+    // Entries that have become zero are only dropped once there are a lot of them; keeping them around means the
+    // pattern settles on the union of the last few systems, and passes with slightly different connectivity don't
+    // need a new pattern every time.
+    int unused = 0;
+    for (double val : vals)
+        if (val == 0)
+            unused++;
+    bool prune = unused * 4 > int(cols.size());
+    // A few new entries are cheaper to apply separately when solving than to rebuild the pattern for (they are left
+    // out of the preconditioner, which doesn't need to be exact). Every row has a diagonal entry, so with fewer
+    // entries than rows there is no pattern yet.
+    if (extra.size() * 10 > cols.size() || prune || int(cols.size()) < n)
+        rebuild_pattern(prune);
+}
+
+void SparseSystem::rebuild_pattern(bool prune)
+{
+    // Bucket the new entries by row, then sort each (short) row by column
+    std::vector<int> extra_start(n + 1, 0);
+    for (auto &e : extra)
+        extra_start[e.row + 1]++;
+    for (int i = 0; i < n; i++)
+        extra_start[i + 1] += extra_start[i];
+    std::vector<Entry> sorted_extra(extra.size());
+    std::vector<int> next_slot(extra_start.begin(), extra_start.end() - 1);
+    for (auto &e : extra)
+        sorted_extra[next_slot[e.row]++] = e;
+    for (int i = 0; i < n; i++)
+        std::sort(sorted_extra.begin() + extra_start[i], sorted_extra.begin() + extra_start[i + 1]);
+
+    std::vector<int> new_start(n + 1, 0), new_cols;
+    std::vector<double> new_vals;
+    new_cols.reserve(cols.size() + extra.size());
+    new_vals.reserve(cols.size() + extra.size());
+    auto next_extra = sorted_extra.begin();
+    for (int i = 0; i < n; i++) {
+        new_start[i] = int(new_cols.size());
+        // Merge the existing row, the new entries for it and its diagonal, all sorted by column
+        int j = row_start[i], row_end = row_start[i + 1];
+        bool diag_done = false;
+        while (true) {
+            int col = std::numeric_limits<int>::max();
+            if (j < row_end)
+                col = cols[j];
+            if (next_extra != sorted_extra.end() && next_extra->row == i)
+                col = std::min(col, next_extra->col);
+            if (!diag_done)
+                col = std::min(col, i);
+            if (col == std::numeric_limits<int>::max())
+                break;
+            double val = 0;
+            if (j < row_end && cols[j] == col)
+                val += vals[j++];
+            while (next_extra != sorted_extra.end() && next_extra->row == i && next_extra->col == col)
+                val += (next_extra++)->val;
+            if (col == i)
+                diag_done = true;
+            else if (prune && val == 0)
+                continue;
+            new_cols.push_back(col);
+            new_vals.push_back(val);
+        }
+    }
+    new_start[n] = int(new_cols.size());
+    NPNR_ASSERT(next_extra == sorted_extra.end());
+    row_start = std::move(new_start);
+    cols = std::move(new_cols);
+    vals = std::move(new_vals);
+    extra.clear();
+
+    // The factor has the strictly lower triangular part of the diagonal block each row is in, its diagonal is kept
+    // separately
+    l_start.assign(n + 1, 0);
+    l_cols.clear();
+    l_src.clear();
+    diag_idx.resize(n);
+    l_inv_diag.resize(n);
+    for (int i = 0; i < n; i++) {
+        l_start[i] = int(l_cols.size());
+        int block_begin = (i / block_size) * block_size;
+        for (int j = row_start[i]; j < row_start[i + 1]; j++) {
+            if (cols[j] == i) {
+                diag_idx[i] = j;
+            } else if (cols[j] >= block_begin && cols[j] < i) {
+                l_cols.push_back(cols[j]);
+                l_src.push_back(j);
+            }
+        }
+    }
+    l_start[n] = int(l_cols.size());
+    l_vals.resize(l_cols.size());
+}
+
+void SparseSystem::factorise_block(int block)
+{
+    int begin = block * block_size, end = std::min(n, (block + 1) * block_size);
+    for (int i = begin; i < end; i++) {
+        double orig_diag = vals[diag_idx[i]], diag_val = orig_diag;
+        for (int k = l_start[i]; k < l_start[i + 1]; k++) {
+            // L[i][c] = (A[i][c] - sum_{j < c} L[i][j] * L[c][j]) / L[c][c]
+            int c = l_cols[k];
+            double sum = vals[l_src[k]];
+            int a = l_start[i], b = l_start[c], b_end = l_start[c + 1];
+            while (a < k && b < b_end) {
+                if (l_cols[a] == l_cols[b])
+                    sum -= l_vals[a++] * l_vals[b++];
+                else if (l_cols[a] < l_cols[b])
+                    a++;
+                else
+                    b++;
+            }
+            l_vals[k] = sum * l_inv_diag[c];
+            diag_val -= l_vals[k] * l_vals[k];
+        }
+        // Incomplete factors of a positive semi-definite matrix can break down; fall back to the (Jacobi) diagonal
+        if (diag_val <= 1e-12 * orig_diag || diag_val <= 0) {
+            diag_val = (orig_diag > 0) ? orig_diag : 1;
+            for (int k = l_start[i]; k < l_start[i + 1]; k++)
+                l_vals[k] = 0;
+        }
+        l_inv_diag[i] = 1 / std::sqrt(diag_val);
+    }
+}
+
+void SparseSystem::precondition_block(int block)
+{
+    int begin = block * block_size, end = std::min(n, (block + 1) * block_size);
+    // Forward substitution with L...
+    for (int i = begin; i < end; i++) {
+        double sum = r[i];
+        for (int k = l_start[i]; k < l_start[i + 1]; k++)
+            sum -= l_vals[k] * z[l_cols[k]];
+        z[i] = sum * l_inv_diag[i];
+    }
+    // ...then backward substitution with its transpose
+    for (int i = end - 1; i >= begin; i--) {
+        double zi = (z[i] *= l_inv_diag[i]);
+        for (int k = l_start[i]; k < l_start[i + 1]; k++)
+            z[l_cols[k]] -= l_vals[k] * zi;
+    }
+}
+
+int SparseSystem::solve(std::vector<double> &x, double tolerance, ThreadPool &pool)
+{
+    NPNR_ASSERT(int(x.size()) == n);
+    if (n == 0)
+        return 0;
+    int blocks = num_blocks();
+    r.resize(n);
+    z.resize(n);
+    p.resize(n);
+    q.resize(n);
+    // Per-block partial sums are added up in order, so that results don't depend on scheduling
+    std::vector<double> partial_a(blocks), partial_b(blocks);
+    auto total = [](const std::vector<double> &partial) {
+        double sum = 0;
+        for (double v : partial)
+            sum += v;
+        return sum;
+    };
+    auto block_range = [&](int block) {
+        return std::make_pair(block * block_size, std::min(n, (block + 1) * block_size));
+    };
+    auto mul_row = [&](const std::vector<double> &v, int i) {
+        double sum = 0;
+        for (int j = row_start[i]; j < row_start[i + 1]; j++)
+            sum += vals[j] * v[cols[j]];
+        return sum;
+    };
+
+    // Factorise, and compute the initial residual r = rhs - Ax
+    pool.parallel_for(0, blocks, [&](int block) {
+        factorise_block(block);
+        auto range = block_range(block);
+        double rhs_sq = 0, r_sq = 0;
+        for (int i = range.first; i < range.second; i++) {
+            r[i] = rhs[i] - mul_row(x, i);
+            rhs_sq += rhs[i] * rhs[i];
+            r_sq += r[i] * r[i];
+        }
+        partial_a[block] = rhs_sq;
+        partial_b[block] = r_sq;
+    });
+    double rhs_sq = total(partial_a);
+    if (rhs_sq == 0) {
+        std::fill(x.begin(), x.end(), 0);
+        return 0;
+    }
+    double threshold = tolerance * tolerance * rhs_sq;
+    if (extra.empty() && total(partial_b) < threshold)
+        return 0;
+    for (auto &e : extra)
+        r[e.row] -= e.val * x[e.col];
+
+    pool.parallel_for(0, blocks, [&](int block) {
+        precondition_block(block);
+        auto range = block_range(block);
+        double r_sq = 0, rz = 0;
+        for (int i = range.first; i < range.second; i++) {
+            p[i] = z[i];
+            r_sq += r[i] * r[i];
+            rz += r[i] * z[i];
+        }
+        partial_a[block] = r_sq;
+        partial_b[block] = rz;
+    });
+    if (total(partial_a) < threshold)
+        return 0;
+    double rz = total(partial_b);
+
+    int max_iter = 2 * n, iter = 0;
+    while (iter < max_iter) {
+        ++iter;
+        pool.parallel_for(0, blocks, [&](int block) {
+            auto range = block_range(block);
+            double pq = 0;
+            for (int i = range.first; i < range.second; i++) {
+                q[i] = mul_row(p, i);
+                pq += p[i] * q[i];
+            }
+            partial_a[block] = pq;
+        });
+        double pq = total(partial_a);
+        for (auto &e : extra) {
+            q[e.row] += e.val * p[e.col];
+            pq += p[e.row] * e.val * p[e.col];
+        }
+        if (pq <= 0)
+            break;
+        double alpha = rz / pq;
+        pool.parallel_for(0, blocks, [&](int block) {
+            auto range = block_range(block);
+            double r_sq = 0, rz = 0;
+            for (int i = range.first; i < range.second; i++) {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * q[i];
+                r_sq += r[i] * r[i];
+            }
+            precondition_block(block);
+            for (int i = range.first; i < range.second; i++)
+                rz += r[i] * z[i];
+            partial_a[block] = r_sq;
+            partial_b[block] = rz;
+        });
+        if (total(partial_a) < threshold)
+            break;
+        double rz_next = total(partial_b);
+        double beta = rz_next / rz;
+        rz = rz_next;
+        pool.parallel_for(0, blocks, [&](int block) {
+            auto range = block_range(block);
+            for (int i = range.first; i < range.second; i++)
+                p[i] = z[i] + beta * p[i];
+        });
+    }
+    return iter;
+}
+
+NEXTPNR_NAMESPACE_END
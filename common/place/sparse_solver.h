@@ -0,0 +1,95 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef SPARSE_SOLVER_H
+#define SPARSE_SOLVER_H
+
+#include <vector>
+#include "nextpnr_namespaces.h"
+#include "thread_pool.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// A symmetric positive (semi-)definite sparse system Ax = rhs, as built by the analytic placers, together with a
+// preconditioned conjugate gradient solver for it.
+//
+// The matrix is kept in compressed sparse row form between uses. Re-assembling a system of the same size only resets
+// the values, so when most of the connectivity is the same as last time (as between the passes of one placer
+// iteration) no memory is allocated and coefficients are added in place. Entries not yet in the pattern are collected
+// separately; finalise() merges them in once there are enough of them to be worth a new pattern (until then they are
+// applied on their own when solving), and drops entries that are no longer used once there are many.
+//
+// Solving uses a block incomplete Cholesky (IC(0)) preconditioner; blocks are a fixed number of rows, independent of
+// the number of threads, so the result is the same however many threads are used to compute it.
+class SparseSystem
+{
+  public:
+    // Start assembling a new system with n variables, all coefficients and the rhs are zero
+    void reset(int n);
+
+    void add_coeff(int row, int col, double val);
+    void add_rhs(int row, double val) { rhs[row] += val; }
+
+    // Update the pattern if needed, must be called after assembly and before solve
+    void finalise();
+
+    // Solve the system using x as the initial guess, until the residual relative to the rhs is below tolerance.
+    // Vector operations, the matrix product and the preconditioner are split over the pool. Returns the number of
+    // iterations used.
+    int solve(std::vector<double> &x, double tolerance, ThreadPool &pool);
+
+    int size() const { return n; }
+    int nonzeros() const { return int(cols.size()); }
+
+  private:
+    int n = 0;
+    // CSR matrix; columns are sorted within each row and every row has a diagonal entry
+    std::vector<int> row_start, cols;
+    std::vector<double> vals;
+    std::vector<double> rhs;
+
+    struct Entry
+    {
+        int row, col;
+        double val;
+        bool operator<(const Entry &other) const { return (row < other.row) || (row == other.row && col < other.col); }
+    };
+    std::vector<Entry> extra;
+
+    // Incomplete Cholesky factor of each diagonal block: the entries below the diagonal in CSR form, with the index
+    // of the matrix entry each comes from, and the inverse of the diagonal
+    std::vector<int> l_start, l_cols, l_src;
+    std::vector<double> l_vals, l_inv_diag;
+    // Index of the diagonal entry of each row of the matrix
+    std::vector<int> diag_idx;
+
+    // CG work vectors, kept between solves
+    std::vector<double> r, z, p, q;
+
+    static const int block_size = 4096;
+    int num_blocks() const { return (n + block_size - 1) / block_size; }
+
+    void rebuild_pattern(bool prune);
+    void factorise_block(int block);
+    void precondition_block(int block);
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
@@ -0,0 +1,337 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "spectral_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "nextpnr_assertions.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+namespace {
+// Number of 1D transforms done at once, one per SIMD lane. Wider vectors than the target has are split up by the
+// compiler, which is much slower than using the narrower ones directly
+#if defined(__AVX__)
+const int lane_count = 8;
+#else
+const int lane_count = 4;
+#endif
+// Columns are copied out this many at a time (one cache line of each row), as with a large grid every row is on a
+// different page
+const int column_block = 16;
+// Rows per task for the scaling in solve
+const int row_grain = 8;
+
+#if defined(__GNUC__)
+// GCC and clang vector extensions, which are lowered to whatever SSE/AVX/NEON the target has
+typedef float Lanes __attribute__((vector_size(lane_count * sizeof(float))));
+#else
+struct Lanes
+{
+    float v[lane_count];
+    float &operator[](int i) { return v[i]; }
+    float operator[](int i) const { return v[i]; }
+};
+inline Lanes operator+(const Lanes &a, const Lanes &b)
+{
+    Lanes r;
+    for (int i = 0; i < lane_count; i++)
+        r.v[i] = a.v[i] + b.v[i];
+    return r;
+}
+inline Lanes operator-(const Lanes &a, const Lanes &b)
+{
+    Lanes r;
+    for (int i = 0; i < lane_count; i++)
+        r.v[i] = a.v[i] - b.v[i];
+    return r;
+}
+inline Lanes operator-(const Lanes &a)
+{
+    Lanes r;
+    for (int i = 0; i < lane_count; i++)
+        r.v[i] = -a.v[i];
+    return r;
+}
+inline Lanes operator*(float a, const Lanes &b)
+{
+    Lanes r;
+    for (int i = 0; i < lane_count; i++)
+        r.v[i] = a * b.v[i];
+    return r;
+}
+#endif
+} // namespace
+
+// Batches of 1D transforms of length m: run() transforms lane i of x[0..m-1] for each i. There is space for count
+// batches of data, select() picks the one x points to
+struct SpectralSolver::Batch
+{
+    const SpectralSolver &s;
+    int m, n;
+    // Data, and the real and imaginary parts of the complex FFT of length n = m / 2
+    Lanes *data, *x, *re, *im;
+
+    Batch(const SpectralSolver &s, int count) : s(s), m(s.m), n(s.m / 2)
+    {
+        // Scratch space is per thread rather than per solver, as every solver splits its work over all threads
+        thread_local std::vector<Lanes> scratch;
+        scratch.resize((count + 1) * m);
+        data = x = scratch.data();
+        re = data + count * m;
+        im = re + n;
+    }
+
+    void select(int i) { x = data + i * m; }
+
+    // In-place radix-4 FFT of (re, im), without scaling
+    void fft(bool inverse)
+    {
+        for (int i = 0; i < n; i++) {
+            int j = s.bitrev[i];
+            if (i < j) {
+                std::swap(re[i], re[j]);
+                std::swap(im[i], im[j]);
+            }
+        }
+        float sign = inverse ? 1.0f : -1.0f;
+        int h = 1;
+        // The stages are done two at a time, so with an odd number of them do the first one (without twiddles) alone
+        if (n & 0xAAAAAAAA) {
+            for (int i = 0; i < n; i += 2) {
+                Lanes tr = re[i + 1], ti = im[i + 1];
+                re[i + 1] = re[i] - tr;
+                im[i + 1] = im[i] - ti;
+                re[i] = re[i] + tr;
+                im[i] = im[i] + ti;
+            }
+            h = 2;
+        }
+        for (; h < n; h *= 4) {
+            // Twiddle factors t of the stage with blocks of size 2h, and u and v = u * -+i of the next one
+            const float *t_cos = &s.fft_cos[h - 1], *t_sin = &s.fft_sin[h - 1];
+            const float *u_cos = &s.fft_cos[2 * h - 1], *u_sin = &s.fft_sin[2 * h - 1];
+            for (int i = 0; i < n; i += 4 * h) {
+                for (int k = 0; k < h; k++) {
+                    float tr = t_cos[k], ti = sign * t_sin[k];
+                    float ur = u_cos[k], ui = sign * u_sin[k];
+                    float vr = -u_sin[k], vi = sign * u_cos[k];
+                    int a0 = i + k, a1 = a0 + h, a2 = a1 + h, a3 = a2 + h;
+                    Lanes pr = tr * re[a1] - ti * im[a1], pi = tr * im[a1] + ti * re[a1];
+                    Lanes qr = tr * re[a3] - ti * im[a3], qi = tr * im[a3] + ti * re[a3];
+                    Lanes b0r = re[a0] + pr, b0i = im[a0] + pi, b1r = re[a0] - pr, b1i = im[a0] - pi;
+                    Lanes b2r = re[a2] + qr, b2i = im[a2] + qi, b3r = re[a2] - qr, b3i = im[a2] - qi;
+                    Lanes cr = ur * b2r - ui * b2i, ci = ur * b2i + ui * b2r;
+                    Lanes dr = vr * b3r - vi * b3i, di = vr * b3i + vi * b3r;
+                    re[a0] = b0r + cr;
+                    im[a0] = b0i + ci;
+                    re[a2] = b0r - cr;
+                    im[a2] = b0i - ci;
+                    re[a1] = b1r + dr;
+                    im[a1] = b1i + di;
+                    re[a3] = b1r - dr;
+                    im[a3] = b1i - di;
+                }
+            }
+        }
+    }
+
+    // C[k] = sum_j x[j] * cos(pi * (j + 1/2) * k / m): the real FFT of x[0], x[2], ..., x[3], x[1], then a twiddle
+    void dct2()
+    {
+        for (int j = 0; j < n; j++) {
+            re[j] = x[(2 * j < n) ? (4 * j) : (2 * m - 4 * j - 1)];
+            im[j] = x[(2 * j + 1 < n) ? (4 * j + 2) : (2 * m - 4 * j - 3)];
+        }
+        fft(false);
+        for (int k = 0; k <= n; k++) {
+            int a = (k == n) ? 0 : k, b = (k == 0) ? 0 : (n - k);
+            // Split the real FFT out of the complex one
+            Lanes even_r = 0.5f * (re[a] + re[b]), even_i = 0.5f * (im[a] - im[b]);
+            Lanes odd_r = 0.5f * (im[a] + im[b]), odd_i = 0.5f * (re[b] - re[a]);
+            float c1 = s.rfft_cos[k], s1 = s.rfft_sin[k];
+            Lanes vr = even_r + c1 * odd_r + s1 * odd_i, vi = even_i + c1 * odd_i - s1 * odd_r;
+            float c2 = s.dct_cos[k], s2 = s.dct_sin[k];
+            x[k] = c2 * vr + s2 * vi;
+            if (k > 0 && k < n)
+                x[m - k] = -(c2 * vi - s2 * vr);
+        }
+    }
+
+    // C[k] = sum_j x[j] * cos(pi * j * (k + 1/2) / m), the transpose of dct2
+    void dct3()
+    {
+        for (int k = 0; k < n; k++) {
+            // V[k] = e^(i pi k / 2m) (x[k] - i x[m - k]), with V[0] = 2 x[0]; and V[n - k] conjugated
+            Lanes pr, pi, qr, qi;
+            if (k == 0) {
+                pr = 2.0f * x[0];
+                pi = Lanes{};
+            } else {
+                pr = s.dct_cos[k] * x[k] + s.dct_sin[k] * x[m - k];
+                pi = s.dct_sin[k] * x[k] - s.dct_cos[k] * x[m - k];
+            }
+            int c = n - k;
+            qr = s.dct_cos[c] * x[c] + s.dct_sin[c] * x[m - c];
+            qi = -(s.dct_sin[c] * x[c] - s.dct_cos[c] * x[m - c]);
+            Lanes sr = pr + qr, si = pi + qi, dr = pr - qr, di = pi - qi;
+            float c1 = s.rfft_cos[k], s1 = s.rfft_sin[k];
+            re[k] = 0.5f * (sr - c1 * di - s1 * dr);
+            im[k] = 0.5f * (si + c1 * dr - s1 * di);
+        }
+        fft(true);
+        for (int j = 0; j < n; j++) {
+            x[(2 * j < n) ? (4 * j) : (2 * m - 4 * j - 1)] = re[j];
+            x[(2 * j + 1 < n) ? (4 * j + 2) : (2 * m - 4 * j - 3)] = im[j];
+        }
+    }
+
+    // The DSTs are DCTs of the input with its order or sign of every other element changed, see the oourafft docs
+    // for which element holds what
+    void dst2()
+    {
+        for (int j = 1; j < m; j += 2)
+            x[j] = -x[j];
+        dct2();
+        std::reverse(x + 1, x + m);
+    }
+
+    void dst3()
+    {
+        std::reverse(x + 1, x + m);
+        dct3();
+        for (int j = 1; j < m; j += 2)
+            x[j] = -x[j];
+    }
+
+    void run(bool sin, int isgn)
+    {
+        if (sin)
+            (isgn < 0) ? dst2() : dst3();
+        else
+            (isgn < 0) ? dct2() : dct3();
+    }
+};
+
+SpectralSolver::SpectralSolver(int m) : m(m)
+{
+    NPNR_ASSERT(m >= 0 && (m & (m - 1)) == 0);
+    if (m < 2)
+        return;
+    const double pi = 3.14159265358979323846;
+    int n = m / 2, bits = 0;
+    while ((1 << bits) < n)
+        ++bits;
+    bitrev.resize(n);
+    for (int i = 0; i < n; i++) {
+        int r = 0;
+        for (int b = 0; b < bits; b++)
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        bitrev[i] = r;
+    }
+    for (int h = 1; h < n; h *= 2)
+        for (int k = 0; k < h; k++) {
+            fft_cos.push_back(float(std::cos(pi * k / h)));
+            fft_sin.push_back(float(std::sin(pi * k / h)));
+        }
+    for (int k = 0; k <= n; k++) {
+        rfft_cos.push_back(float(std::cos(2 * pi * k / m)));
+        rfft_sin.push_back(float(std::sin(2 * pi * k / m)));
+        dct_cos.push_back(float(std::cos(pi * k / (2 * m))));
+        dct_sin.push_back(float(std::sin(pi * k / (2 * m))));
+    }
+}
+
+void SpectralSolver::transform(float **a, bool sin_x, bool sin_y, int isgn, ThreadPool &pool) const
+{
+    if (m < 2)
+        return;
+    int lanes = std::min(lane_count, m);
+    // Along the second index: transpose a block of rows so that each is in one lane
+    pool.parallel_for(0, m / lanes, [&](int b) {
+        Batch batch(*this, 1);
+        int x0 = b * lanes;
+        for (int y = 0; y < m; y++)
+            for (int i = 0; i < lanes; i++)
+                batch.x[y][i] = a[x0 + i][y];
+        batch.run(sin_y, isgn);
+        for (int y = 0; y < m; y++)
+            for (int i = 0; i < lanes; i++)
+                a[x0 + i][y] = batch.x[y][i];
+    });
+    // Along the first index: a block of columns is already in lanes, copy out several of them at once
+    int block = std::min(column_block, m), count = block / lanes;
+    pool.parallel_for(0, m / block, [&](int b) {
+        Batch batch(*this, count);
+        int y0 = b * block;
+        for (int x = 0; x < m; x++)
+            for (int i = 0; i < count; i++)
+                std::memcpy(&batch.data[i * m + x], &a[x][y0 + i * lanes], lanes * sizeof(float));
+        for (int i = 0; i < count; i++) {
+            batch.select(i);
+            batch.run(sin_x, isgn);
+        }
+        for (int x = 0; x < m; x++)
+            for (int i = 0; i < count; i++)
+                std::memcpy(&a[x][y0 + i * lanes], &batch.data[i * m + x], lanes * sizeof(float));
+    });
+}
+
+void SpectralSolver::solve(float **density, float **phi, float **field_x, float **field_y, ThreadPool &pool) const
+{
+    // Based on
+    // https://github.com/ALIGN-analoglayout/ALIGN-public/blob/master/PlaceRouteHierFlow/EA_placer/FFT/fft.cpp
+    const float pi = 3.141592653589793f;
+    // initial DCT for coefficients
+    dct2d(density, -1, pool);
+    // postprocess coefficients, then scale inputs to IDCT for potentials and field
+    pool.parallel_for(
+            0, m,
+            [&](int x) {
+                float scale = 4.0f / (float(m) * float(m));
+                float wx = pi * (x / float(m));
+                float wx2 = wx * wx;
+                float *dens = density[x];
+                dens[0] *= 0.5f;
+                for (int y = 0; y < m; y++) {
+                    if (x == 0)
+                        dens[y] *= 0.5f;
+                    dens[y] *= scale;
+                }
+                for (int y = 0; y < m; y++) {
+                    float wy = pi * (y / float(m));
+                    float wy2 = wy * wy;
+                    float p = 0;
+                    if (x != 0 || y != 0) // avoid divide by zero...
+                        p = dens[y] / (wx2 + wy2);
+                    phi[x][y] = p;
+                    field_x[x][y] = p * wx;
+                    field_y[x][y] = p * wy;
+                }
+            },
+            row_grain);
+    // IDCT for potential; 2D derivatives for field
+    dct2d(phi, 1, pool);
+    dsct2d(field_x, 1, pool);
+    dcst2d(field_y, 1, pool);
+}
+
+NEXTPNR_NAMESPACE_END
@@ -0,0 +1,70 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef SPECTRAL_SOLVER_H
+#define SPECTRAL_SOLVER_H
+
+#include <vector>
+#include "nextpnr_namespaces.h"
+#include "thread_pool.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+// Spectral solution of the electrostatic system used by the static placer: from the bin density of a cell group,
+// computes the potential and the field in both directions using 2D DCT/DST (following ePlace/RePlAce).
+//
+// Arrays are m x m, indexed as a[x][y]. The 2D transforms are done as 1D transforms of every row and then of every
+// column, several at a time: each SIMD lane (four with SSE or NEON, eight with AVX) holds one of them, so that every
+// butterfly works on several rows or columns at once. A block of columns is already laid out that way in memory, rows
+// are transposed in blocks. The DCTs and DSTs are computed from a complex FFT of length m / 2 (following Makhoul). The
+// tables are set up when the solver is created and only read afterwards, so each cell group has its own solver and
+// groups can be solved at the same time.
+class SpectralSolver
+{
+  public:
+    // m must be a power of two
+    explicit SpectralSolver(int m = 0);
+
+    int size() const { return m; }
+
+    // Computes the potential and field for the given density; density is overwritten with its DCT coefficients
+    void solve(float **density, float **phi, float **field_x, float **field_y, ThreadPool &pool) const;
+
+    // The same as oourafft's ddct2d, ddsct2d and ddcst2d (with n1 = n2 = m) respectively
+    void dct2d(float **a, int isgn, ThreadPool &pool) const { transform(a, false, false, isgn, pool); }
+    void dsct2d(float **a, int isgn, ThreadPool &pool) const { transform(a, true, false, isgn, pool); }
+    void dcst2d(float **a, int isgn, ThreadPool &pool) const { transform(a, false, true, isgn, pool); }
+
+  private:
+    int m;
+    // Bit reversal permutation and twiddle factors (for each stage in turn) of the complex FFT of length m / 2
+    std::vector<int> bitrev;
+    std::vector<float> fft_cos, fft_sin;
+    // Twiddle factors that turn the complex FFT into a real FFT of length m, and that into a DCT
+    std::vector<float> rfft_cos, rfft_sin, dct_cos, dct_sin;
+
+    struct Batch;
+
+    // sin_x/sin_y select a DST rather than a DCT along the first/second index
+    void transform(float **a, bool sin_x, bool sin_y, int isgn, ThreadPool &pool) const;
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
@@ -30,6 +30,9 @@
 
 #include "timing_opt.h"
 #include <boost/range/adaptor/reversed.hpp>
+#include <chrono>
+#include <deque>
+#include <iterator>
 #include <queue>
 #include "nextpnr.h"
 #include "timing.h"
@@ -48,21 +51,78 @@ class TimingOptimiser
         if (ctx->verbose)
             timing_analysis(ctx, false, true, false, false);
         tmg.setup();
+        auto opt_start = std::chrono::high_resolution_clock::now();
+        float initial_slack = 0;
         for (int i = 0; i < 30; i++) {
             log_info("   Iteration %d...\n", i);
             tmg.run();
+            if (i == 0)
+                initial_slack = worst_slack();
             setup_delay_limits();
             auto crit_paths = find_crit_paths(0.98, 50000);
-            for (auto &path : crit_paths)
-                optimise_path(path);
+            optimise_paths(crit_paths);
             if (ctx->verbose)
                 timing_analysis(ctx, false, true, false, false);
         }
+        tmg.run();
+        auto opt_end = std::chrono::high_resolution_clock::now();
+        float opt_time = std::chrono::duration<float>(opt_end - opt_start).count();
+        log_info("Timing optimisation time %.02fs (%.0f paths/s, %d of %d paths improved).\n", opt_time,
+                 total_paths / std::max(opt_time, 1e-3f), total_improved, total_paths);
+        log_info("Worst slack %.02f ns -> %.02f ns.\n", ctx->getDelayNS(initial_slack), ctx->getDelayNS(worst_slack()));
         ctx->unlock();
         return true;
     }
 
   private:
+    // Paths are optimised in batches of at most this many; the batches don't depend on the number of threads, so
+    // neither does the result
+    static const int batch_size = 64;
+
+    // State for optimising one critical path. The paths in a batch have disjoint footprints (the tiles whose bels they
+    // may bind or check, and the tiles of the cells whose delays they look at), so each can be worked on by a
+    // different thread
+    struct PathState
+    {
+        std::vector<PortRef *> *path = nullptr;
+        // Moveable cells on the path, in path order
+        std::vector<IdString> path_cells;
+        // Current candidate Bels for cells (linked in both directions)
+        dict<IdString, pool<BelId>> cell_neighbour_bels;
+        dict<BelId, pool<IdString>> bel_candidate_cells;
+        DeterministicRNG rng;
+        // Batch the neighbours and footprint were found in, -1 if not yet
+        int found_batch = -1;
+        std::vector<int> touched_tiles, observed_tiles;
+        // If all the bels touched can be bound without holding the Arch lock (see isBelBindingPartitionSafe)
+        bool partition_safe = true;
+        // Placement with the lowest path delay, empty if no legal one was found
+        std::vector<std::pair<IdString, BelId>> solution;
+        delay_t original_delay = 0, solution_delay = 0;
+    };
+
+    int total_paths = 0, total_improved = 0;
+    int batch_count = 0;
+    // Per tile: the last batch that touched or observed it, and the last batch that changed a placement in it
+    std::vector<int> tile_touched, tile_observed, tile_changed;
+
+    // Worst setup slack over all constrained arcs, 0 if there are none
+    float worst_slack()
+    {
+        const float unconstrained = float(std::numeric_limits<delay_t>::max());
+        float worst = unconstrained;
+        for (auto &net : ctx->nets) {
+            NetInfo *ni = net.second.get();
+            if (ni->driver.cell == nullptr)
+                continue;
+            for (auto &usr : ni->users)
+                worst = std::min(worst, tmg.get_setup_slack(CellPortKey(usr)));
+        }
+        return worst >= unconstrained ? 0 : worst;
+    }
+
+    int tile_index(Loc loc) const { return loc.y * ctx->getGridDimX() + loc.x; }
+
     void setup_delay_limits()
     {
         max_net_delay.clear();
@@ -159,12 +219,12 @@ class TimingOptimiser
         return true;
     }
 
-    int find_neighbours(CellInfo *cell, IdString prev_cell, int d, bool allow_swap)
+    int find_neighbours(PathState &ps, CellInfo *cell, IdString prev_cell, int d, bool allow_swap)
     {
         BelId curr = cell->bel;
         Loc curr_loc = ctx->getBelLocation(curr);
         int found_count = 0;
-        cell_neighbour_bels[cell->name] = pool<BelId>{};
+        ps.cell_neighbour_bels[cell->name] = pool<BelId>{};
         for (int dy = -d; dy <= d; dy++) {
             for (int dx = -d; dx <= d; dx++) {
                 // Go through all the Bels at this location
@@ -188,21 +248,21 @@ class TimingOptimiser
                 while (!free_bels_at_loc.empty() || !bound_bels_at_loc.empty()) {
                     BelId try_bel;
                     if (!free_bels_at_loc.empty()) {
-                        int try_idx = ctx->rng(int(free_bels_at_loc.size()));
+                        int try_idx = ps.rng.rng(int(free_bels_at_loc.size()));
                         try_bel = free_bels_at_loc.at(try_idx);
                         free_bels_at_loc.erase(free_bels_at_loc.begin() + try_idx);
                     } else {
-                        int try_idx = ctx->rng(int(bound_bels_at_loc.size()));
+                        int try_idx = ps.rng.rng(int(bound_bels_at_loc.size()));
                         try_bel = bound_bels_at_loc.at(try_idx);
                         bound_bels_at_loc.erase(bound_bels_at_loc.begin() + try_idx);
                     }
-                    if (bel_candidate_cells.count(try_bel) && !allow_swap) {
+                    if (ps.bel_candidate_cells.count(try_bel) && !allow_swap) {
                         // Overlap is only allowed if it is with the previous cell (this is handled by removing those
                         // edges in the graph), or if allow_swap is true to deal with cases where overlap means few
                         // neighbours are identified
-                        if (bel_candidate_cells.at(try_bel).size() > 1 ||
-                            (bel_candidate_cells.at(try_bel).size() == 1 &&
-                             *(bel_candidate_cells.at(try_bel).begin()) != prev_cell))
+                        if (ps.bel_candidate_cells.at(try_bel).size() > 1 ||
+                            (ps.bel_candidate_cells.at(try_bel).size() == 1 &&
+                             *(ps.bel_candidate_cells.at(try_bel).begin()) != prev_cell))
                             continue;
                     }
                     // TODO: what else to check here?
@@ -211,18 +271,18 @@ class TimingOptimiser
                 }
 
                 if (candidate != BelId()) {
-                    cell_neighbour_bels[cell->name].insert(candidate);
-                    bel_candidate_cells[candidate].insert(cell->name);
+                    ps.cell_neighbour_bels[cell->name].insert(candidate);
+                    ps.bel_candidate_cells[candidate].insert(cell->name);
                     // Work out if we need to delete any overlap
                     std::vector<IdString> overlap;
-                    for (auto other : bel_candidate_cells[candidate])
+                    for (auto other : ps.bel_candidate_cells[candidate])
                         if (other != cell->name && other != prev_cell)
                             overlap.push_back(other);
                     if (overlap.size() > 0)
                         NPNR_ASSERT(allow_swap);
                     for (auto ov : overlap) {
-                        bel_candidate_cells[candidate].erase(ov);
-                        cell_neighbour_bels[ov].erase(candidate);
+                        ps.bel_candidate_cells[candidate].erase(ov);
+                        ps.cell_neighbour_bels[ov].erase(candidate);
                     }
                 }
             }
@@ -351,11 +411,105 @@ class TimingOptimiser
         return crit_paths;
     }
 
-    void optimise_path(std::vector<PortRef *> &path)
+    void optimise_paths(std::vector<std::vector<PortRef *>> &paths)
+    {
+        int grid_size = ctx->getGridDimX() * ctx->getGridDimY();
+        if (int(tile_touched.size()) != grid_size) {
+            tile_touched.assign(grid_size, -1);
+            tile_observed.assign(grid_size, -1);
+            tile_changed.assign(grid_size, -1);
+        }
+
+        std::deque<PathState> pending;
+        for (auto &path : paths) {
+            PathState ps;
+            ps.path = &path;
+            if (find_path_cells(ps))
+                pending.push_back(std::move(ps));
+        }
+
+        std::vector<PathState *> to_find, batch;
+        std::vector<PathState> deferred;
+        std::vector<bool> in_batch;
+        while (!pending.empty()) {
+            int batch_id = batch_count++;
+            int n = std::min<int>(batch_size, pending.size());
+            // Neighbours are found again if a path was deferred, and a placement in its footprint has changed since
+            to_find.clear();
+            for (int i = 0; i < n; i++) {
+                PathState &ps = pending.at(i);
+                bool stale = (ps.found_batch == -1);
+                for (int tile : ps.touched_tiles)
+                    stale |= (tile_changed.at(tile) >= ps.found_batch);
+                for (int tile : ps.observed_tiles)
+                    stale |= (tile_changed.at(tile) >= ps.found_batch);
+                if (!stale)
+                    continue;
+                ps.rng.rngseed(ctx->rng64());
+                to_find.push_back(&ps);
+            }
+            // Nothing is bound while neighbours are found, so every path can be looked at
+            ctx->threadPool().parallel_for(0, int(to_find.size()), [&](int i) {
+                find_path_neighbours(*to_find.at(i));
+                to_find.at(i)->found_batch = batch_id;
+            });
+
+            // Take paths in order as long as their footprint doesn't overlap one already in the batch
+            batch.clear();
+            in_batch.assign(n, false);
+            for (int i = 0; i < n; i++) {
+                PathState &ps = pending.at(i);
+                bool conflict = false;
+                for (int tile : ps.touched_tiles)
+                    conflict |= (tile_touched.at(tile) == batch_id || tile_observed.at(tile) == batch_id);
+                for (int tile : ps.observed_tiles)
+                    conflict |= (tile_touched.at(tile) == batch_id);
+                if (conflict)
+                    continue;
+                for (int tile : ps.touched_tiles)
+                    tile_touched.at(tile) = batch_id;
+                for (int tile : ps.observed_tiles)
+                    tile_observed.at(tile) = batch_id;
+                batch.push_back(&ps);
+                in_batch.at(i) = true;
+            }
+
+            // Bels are bound from all threads at once, so refresh the UI as a whole afterwards
+            ctx->belUiReloadSuspended = true;
+            ctx->threadPool().parallel_for(0, int(batch.size()), [&](int i) {
+                if (batch.at(i)->partition_safe)
+                    solve_path(*batch.at(i));
+            });
+            ctx->belUiReloadSuspended = false;
+            ctx->refreshUi();
+            for (auto ps : batch)
+                if (!ps->partition_safe)
+                    solve_path(*ps);
+
+            // Footprints are disjoint, so solutions can be committed together
+            for (auto ps : batch) {
+                if (commit_path(*ps))
+                    for (int tile : ps->touched_tiles)
+                        tile_changed.at(tile) = batch_id;
+                ++total_paths;
+            }
+
+            // Paths that were left out stay at the front of the queue, in order
+            deferred.clear();
+            for (int i = 0; i < n; i++)
+                if (!in_batch.at(i))
+                    deferred.push_back(std::move(pending.at(i)));
+            pending.erase(pending.begin(), pending.begin() + n);
+            pending.insert(pending.begin(), std::make_move_iterator(deferred.begin()),
+                           std::make_move_iterator(deferred.end()));
+            ctx->yield();
+        }
+    }
+
+    // Finds the moveable cells on the path; returns false if there are too few of them to be worth optimising
+    bool find_path_cells(PathState &ps)
     {
-        path_cells.clear();
-        cell_neighbour_bels.clear();
-        bel_candidate_cells.clear();
+        auto &path = *ps.path;
         if (ctx->debug)
             log_info("Optimising the following path: \n");
 
@@ -365,7 +519,7 @@ class TimingOptimiser
             auto front_cell = front_net->driver.cell;
             if (front_cell->belStrength <= STRENGTH_WEAK && cfg.cellTypes.count(front_cell->type) &&
                 front_cell->cluster == ClusterId()) {
-                path_cells.push_back(front_cell->name);
+                ps.path_cells.push_back(front_cell->name);
             }
         }
 
@@ -375,24 +529,93 @@ class TimingOptimiser
                 log_info("    %s.%s at %s crit %0.02f\n", port->cell->name.c_str(ctx), port->port.c_str(ctx),
                          ctx->nameOfBel(port->cell->bel), crit);
             }
-            if (std::find(path_cells.begin(), path_cells.end(), port->cell->name) != path_cells.end())
+            if (std::find(ps.path_cells.begin(), ps.path_cells.end(), port->cell->name) != ps.path_cells.end())
                 continue;
             if (port->cell->belStrength > STRENGTH_WEAK || !cfg.cellTypes.count(port->cell->type) ||
                 port->cell->cluster != ClusterId())
                 continue;
             if (ctx->debug)
                 log_info("        can move\n");
-            path_cells.push_back(port->cell->name);
+            ps.path_cells.push_back(port->cell->name);
         }
 
-        if (path_cells.size() < 2) {
+        if (ps.path_cells.size() < 2) {
             if (ctx->debug) {
                 log_info("Too few moveable cells; skipping path\n");
                 log_break();
             }
+            return false;
+        }
+        return true;
+    }
 
-            return;
+    // Finds candidate bels for the cells on the path, and the footprint of the path: the tiles of all the bels that
+    // might be bound or checked (touched), and the tiles of all the cells whose delays are looked at (observed). Only
+    // reads the placement, so may be called for several paths at once
+    void find_path_neighbours(PathState &ps)
+    {
+        ps.cell_neighbour_bels.clear();
+        ps.bel_candidate_cells.clear();
+        IdString last_cell;
+        const int d = 2; // FIXME: how to best determine d
+        for (auto cell : ps.path_cells) {
+            // FIXME: when should we allow swapping due to a lack of candidates
+            find_neighbours(ps, ctx->cells.at(cell).get(), last_cell, d, false);
+            last_cell = cell;
+        }
+
+        pool<int> touched, observed;
+        pool<IdString> moved_cells;
+        ps.partition_safe = true;
+        auto touch_bel = [&](BelId bel) {
+            touched.insert(tile_index(ctx->getBelLocation(bel)));
+            ps.partition_safe &= ctx->isBelBindingPartitionSafe(bel);
+            CellInfo *bound = ctx->getBoundBelCell(bel);
+            if (bound != nullptr)
+                moved_cells.insert(bound->name);
+        };
+        auto observe_cell = [&](const CellInfo *cell) {
+            if (cell != nullptr && cell->bel != BelId())
+                observed.insert(tile_index(ctx->getBelLocation(cell->bel)));
+        };
+        for (auto cell : ps.path_cells)
+            touch_bel(ctx->cells.at(cell)->bel);
+        for (auto &cell_bels : ps.cell_neighbour_bels)
+            for (auto bel : cell_bels.second)
+                touch_bel(bel);
+        // Path delays are computed from every cell on the path, and delay limits are checked on all the arcs of the
+        // cells that might move
+        NetInfo *front_net = ps.path->front()->cell->ports.at(ps.path->front()->port).net;
+        if (front_net != nullptr)
+            observe_cell(front_net->driver.cell);
+        for (auto port : *ps.path)
+            observe_cell(port->cell);
+        for (auto cell_name : moved_cells) {
+            CellInfo *cell = ctx->cells.at(cell_name).get();
+            for (const auto &port : cell->ports) {
+                NetInfo *net = port.second.net;
+                if (net == nullptr)
+                    continue;
+                if (port.second.type == PORT_IN) {
+                    observe_cell(net->driver.cell);
+                } else if (port.second.type == PORT_OUT) {
+                    for (auto &user : net->users)
+                        observe_cell(user.cell);
+                }
+            }
         }
+        ps.touched_tiles.assign(touched.begin(), touched.end());
+        ps.observed_tiles.assign(observed.begin(), observed.end());
+    }
+
+    // Finds the placement of the path cells, among their candidate bels, with the lowest path delay. Bels are bound
+    // experimentally but the placement is restored afterwards
+    void solve_path(PathState &ps)
+    {
+        auto &path = *ps.path;
+        auto &path_cells = ps.path_cells;
+        auto &cell_neighbour_bels = ps.cell_neighbour_bels;
+        ps.solution.clear();
 
         // Calculate original delay before touching anything
         delay_t original_delay = 0;
@@ -403,23 +626,7 @@ class TimingOptimiser
             if (port.user_idx)
                 original_delay += ctx->predictArcDelay(pn, pn->users.at(port.user_idx));
         }
-
-        IdString last_cell;
-        const int d = 2; // FIXME: how to best determine d
-        for (auto cell : path_cells) {
-            // FIXME: when should we allow swapping due to a lack of candidates
-            find_neighbours(ctx->cells[cell].get(), last_cell, d, false);
-            last_cell = cell;
-        }
-
-        if (ctx->debug) {
-            for (auto cell : path_cells) {
-                log_info("Candidate neighbours for %s (%s):\n", cell.c_str(ctx), ctx->nameOfBel(ctx->cells[cell]->bel));
-                for (auto neigh : cell_neighbour_bels.at(cell)) {
-                    log_info("    %s\n", ctx->nameOfBel(neigh));
-                }
-            }
-        }
+        ps.original_delay = original_delay;
 
         // Actual BFS path optimisation algorithm
         dict<IdString, dict<BelId, delay_t>> cumul_costs;
@@ -520,35 +727,51 @@ class TimingOptimiser
                                            });
             NPNR_ASSERT(lowest != end_options.end());
 
-            std::vector<std::pair<IdString, BelId>> route_to_solution;
             auto cursor = std::make_pair(path_cells.back(), lowest->first);
-            route_to_solution.push_back(cursor);
+            ps.solution.push_back(cursor);
             while (backtrace.count(cursor)) {
                 cursor = backtrace.at(cursor);
-                route_to_solution.push_back(cursor);
+                ps.solution.push_back(cursor);
             }
+            std::reverse(ps.solution.begin(), ps.solution.end());
+            ps.solution_delay = lowest->second;
+        }
+    }
+
+    // Moves the path cells to the solution found, if any; returns true if the placement changed
+    bool commit_path(PathState &ps)
+    {
+        if (ctx->debug) {
+            for (auto cell : ps.path_cells) {
+                log_info("Candidate neighbours for %s (%s):\n", cell.c_str(ctx),
+                         ctx->nameOfBel(ctx->cells.at(cell)->bel));
+                for (auto neigh : ps.cell_neighbour_bels.at(cell)) {
+                    log_info("    %s\n", ctx->nameOfBel(neigh));
+                }
+            }
+        }
+        bool changed = false;
+        if (!ps.solution.empty()) {
             if (ctx->debug)
                 log_info("Found a solution with cost %.02f ns (existing path %.02f ns)\n",
-                         ctx->getDelayNS(lowest->second), ctx->getDelayNS(original_delay));
-            for (auto rt_entry : boost::adaptors::reverse(route_to_solution)) {
+                         ctx->getDelayNS(ps.solution_delay), ctx->getDelayNS(ps.original_delay));
+            for (auto rt_entry : ps.solution) {
                 CellInfo *cell = ctx->cells.at(rt_entry.first).get();
-                cell_swap_bel(cell, rt_entry.second);
+                changed |= (cell_swap_bel(cell, rt_entry.second) != rt_entry.second);
                 if (ctx->debug)
                     log_info("    %s at %s\n", rt_entry.first.c_str(ctx), ctx->nameOfBel(rt_entry.second));
             }
-
+            if (ps.solution_delay < ps.original_delay)
+                ++total_improved;
         } else {
             if (ctx->debug)
                 log_info("Solution was not found\n");
         }
         if (ctx->debug)
             log_break();
+        return changed;
     }
 
-    // Current candidate Bels for cells (linked in both direction>
-    std::vector<IdString> path_cells;
-    dict<IdString, pool<BelId>> cell_neighbour_bels;
-    dict<BelId, pool<IdString>> bel_candidate_cells;
     // Map cell ports to net delay limit
     dict<std::pair<IdString, IdString>, delay_t> max_net_delay;
     Context *ctx;
@@ -1300,187 +1300,229 @@ bool router1(Context *ctx, const Router1Cfg &cfg)
     }
 }
 
-bool Context::checkRoutedDesign() const
+namespace {
+// Checks the routing of one net for Context::checkRoutedDesign; this may be called from several threads at once, but
+// only logs anything in debug mode, where nets are checked one at a time
+bool check_net_routing(const Context *ctx, NetInfo *net_info)
 {
-    const Context *ctx = getCtx();
-
-    for (auto &net_it : ctx->nets) {
-        NetInfo *net_info = net_it.second.get();
-
-#ifdef ARCH_ECP5
-        if (net_info->is_global)
-            continue;
-#endif
+    if (ctx->debug)
+        log("checking net %s\n", ctx->nameOf(net_info));
 
+    if (net_info->users.empty()) {
         if (ctx->debug)
-            log("checking net %s\n", ctx->nameOf(net_info));
-
-        if (net_info->users.empty()) {
-            if (ctx->debug)
-                log("  net without sinks\n");
-            log_assert(net_info->wires.empty());
-            continue;
-        }
+            log("  net without sinks\n");
+        return net_info->wires.empty();
+    }
 
-        bool found_unrouted = false;
-        bool found_loop = false;
-        bool found_stub = false;
+    bool found_unrouted = false;
+    bool found_loop = false;
+    bool found_stub = false;
+    bool found_unbound = false;
 
-        struct ExtraWireInfo
-        {
-            int order_num = 0;
-            pool<WireId> children;
-        };
+    struct ExtraWireInfo
+    {
+        int order_num = 0;
+        pool<WireId> children;
+    };
 
-        dict<WireId, std::unique_ptr<ExtraWireInfo>> db;
+    dict<WireId, std::unique_ptr<ExtraWireInfo>> db;
 
-        for (auto &it : net_info->wires) {
-            WireId w = it.first;
-            PipId p = it.second.pip;
+    for (auto &it : net_info->wires) {
+        WireId w = it.first;
+        PipId p = it.second.pip;
 
-            if (p != PipId()) {
-                log_assert(ctx->getPipDstWire(p) == w);
-                db.emplace(ctx->getPipSrcWire(p), std::make_unique<ExtraWireInfo>()).first->second->children.insert(w);
-            }
+        if (ctx->getBoundWireNet(w) != net_info) {
+            if (ctx->debug)
+                log("  wire %s not bound to net\n", ctx->nameOfWire(w));
+            found_unbound = true;
         }
 
-        auto src_wire = ctx->getNetinfoSourceWire(net_info);
-        if (net_info->constant_value == IdString()) {
-            if (src_wire == WireId()) {
-                log_assert(net_info->driver.cell == nullptr);
+        if (p != PipId()) {
+            if (ctx->getPipDstWire(p) != w || ctx->getBoundPipNet(p) != net_info) {
                 if (ctx->debug)
-                    log("  undriven and unrouted\n");
+                    log("  pip %s not bound to net\n", ctx->nameOfPip(p));
+                found_unbound = true;
                 continue;
             }
+            db.emplace(ctx->getPipSrcWire(p), std::make_unique<ExtraWireInfo>()).first->second->children.insert(w);
+        }
+    }
 
-            if (net_info->wires.count(src_wire) == 0) {
-                if (ctx->debug)
-                    log("  source (%s) not bound to net\n", ctx->nameOfWire(src_wire));
-                found_unrouted = true;
-            }
+    auto src_wire = ctx->getNetinfoSourceWire(net_info);
+    if (net_info->constant_value == IdString()) {
+        if (src_wire == WireId()) {
+            log_assert(net_info->driver.cell == nullptr);
+            if (ctx->debug)
+                log("  undriven and unrouted\n");
+            return true;
         }
 
-        dict<WireId, store_index<PortRef>> dest_wires;
-        for (auto user : net_info->users.enumerate()) {
-            for (auto dst_wire : ctx->getNetinfoSinkWires(net_info, user.value)) {
-                log_assert(dst_wire != WireId());
-                dest_wires[dst_wire] = user.index;
+        if (net_info->wires.count(src_wire) == 0) {
+            if (ctx->debug)
+                log("  source (%s) not bound to net\n", ctx->nameOfWire(src_wire));
+            found_unrouted = true;
+        }
+    }
 
-                if (net_info->wires.count(dst_wire) == 0) {
-                    if (ctx->debug)
-                        log("  sink %d (%s) not bound to net\n", user.index.idx(), ctx->nameOfWire(dst_wire));
-                    found_unrouted = true;
-                }
+    dict<WireId, store_index<PortRef>> dest_wires;
+    for (auto user : net_info->users.enumerate()) {
+        for (auto dst_wire : ctx->getNetinfoSinkWires(net_info, user.value)) {
+            log_assert(dst_wire != WireId());
+            dest_wires[dst_wire] = user.index;
+
+            if (net_info->wires.count(dst_wire) == 0) {
+                if (ctx->debug)
+                    log("  sink %d (%s) not bound to net\n", user.index.idx(), ctx->nameOfWire(dst_wire));
+                found_unrouted = true;
             }
         }
+    }
 
-        std::function<void(WireId, int)> setOrderNum;
-        pool<WireId> logged_wires;
+    std::function<void(WireId, int)> setOrderNum;
+    pool<WireId> logged_wires;
 
-        setOrderNum = [&](WireId w, int num) {
-            auto &db_entry = *db.emplace(w, std::make_unique<ExtraWireInfo>()).first->second;
-            if (db_entry.order_num != 0) {
-                found_loop = true;
+    setOrderNum = [&](WireId w, int num) {
+        auto &db_entry = *db.emplace(w, std::make_unique<ExtraWireInfo>()).first->second;
+        if (db_entry.order_num != 0) {
+            found_loop = true;
+            if (ctx->debug)
                 log("  %*s=> loop\n", 2 * num, "");
-                return;
-            }
-            db_entry.order_num = num;
-            for (WireId child : db_entry.children) {
-                if (ctx->debug) {
-                    log("  %*s-> %s\n", 2 * num, "", ctx->nameOfWire(child));
-                    logged_wires.insert(child);
-                }
-                setOrderNum(child, num + 1);
-            }
-            if (db_entry.children.empty()) {
-                if (dest_wires.count(w) != 0) {
-                    if (ctx->debug)
-                        log("  %*s=> sink %d\n", 2 * num, "", dest_wires.at(w).idx());
-                } else {
-                    if (ctx->debug)
-                        log("  %*s=> stub\n", 2 * num, "");
-                    found_stub = true;
-                }
+            return;
+        }
+        db_entry.order_num = num;
+        for (WireId child : db_entry.children) {
+            if (ctx->debug) {
+                log("  %*s-> %s\n", 2 * num, "", ctx->nameOfWire(child));
+                logged_wires.insert(child);
             }
-        };
-
-        if (ctx->debug) {
-            log("  driver: %s\n", ctx->nameOfWire(src_wire));
-            logged_wires.insert(src_wire);
+            setOrderNum(child, num + 1);
         }
-        if (net_info->constant_value != IdString()) {
-            for (const auto &wire : net_info->wires) {
-                if (wire.second.pip == PipId() && ctx->getWireConstantValue(wire.first) == net_info->constant_value)
-                    setOrderNum(wire.first, 1);
+        if (db_entry.children.empty()) {
+            if (dest_wires.count(w) != 0) {
+                if (ctx->debug)
+                    log("  %*s=> sink %d\n", 2 * num, "", dest_wires.at(w).idx());
+            } else {
+                if (ctx->debug)
+                    log("  %*s=> stub\n", 2 * num, "");
+                found_stub = true;
             }
-        } else {
-            setOrderNum(src_wire, 1);
         }
+    };
 
-        pool<WireId> dangling_wires;
-
-        for (auto &it : db) {
-            auto &db_entry = *it.second;
-            if (db_entry.order_num == 0)
-                dangling_wires.insert(it.first);
+    if (ctx->debug) {
+        log("  driver: %s\n", ctx->nameOfWire(src_wire));
+        logged_wires.insert(src_wire);
+    }
+    if (net_info->constant_value != IdString()) {
+        for (const auto &wire : net_info->wires) {
+            if (wire.second.pip == PipId() && ctx->getWireConstantValue(wire.first) == net_info->constant_value)
+                setOrderNum(wire.first, 1);
         }
+    } else {
+        setOrderNum(src_wire, 1);
+    }
 
-        if (ctx->debug) {
-            if (dangling_wires.empty()) {
-                log("  no dangling wires.\n");
-            } else {
-                pool<WireId> root_wires = dangling_wires;
+    pool<WireId> dangling_wires;
 
-                for (WireId w : dangling_wires) {
-                    for (WireId c : db[w]->children)
-                        root_wires.erase(c);
-                }
+    for (auto &it : db) {
+        auto &db_entry = *it.second;
+        if (db_entry.order_num == 0)
+            dangling_wires.insert(it.first);
+    }
 
-                for (WireId w : root_wires) {
-                    log("  dangling wire: %s\n", ctx->nameOfWire(w));
-                    logged_wires.insert(w);
-                    setOrderNum(w, 1);
-                }
+    if (ctx->debug) {
+        if (dangling_wires.empty()) {
+            log("  no dangling wires.\n");
+        } else {
+            pool<WireId> root_wires = dangling_wires;
 
-                for (WireId w : dangling_wires) {
-                    if (logged_wires.count(w) == 0)
-                        log("  loop: %s -> %s\n", ctx->nameOfWire(ctx->getPipSrcWire(net_info->wires.at(w).pip)),
-                            ctx->nameOfWire(w));
-                }
+            for (WireId w : dangling_wires) {
+                for (WireId c : db[w]->children)
+                    root_wires.erase(c);
             }
-        }
 
-        bool fail = false;
+            for (WireId w : root_wires) {
+                log("  dangling wire: %s\n", ctx->nameOfWire(w));
+                logged_wires.insert(w);
+                setOrderNum(w, 1);
+            }
 
-        if (found_unrouted) {
-            if (ctx->debug)
-                log("check failed: found unrouted arcs\n");
-            fail = true;
+            for (WireId w : dangling_wires) {
+                if (logged_wires.count(w) == 0)
+                    log("  loop: %s -> %s\n", ctx->nameOfWire(ctx->getPipSrcWire(net_info->wires.at(w).pip)),
+                        ctx->nameOfWire(w));
+            }
         }
+    }
 
-        if (found_loop) {
-            if (ctx->debug)
-                log("check failed: found loops\n");
-            fail = true;
-        }
+    bool fail = false;
 
-        if (found_stub) {
-            if (ctx->debug)
-                log("check failed: found stubs\n");
-            fail = true;
-        }
+    if (found_unrouted) {
+        if (ctx->debug)
+            log("check failed: found unrouted arcs\n");
+        fail = true;
+    }
 
-        if (!dangling_wires.empty()) {
-            if (ctx->debug)
-                log("check failed: found dangling wires\n");
-            fail = true;
-        }
+    if (found_loop) {
+        if (ctx->debug)
+            log("check failed: found loops\n");
+        fail = true;
+    }
 
-        if (fail)
-            return false;
+    if (found_stub) {
+        if (ctx->debug)
+            log("check failed: found stubs\n");
+        fail = true;
     }
 
-    return true;
+    if (!dangling_wires.empty()) {
+        if (ctx->debug)
+            log("check failed: found dangling wires\n");
+        fail = true;
+    }
+
+    if (found_unbound) {
+        if (ctx->debug)
+            log("check failed: found wires or pips not bound to net\n");
+        fail = true;
+    }
+
+    return !fail;
+}
+} // namespace
+
+bool Context::checkRoutedDesign(std::vector<NetInfo *> *failed_nets) const
+{
+    const Context *ctx = getCtx();
+
+    std::vector<NetInfo *> to_check;
+    for (auto &net_it : ctx->nets) {
+#ifdef ARCH_ECP5
+        if (net_it.second->is_global)
+            continue;
+#endif
+        to_check.push_back(net_it.second.get());
+    }
+
+    std::vector<char> net_ok(to_check.size());
+    if (ctx->debug) {
+        // Keep the log for each net in one piece
+        for (size_t i = 0; i < to_check.size(); i++)
+            net_ok.at(i) = check_net_routing(ctx, to_check.at(i));
+    } else {
+        threadPool().parallel_for(
+                0, int(to_check.size()), [&](int i) { net_ok.at(i) = check_net_routing(ctx, to_check.at(i)); }, 64);
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < to_check.size(); i++) {
+        if (net_ok.at(i))
+            continue;
+        success = false;
+        if (failed_nets != nullptr)
+            failed_nets->push_back(to_check.at(i));
+    }
+    return success;
 }
 
 bool Context::getActualRouteDelay(WireId src_wire, WireId dst_wire, delay_t *delay, dict<WireId, PipId> *route,
@@ -29,13 +29,17 @@
 #include "router2.h"
 
 #include <algorithm>
+#include <array>
 #include <boost/container/flat_map.hpp>
 #include <chrono>
 #include <deque>
 #include <fstream>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <queue>
 #include <set>
+#include <thread>
 
 #include "log.h"
 #include "nextpnr.h"
@@ -57,6 +61,29 @@ struct Router2
         bool routed = false;
     };
 
+    // Search effort counters, kept per thread context and per net for perfProfile and the trace
+    struct RouteStats
+    {
+        // Pips considered, and wires added to and taken from the search queues
+        int64_t explored = 0, queue_pushes = 0, queue_pops = 0;
+        int arcs_routed = 0, ripups = 0;
+        // Arcs routed starting from nearby existing routing (mode 0) or from the whole net (mode 1); fallbacks counts
+        // the arcs where mode 0 was tried first and failed
+        int mode0_arcs = 0, mode1_arcs = 0, fallbacks = 0;
+
+        void add(const RouteStats &other, int sign = 1)
+        {
+            explored += sign * other.explored;
+            queue_pushes += sign * other.queue_pushes;
+            queue_pops += sign * other.queue_pops;
+            arcs_routed += sign * other.arcs_routed;
+            ripups += sign * other.ripups;
+            mode0_arcs += sign * other.mode0_arcs;
+            mode1_arcs += sign * other.mode1_arcs;
+            fallbacks += sign * other.fallbacks;
+        }
+    };
+
     // As we allow overlap at first; the nextpnr bind functions can't be used
     // as the primary relation between arcs and wires/pips
     struct PerNetData
@@ -70,6 +97,7 @@ struct Router2
         int total_route_us = 0;
         float max_crit = 0;
         int fail_count = 0;
+        RouteStats stats;
     };
 
     struct WireScore
@@ -80,6 +108,7 @@ struct Router2
         float total() const { return cost + togo_cost; }
     };
 
+    // Congestion and reservation state, persistent across iterations
     struct PerWireData
     {
         // nextpnr
@@ -87,16 +116,21 @@ struct Router2
         // Historical congestion cost
         int curr_cong = 0;
         float hist_cong_cost = 1.0;
-        // Wire is unavailable as locked to another arc
-        bool unavailable = false;
         // This wire has to be used for this net
         int reserved_net = -1;
         // The notional location of the wire, to guarantee thread safety
         int16_t x = 0, y = 0;
-        // Visit data
+        // Wire is unavailable as locked to another arc
+        bool unavailable = false;
+    };
+
+    // Search state, only touched during the expansion of a single arc. Kept apart from PerWireData so the
+    // frequently reset visit data is densely packed; only the thread owning the wire's partition accesses it
+    struct WireVisitData
+    {
         PipId pip_fwd, pip_bwd;
-        bool visited_fwd = false, visited_bwd = false;
         float cost_fwd = 0.0, cost_bwd = 0.0;
+        bool visited_fwd = false, visited_bwd = false;
     };
 
     Context *ctx;
@@ -183,40 +217,80 @@ struct Router2
         }
     }
 
+    // If the arch provides dense wire indices, these are used directly as indices into the flat arrays;
+    // otherwise we fall back to a hash lookup
+    bool dense_wires = false;
     dict<WireId, int> wire_to_idx;
     std::vector<PerWireData> flat_wires;
+    std::vector<WireVisitData> wire_visit;
 
-    PerWireData &wire_data(WireId w) { return flat_wires[wire_to_idx.at(w)]; }
+    // In ECO mode, with dense wire indices, a wire is only set up when it is first looked up here, as most of the
+    // device is never reached by the few nets that are rerouted. Multi-threaded routing sets up the rest first
+    bool lazy_wires = false, all_wires_set_up = false;
 
-    void setup_wires()
+    int wire_index(WireId w)
     {
-        // Set up per-wire structures, so that MT parts don't have to do any memory allocation
-        // This is possibly quite wasteful and not cache-optimal; further consideration necessary
-        for (auto wire : ctx->getWires()) {
-            PerWireData pwd;
-            pwd.w = wire;
-            NetInfo *bound = ctx->getBoundWireNet(wire);
-            if (bound != nullptr) {
-                auto iter = bound->wires.find(wire);
-                if (iter != bound->wires.end()) {
-                    auto &nd = nets.at(bound->udata);
-                    nd.wires[wire] = std::make_pair(bound->wires.at(wire).pip, 0);
+        if (!dense_wires)
+            return wire_to_idx.at(w);
+        int idx = ctx->getWireIndex(w);
+        if (lazy_wires && flat_wires[idx].w == WireId())
+            init_wire(flat_wires[idx], w);
+        return idx;
+    }
+    PerWireData &wire_data(WireId w) { return flat_wires[wire_index(w)]; }
+
+    void init_wire(PerWireData &pwd, WireId wire)
+    {
+        pwd.w = wire;
+        NetInfo *bound = ctx->getBoundWireNet(wire);
+        if (bound != nullptr) {
+            auto iter = bound->wires.find(wire);
+            if (iter != bound->wires.end()) {
+                // When set up lazily, the routing of queued nets is counted by load_net and the router itself, so
+                // only the binding of a net that hasn't been queued counts here
+                if (!lazy_wires)
+                    nets.at(bound->udata).wires[wire] = std::make_pair(iter->second.pip, 0);
+                if (!lazy_wires || !net_touched.at(bound->udata))
                     pwd.curr_cong = 1;
-                    if (bound->wires.at(wire).strength == STRENGTH_PLACER) {
-                        pwd.reserved_net = bound->udata;
-                    } else if (bound->wires.at(wire).strength > STRENGTH_PLACER) {
-                        pwd.unavailable = true;
-                    }
+                if (iter->second.strength == STRENGTH_PLACER) {
+                    pwd.reserved_net = bound->udata;
+                } else if (iter->second.strength > STRENGTH_PLACER) {
+                    pwd.unavailable = true;
                 }
             }
+        }
 
-            BoundingBox wire_loc = ctx->getRouteBoundingBox(wire, wire);
-            pwd.x = (wire_loc.x0 + wire_loc.x1) / 2;
-            pwd.y = (wire_loc.y0 + wire_loc.y1) / 2;
+        BoundingBox wire_loc = ctx->getRouteBoundingBox(wire, wire);
+        pwd.x = (wire_loc.x0 + wire_loc.x1) / 2;
+        pwd.y = (wire_loc.y0 + wire_loc.y1) / 2;
+    }
 
-            wire_to_idx[wire] = int(flat_wires.size());
-            flat_wires.push_back(pwd);
+    void setup_wires()
+    {
+        // Set up per-wire structures, so that MT parts don't have to do any memory allocation
+        int wire_count = ctx->getWireIndexCount();
+        dense_wires = (wire_count > 0);
+        if (dense_wires)
+            flat_wires.resize(wire_count);
+        if (cfg.eco && dense_wires) {
+            // Wires are set up by wire_index, and existing routing by load_net when a net is queued
+            lazy_wires = true;
+            wire_visit.resize(flat_wires.size());
+            return;
+        }
+        for (auto wire : ctx->getWires()) {
+            PerWireData pwd;
+            init_wire(pwd, wire);
+            if (dense_wires) {
+                int idx = ctx->getWireIndex(wire);
+                NPNR_ASSERT(idx >= 0 && idx < wire_count && flat_wires.at(idx).w == WireId());
+                flat_wires.at(idx) = pwd;
+            } else {
+                wire_to_idx[wire] = int(flat_wires.size());
+                flat_wires.push_back(pwd);
+            }
         }
+        wire_visit.resize(flat_wires.size());
 
         for (auto &net_pair : ctx->nets) {
             auto *net = net_pair.second.get();
@@ -232,6 +306,109 @@ struct Router2
         }
     }
 
+    // Nets that ECO mode has queued for routing at some point; all other nets keep the routing they were loaded with,
+    // and are left alone by update_congestion and bind_and_check_all
+    std::vector<bool> net_touched;
+
+    // Adds the wires on the path from an arc's sink back to the net's source in the Arch API to on_path, returning
+    // whether that path is complete. A path that reaches a wire already in on_path is complete, too
+    bool mark_arc_path(const NetInfo *ni, WireId src, WireId sink, pool<WireId> &on_path)
+    {
+        std::vector<WireId> path;
+        WireId cursor = sink;
+        while (cursor != src && !on_path.count(cursor)) {
+            auto found = ni->wires.find(cursor);
+            // The size check guards against loops in the loaded routing
+            if (found == ni->wires.end() || found->second.pip == PipId() || path.size() > ni->wires.size())
+                return false;
+            path.push_back(cursor);
+            cursor = ctx->getPipSrcWire(found->second.pip);
+        }
+        path.push_back(cursor);
+        for (auto w : path)
+            on_path.insert(w);
+        return true;
+    }
+
+    // ECO mode: keep the existing routing of arcs that are still intact, and only queue the nets where an arc was left
+    // unrouted by a netlist or placement change. Run after setup_nets. The existing routing is checked in the Arch API,
+    // so that only the queued nets need their routing loaded
+    void setup_eco()
+    {
+        // Rip up wires that are no longer on a path from the source to any sink, because a cell was moved or a pin was
+        // disconnected. Otherwise they would still count as congestion against the wires of other nets. Wires bound
+        // more strongly than the router may rip up are left, and still count
+        int stale_wires = 0;
+        std::vector<NetInfo *> eco_nets;
+        int eco_arcs = 0;
+        std::vector<WireId> stale;
+        for (auto ni : nets_by_udata) {
+            auto &nd = nets.at(ni->udata);
+            pool<WireId> on_path;
+            int unrouted = 0;
+            for (auto &usr_arcs : nd.arcs)
+                for (auto &ad : usr_arcs)
+                    if (nd.src_wire == WireId() || !mark_arc_path(ni, nd.src_wire, ad.sink_wire, on_path))
+                        ++unrouted;
+            if (unrouted > 0 && (nd.src_wire != WireId() || is_dedi_const_net(ni))) {
+                eco_nets.push_back(ni);
+                eco_arcs += unrouted;
+            }
+            if (is_dedi_const_net(ni))
+                continue;
+            stale.clear();
+            for (auto &w : ni->wires)
+                if (!on_path.count(w.first) && w.second.strength <= STRENGTH_STRONG)
+                    stale.push_back(w.first);
+            for (auto w : stale)
+                ctx->unbindWire(w);
+            stale_wires += int(stale.size());
+        }
+        log_info("ECO: %d/%d nets with %d unrouted arcs to route, %d stale wires ripped up.\n", int(eco_nets.size()),
+                 int(nets_by_udata.size()), eco_arcs, stale_wires);
+
+        net_touched.assign(nets_by_udata.size(), false);
+        setup_wires();
+        find_all_reserved_wires(eco_nets);
+        for (auto ni : eco_nets)
+            queue_net(ni->udata);
+    }
+
+    // ECO mode with lazily set up wires: brings in the existing routing of a net the first time it is queued, and marks
+    // the arcs that are still complete as routed. A net queued after routing has started may share wires with the nets
+    // being rerouted, so congestion is left for route_net to find, as it is for nets loaded before routing
+    void load_net(NetInfo *ni)
+    {
+        auto &nd = nets.at(ni->udata);
+        for (auto &w : ni->wires) {
+            auto &wd = flat_wires.at(ctx->getWireIndex(w.first));
+            // A wire set up before the net was queued already counts its use by the net
+            if (wd.w == WireId()) {
+                init_wire(wd, w.first);
+                ++wd.curr_cong;
+            }
+            nd.wires[w.first] = std::make_pair(w.second.pip, 0);
+        }
+        pool<WireId> on_path;
+        for (auto usr : ni->users.enumerate()) {
+            auto &usr_arcs = nd.arcs.at(usr.index.idx());
+            for (size_t phys_pin = 0; phys_pin < usr_arcs.size(); phys_pin++)
+                if (nd.src_wire != WireId() && mark_arc_path(ni, nd.src_wire, usr_arcs.at(phys_pin).sink_wire, on_path))
+                    record_prerouted_net(ni, usr.index, phys_pin);
+        }
+    }
+
+    // Adds a net to the routing queue for the next iteration
+    void queue_net(int net)
+    {
+        route_queue.push_back(net);
+        if (cfg.eco && !net_touched.at(net)) {
+            net_touched.at(net) = true;
+            if (lazy_wires)
+                load_net(nets_by_udata.at(net));
+        }
+    }
+
     struct QueuedWire
     {
 
@@ -280,6 +457,8 @@ struct Router2
         // Used to add existing routing to the heap
         pool<WireId> in_wire_by_loc;
         dict<std::pair<int, int>, pool<WireId>> wire_by_loc;
+
+        RouteStats stats;
     };
 
     bool thread_test_wire(ThreadContext &t, PerWireData &w)
@@ -418,7 +597,7 @@ struct Router2
         WireId src = nets.at(net->udata).src_wire;
         WireId cursor = ad.sink_wire;
         while (cursor != src) {
-            size_t wire_idx = wire_to_idx.at(cursor);
+            size_t wire_idx = wire_index(cursor);
             PipId pip = nd.wires.at(cursor).first;
             bind_pip_internal(nd, usr, wire_idx, pip);
             cursor = ctx->getPipSrcWire(pip);
@@ -503,13 +682,13 @@ struct Router2
         return did_something;
     }
 
-    void find_all_reserved_wires()
+    void find_all_reserved_wires(const std::vector<NetInfo *> &to_reserve)
     {
         // Run iteratively, as reserving wires for one net might limit choices for another
         bool did_something = false;
         do {
             did_something = false;
-            for (auto net : nets_by_udata) {
+            for (auto net : to_reserve) {
                 WireId src = ctx->getNetinfoSourceWire(net);
                 if (src == WireId())
                     continue;
@@ -521,14 +700,8 @@ struct Router2
 
     void reset_wires(ThreadContext &t)
     {
-        for (auto w : t.dirty_wires) {
-            flat_wires[w].pip_fwd = PipId();
-            flat_wires[w].pip_bwd = PipId();
-            flat_wires[w].visited_fwd = false;
-            flat_wires[w].visited_bwd = false;
-            flat_wires[w].cost_fwd = 0.0;
-            flat_wires[w].cost_bwd = 0.0;
-        }
+        for (auto w : t.dirty_wires)
+            wire_visit[w] = WireVisitData();
         t.dirty_wires.clear();
     }
 
@@ -560,7 +733,7 @@ struct Router2
     // Functions for marking wires as visited, and checking if they have already been visited
     void set_visited_fwd(ThreadContext &t, int wire, PipId pip, float cost)
     {
-        auto &wd = flat_wires.at(wire);
+        auto &wd = wire_visit[wire];
         if (!wd.visited_fwd && !wd.visited_bwd)
             t.dirty_wires.push_back(wire);
         wd.pip_fwd = pip;
@@ -569,7 +742,7 @@ struct Router2
     }
     void set_visited_bwd(ThreadContext &t, int wire, PipId pip, float cost)
     {
-        auto &wd = flat_wires.at(wire);
+        auto &wd = wire_visit[wire];
         if (!wd.visited_fwd && !wd.visited_bwd)
             t.dirty_wires.push_back(wire);
         wd.pip_bwd = pip;
@@ -579,11 +752,13 @@ struct Router2
 
     bool was_visited_fwd(int wire, float cost)
     {
-        return flat_wires.at(wire).visited_fwd && flat_wires.at(wire).cost_fwd <= cost;
+        auto &wd = wire_visit[wire];
+        return wd.visited_fwd && wd.cost_fwd <= cost;
     }
     bool was_visited_bwd(int wire, float cost)
     {
-        return flat_wires.at(wire).visited_bwd && flat_wires.at(wire).cost_bwd <= cost;
+        auto &wd = wire_visit[wire];
+        return wd.visited_bwd && wd.cost_bwd <= cost;
     }
 
     float get_arc_crit(NetInfo *net, store_index<PortRef> i)
@@ -617,8 +792,8 @@ struct Router2
         if (dst_wire == WireId())
             ARC_LOG_ERR("No wire found for port %s on destination cell %s.\n", ctx->nameOf(usr.port),
                         ctx->nameOf(usr.cell));
-        int src_wire_idx = const_mode ? -1 : wire_to_idx.at(src_wire);
-        int dst_wire_idx = wire_to_idx.at(dst_wire);
+        int src_wire_idx = const_mode ? -1 : wire_index(src_wire);
+        int dst_wire_idx = wire_index(dst_wire);
         // Calculate a timing weight based on criticality
         float crit = get_arc_crit(net, i);
         float crit_weight = std::max<float>(0.05f, (1.0f - std::pow(crit, 2)));
@@ -633,10 +808,12 @@ struct Router2
         int mode = 0;
         if (net->users.entries() < 4 || nd.wires.empty() || (crit > 0.95))
             mode = 1;
+        int start_mode = mode;
 
         // This records the point where forwards and backwards routing met
         int midpoint_wire = -1;
         int explored = 1;
+        int64_t pips_seen = 0, pushes = 0;
 
         for (; mode < 2; mode++) {
             // Clear out the queues
@@ -658,9 +835,10 @@ struct Router2
                 WireScore base_score;
                 base_score.delay = 0;
                 base_score.cost = 0;
-                int wire_idx = wire_to_idx.at(wire);
+                int wire_idx = wire_index(wire);
                 base_score.togo_cost = get_togo_cost(net, i, wire_idx, dst_wire, false, crit_weight);
                 t.fwd_queue.push(QueuedWire(wire_idx, base_score));
+                ++pushes;
                 set_visited_fwd(t, wire_idx, PipId(), 0.0);
             };
             auto &dst_data = flat_wires.at(dst_wire_idx);
@@ -690,9 +868,10 @@ struct Router2
                 WireScore base_score;
                 base_score.delay = 0;
                 base_score.cost = 0;
-                int wire_idx = wire_to_idx.at(wire);
+                int wire_idx = wire_index(wire);
                 base_score.togo_cost = get_togo_cost(net, i, wire_idx, src_wire, true, crit_weight);
                 t.bwd_queue.push(QueuedWire(wire_idx, base_score));
+                ++pushes;
                 set_visited_bwd(t, wire_idx, PipId(), 0.0);
             };
 
@@ -719,13 +898,14 @@ struct Router2
                     }
                     auto &curr_data = flat_wires.at(curr.wire);
                     for (PipId dh : ctx->getPipsDownhill(curr_data.w)) {
+                        ++pips_seen;
                         // Skip pips outside of box in bounding-box mode
                         if (is_bb && !hit_test_pip(nd.bb, ctx->getPipLocation(dh)))
                             continue;
                         if (!ctx->checkPipAvailForNet(dh, net))
                             continue;
                         WireId next = ctx->getPipDstWire(dh);
-                        int next_idx = wire_to_idx.at(next);
+                        int next_idx = wire_index(next);
                         WireScore next_score;
                         next_score.delay = curr.score.delay + cfg.get_base_cost(ctx, next, dh, crit_weight);
                         next_score.cost = curr.score.cost + score_wire_for_arc(net, i, phys_pin, next, dh, crit_weight);
@@ -749,6 +929,7 @@ struct Router2
                             continue; // thread safety issue
                         set_visited_fwd(t, next_idx, dh, next_score.delay);
                         t.fwd_queue.push(QueuedWire(next_idx, next_score, t.rng.rng()));
+                        ++pushes;
                     }
                 }
                 if (!t.bwd_queue.empty()) {
@@ -770,6 +951,7 @@ struct Router2
                         bound_pip = fnd_wire->second.first;
 
                     for (PipId uh : ctx->getPipsUphill(curr_data.w)) {
+                        ++pips_seen;
                         if (bound_pip != PipId() && bound_pip != uh)
                             continue;
                         if (is_bb && !hit_test_pip(nd.bb, ctx->getPipLocation(uh)))
@@ -777,7 +959,7 @@ struct Router2
                         if (!ctx->checkPipAvailForNet(uh, net))
                             continue;
                         WireId next = ctx->getPipSrcWire(uh);
-                        int next_idx = wire_to_idx.at(next);
+                        int next_idx = wire_index(next);
                         WireScore next_score;
                         next_score.delay = curr.score.delay + cfg.get_base_cost(ctx, next, uh, crit_weight);
                         next_score.cost = curr.score.cost + score_wire_for_arc(net, i, phys_pin, next, uh, crit_weight);
@@ -799,21 +981,29 @@ struct Router2
                             continue; // thread safety issue
                         set_visited_bwd(t, next_idx, uh, next_score.delay);
                         t.bwd_queue.push(QueuedWire(next_idx, next_score, t.rng.rng()));
+                        ++pushes;
                     }
                 }
             }
             if (midpoint_wire != -1)
                 break;
         }
+        t.stats.explored += pips_seen;
+        t.stats.queue_pushes += pushes;
+        t.stats.queue_pops += explored - 1;
         ArcRouteResult result = ARC_SUCCESS;
         if (midpoint_wire != -1) {
+            ++t.stats.arcs_routed;
+            ++((mode == 0) ? t.stats.mode0_arcs : t.stats.mode1_arcs);
+            if (start_mode == 0 && mode == 1)
+                ++t.stats.fallbacks;
             ROUTE_LOG_DBG("   Routed (explored %d wires): ", explored);
             if (const_mode) {
                 bind_pip_internal(nd, i, midpoint_wire, PipId());
             } else {
                 int cursor_bwd = midpoint_wire;
                 while (was_visited_fwd(cursor_bwd, std::numeric_limits<float>::max())) {
-                    PipId pip = flat_wires.at(cursor_bwd).pip_fwd;
+                    PipId pip = wire_visit.at(cursor_bwd).pip_fwd;
                     if (pip == PipId() && cursor_bwd != src_wire_idx)
                         break;
                     bind_pip_internal(nd, i, cursor_bwd, pip);
@@ -827,7 +1017,7 @@ struct Router2
                     }
                     ROUTE_LOG_DBG("         fwd pip: %s (%d, %d)\n", ctx->nameOfPip(pip), ctx->getPipLocation(pip).x,
                                   ctx->getPipLocation(pip).y);
-                    cursor_bwd = wire_to_idx.at(ctx->getPipSrcWire(pip));
+                    cursor_bwd = wire_index(ctx->getPipSrcWire(pip));
                 }
 
                 while (cursor_bwd != src_wire_idx) {
@@ -845,7 +1035,7 @@ struct Router2
                     bind_pip_internal(nd, i, cursor_bwd, pip);
                     if (pip == PipId())
                         break;
-                    cursor_bwd = wire_to_idx.at(ctx->getPipSrcWire(pip));
+                    cursor_bwd = wire_index(ctx->getPipSrcWire(pip));
                 }
 
                 NPNR_ASSERT(cursor_bwd == src_wire_idx);
@@ -853,13 +1043,13 @@ struct Router2
 
             int cursor_fwd = midpoint_wire;
             while (was_visited_bwd(cursor_fwd, std::numeric_limits<float>::max())) {
-                PipId pip = flat_wires.at(cursor_fwd).pip_bwd;
+                PipId pip = wire_visit.at(cursor_fwd).pip_bwd;
                 if (pip == PipId()) {
                     break;
                 }
                 ROUTE_LOG_DBG("         bwd pip: %s (%d, %d)\n", ctx->nameOfPip(pip), ctx->getPipLocation(pip).x,
                               ctx->getPipLocation(pip).y);
-                cursor_fwd = wire_to_idx.at(ctx->getPipDstWire(pip));
+                cursor_fwd = wire_index(ctx->getPipDstWire(pip));
                 bind_pip_internal(nd, i, cursor_fwd, pip);
                 if (ctx->debug && !is_mt) {
                     auto &wd = flat_wires.at(cursor_fwd);
@@ -908,6 +1098,7 @@ struct Router2
         t.wire_by_loc.clear();
         t.in_wire_by_loc.clear();
         auto &nd = nets.at(net->udata);
+        RouteStats stats_before = t.stats;
         bool failed_slack = false;
         for (auto usr : net->users.enumerate())
             failed_slack |= arc_failed_slack(net, usr.index);
@@ -922,6 +1113,8 @@ struct Router2
                 }
 
                 // Ripup arc to start with
+                if (ad.at(j).routed)
+                    ++t.stats.ripups;
                 ripup_arc(net, usr.index, j);
                 t.route_arcs.emplace_back(usr.index, j);
             }
@@ -966,6 +1159,9 @@ struct Router2
             auto rend = std::chrono::high_resolution_clock::now();
             nets.at(net->udata).total_route_us +=
                     (std::chrono::duration_cast<std::chrono::microseconds>(rend - rstart).count());
+            // Only one thread routes a net at a time, so this is safe
+            nd.stats.add(t.stats);
+            nd.stats.add(stats_before, -1);
         }
         return !have_failures;
     }
@@ -985,6 +1181,8 @@ struct Router2
         failed_nets.clear();
         pool<WireId> already_updated;
         for (size_t i = 0; i < nets.size(); i++) {
+            if (cfg.eco && !net_touched.at(i))
+                continue;
             auto &nd = nets.at(i);
             for (const auto &w : nd.wires) {
                 ++total_wire_use;
@@ -1000,6 +1198,14 @@ struct Router2
                         ++overused_wires;
                     }
                     failed_nets.insert(i);
+                    if (cfg.eco && nd.fail_count >= 2) {
+                        // The other user of the wire might be a net ECO mode hasn't touched, which is still bound in
+                        // the Arch API. If this net couldn't route around it in a couple of tries, rip that one up too
+                        // so the two nets can negotiate for the wire
+                        NetInfo *victim = ctx->getBoundWireNet(w.first);
+                        if (victim != nullptr && victim->udata != int(i) && !net_touched.at(victim->udata))
+                            failed_nets.insert(victim->udata);
+                    }
                 }
             }
         }
@@ -1114,12 +1320,27 @@ struct Router2
         ctx->check();
 
         bool success = true;
+        auto bind_net = [&](NetInfo *net) {
+            // Bind the arcs using the routes we have discovered
+            for (auto usr : net->users.enumerate()) {
+                for (size_t phys_pin = 0; phys_pin < nets.at(net->udata).arcs.at(usr.index.idx()).size(); phys_pin++) {
+                    if (!bind_and_check(net, usr.index, phys_pin)) {
+                        ++arch_fail;
+                        success = false;
+                    }
+                }
+            }
+        };
+        std::vector<NetInfo *> to_bind;
         std::vector<WireId> net_wires;
         for (auto net : nets_by_udata) {
 #ifdef ARCH_ECP5
             if (net->is_global)
                 continue;
 #endif
+            // Nets that ECO mode hasn't touched keep their existing binding
+            if (cfg.eco && !net_touched.at(net->udata))
+                continue;
             // Ripup wires and pips used by the net in nextpnr's structures
             net_wires.clear();
             for (auto &w : net->wires) {
@@ -1136,17 +1357,15 @@ struct Router2
             if (ctx->debug) {
                 log("Ripped up %zu wires on net %s\n", net_wires.size(), ctx->nameOf(net));
             }
-
-            // Bind the arcs using the routes we have discovered
-            for (auto usr : net->users.enumerate()) {
-                for (size_t phys_pin = 0; phys_pin < nets.at(net->udata).arcs.at(usr.index.idx()).size(); phys_pin++) {
-                    if (!bind_and_check(net, usr.index, phys_pin)) {
-                        ++arch_fail;
-                        success = false;
-                    }
-                }
-            }
+            // In ECO mode, a rerouted net may now use a wire that a later net was routed through in the loaded
+            // design, so only bind once all the touched nets are ripped up
+            if (cfg.eco)
+                to_bind.push_back(net);
+            else
+                bind_net(net);
         }
+        for (auto net : to_bind)
+            bind_net(net);
 
         // Check that the arch is still internally consistent!
         ctx->check();
@@ -1160,6 +1379,8 @@ struct Router2
         size_t max_cong = 0;
         // Build histogram
         for (auto &wd : flat_wires) {
+            if (wd.w == WireId())
+                continue; // unused dense index
             size_t val = wd.curr_cong;
             IdString type = ctx->getWireType(wd.w);
             max_cong = std::max(max_cong, val);
@@ -1180,51 +1401,219 @@ struct Router2
         }
     }
 
-    int mid_x = 0, mid_y = 0;
+    // Nodes of a recursive bisection of the device. Nets are assigned to the smallest node that contains their
+    // bounding box; nodes in disjoint subtrees touch disjoint wires, so can be routed concurrently
+    struct PartitionNode
+    {
+        BoundingBox bb;
+        int parent = -1;
+        // Split coordinate and axis; -1 for a leaf
+        int split = -1;
+        bool yaxis = false;
+        std::array<int, 2> children{-1, -1};
+    };
 
-    void partition_nets()
+    // Two trees with alternating first split axis, so nets that cross the first split in one tree are still
+    // multi-threadable in the other
+    std::array<std::vector<PartitionNode>, 2> part_trees;
+
+    int build_partition(std::vector<PartitionNode> &tree, int parent, BoundingBox bb, bool yaxis, int depth,
+                        std::vector<Loc>::iterator begin, std::vector<Loc>::iterator end)
     {
-        // Create a histogram of positions in X and Y positions
-        std::map<int, int> cxs, cys;
-        for (auto &n : nets) {
-            if (n.cx != -1)
-                ++cxs[n.cx];
-            if (n.cy != -1)
-                ++cys[n.cy];
+        int idx = int(tree.size());
+        tree.emplace_back();
+        tree.at(idx).bb = bb;
+        tree.at(idx).parent = parent;
+        if (depth == 0 || (end - begin) < 2)
+            return idx;
+        // Split at the median net centre, so each side gets roughly the same number of nets
+        auto mid = begin + (end - begin) / 2;
+        std::nth_element(begin, mid, end,
+                         [&](const Loc &a, const Loc &b) { return yaxis ? (a.y < b.y) : (a.x < b.x); });
+        int split = yaxis ? mid->y : mid->x;
+        if (split <= (yaxis ? bb.y0 : bb.x0) || split > (yaxis ? bb.y1 : bb.x1))
+            return idx;
+        auto right_begin = std::partition(begin, end, [&](const Loc &l) { return (yaxis ? l.y : l.x) < split; });
+        BoundingBox lbb = bb, rbb = bb;
+        if (yaxis) {
+            lbb.y1 = split - 1;
+            rbb.y0 = split;
+        } else {
+            lbb.x1 = split - 1;
+            rbb.x0 = split;
+        }
+        tree.at(idx).split = split;
+        tree.at(idx).yaxis = yaxis;
+        int left = build_partition(tree, idx, lbb, !yaxis, depth - 1, begin, right_begin);
+        int right = build_partition(tree, idx, rbb, !yaxis, depth - 1, right_begin, end);
+        tree.at(idx).children = {left, right};
+        return idx;
+    }
+
+    int find_partition(const std::vector<PartitionNode> &tree, const BoundingBox &bb)
+    {
+        int node = 0;
+        while (tree.at(node).split != -1) {
+            auto &pn = tree.at(node);
+            int lo = pn.yaxis ? bb.y0 : bb.x0, hi = pn.yaxis ? bb.y1 : bb.x1;
+            if (hi < pn.split)
+                node = pn.children.at(0);
+            else if (lo >= pn.split)
+                node = pn.children.at(1);
+            else
+                break;
         }
-        // 4-way split for now
-        int accum_x = 0, accum_y = 0;
-        int halfway = int(nets.size()) / 2;
-        for (auto &p : cxs) {
-            if (accum_x < halfway && (accum_x + p.second) >= halfway)
-                mid_x = p.first;
-            accum_x += p.second;
+        return node;
+    }
+
+    void partition_nets()
+    {
+        // Build partition trees with enough leaves to keep all threads busy
+        int depth = cfg.partition_depth;
+        if (depth < 0) {
+            depth = 2;
+            while ((1 << depth) < cfg.threads)
+                ++depth;
         }
-        for (auto &p : cys) {
-            if (accum_y < halfway && (accum_y + p.second) >= halfway)
-                mid_y = p.first;
-            accum_y += p.second;
+        std::vector<Loc> centres;
+        for (auto &n : nets)
+            if (n.cx != -1 && n.cy != -1)
+                centres.emplace_back(n.cx, n.cy, 0);
+        BoundingBox all(0, 0, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+        for (int i = 0; i < 2; i++) {
+            part_trees.at(i).clear();
+            build_partition(part_trees.at(i), -1, all, /*yaxis=*/i == 1, depth, centres.begin(), centres.end());
         }
         if (ctx->verbose) {
-            log_info("    x splitpoint: %d\n", mid_x);
-            log_info("    y splitpoint: %d\n", mid_y);
+            for (int i = 0; i < 2; i++) {
+                std::vector<int> bins(part_trees.at(i).size(), 0);
+                for (auto &n : nets)
+                    ++bins.at(find_partition(part_trees.at(i), n.bb));
+                log_info("    partition tree %d (%c first):\n", i, (i == 1) ? 'y' : 'x');
+                for (size_t j = 0; j < bins.size(); j++) {
+                    auto &pn = part_trees.at(i).at(j);
+                    log_info("        node %d parent=%d split=%c%d N=%d\n", int(j), pn.parent,
+                             pn.yaxis ? 'y' : 'x', pn.split, bins.at(j));
+                }
+            }
         }
-        std::vector<int> bins(5, 0);
-        for (auto &n : nets) {
-            if (n.bb.x0 < mid_x && n.bb.x1 < mid_x && n.bb.y0 < mid_y && n.bb.y1 < mid_y)
-                ++bins[0]; // TL
-            else if (n.bb.x0 >= mid_x && n.bb.x1 >= mid_x && n.bb.y0 < mid_y && n.bb.y1 < mid_y)
-                ++bins[1]; // TR
-            else if (n.bb.x0 < mid_x && n.bb.x1 < mid_x && n.bb.y0 >= mid_y && n.bb.y1 >= mid_y)
-                ++bins[2]; // BL
-            else if (n.bb.x0 >= mid_x && n.bb.x1 >= mid_x && n.bb.y0 >= mid_y && n.bb.y1 >= mid_y)
-                ++bins[3]; // BR
-            else
-                ++bins[4]; // cross-boundary
+    }
+
+    // Telemetry for perfProfile and the Chrome trace (router2/trace): one event per routing task, and per phase of the
+    // main loop
+    struct PhaseEvent
+    {
+        std::string name;
+        // "partition" for routing inside a partition node, "serial" for routing on one thread, "main" for the rest
+        const char *cat;
+        int iter, tid;
+        int64_t start_us, dur_us;
+        int nets;
+        RouteStats stats;
+    };
+    struct IterCounters
+    {
+        int iter;
+        int64_t time_us;
+        int wires, overused, overuse;
+    };
+    typedef std::chrono::high_resolution_clock::time_point time_point;
+    bool telemetry = false;
+    int route_iter = 0;
+    time_point telemetry_start;
+    std::mutex phase_mutex;
+    std::map<std::thread::id, int> phase_tids;
+    std::vector<PhaseEvent> phases;
+    std::vector<IterCounters> iter_counters;
+
+    int64_t telemetry_us(time_point t) const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(t - telemetry_start).count();
+    }
+
+    void record_phase(const std::string &name, const char *cat, time_point start, int nets, const RouteStats &stats)
+    {
+        if (!telemetry)
+            return;
+        auto end = std::chrono::high_resolution_clock::now();
+        std::lock_guard<std::mutex> lock(phase_mutex);
+        int tid = phase_tids.emplace(std::this_thread::get_id(), int(phase_tids.size())).first->second;
+        int64_t dur_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        phases.push_back(PhaseEvent{name, cat, route_iter, tid, telemetry_us(start), dur_us, nets, stats});
+    }
+
+    void record_phase(const std::string &name, const char *cat, time_point start, int nets = 0)
+    {
+        record_phase(name, cat, start, nets, RouteStats());
+    }
+
+    void log_iter_telemetry()
+    {
+        RouteStats total;
+        int64_t par_start = std::numeric_limits<int64_t>::max(), par_end = 0, serial_us = 0, busy_us = 0;
+        std::vector<int64_t> thread_busy_us(phase_tids.size(), 0);
+        for (auto &ev : phases) {
+            if (ev.iter != route_iter || ev.cat == std::string("main"))
+                continue;
+            total.add(ev.stats);
+            if (ev.cat == std::string("partition")) {
+                par_start = std::min(par_start, ev.start_us);
+                par_end = std::max(par_end, ev.start_us + ev.dur_us);
+                thread_busy_us.at(ev.tid) += ev.dur_us;
+                busy_us += ev.dur_us;
+            } else {
+                serial_us += ev.dur_us;
+            }
         }
-        if (ctx->verbose)
-            for (int i = 0; i < 5; i++)
-                log_info("        bin %d N=%d\n", i, bins[i]);
+        int threads = ctx->threadPool().size();
+        int64_t par_us = std::max<int64_t>(par_end - par_start, 0);
+        log_info("        parallel %.1fms (idle %.0f%% of %d threads), serial %.1fms; explored=%lld pushes=%lld "
+                 "pops=%lld arcs=%d ripups=%d fallbacks=%d\n",
+                 par_us / 1000.0, par_us > 0 ? 100.0 * (1.0 - double(busy_us) / (par_us * threads)) : 0.0, threads,
+                 serial_us / 1000.0, (long long)total.explored, (long long)total.queue_pushes,
+                 (long long)total.queue_pops, total.arcs_routed, total.ripups, total.fallbacks);
+        if (par_us > 0) {
+            std::string busy;
+            for (auto t : thread_busy_us)
+                busy += stringf(" %.1f", t / 1000.0);
+            log_info("        busy ms per thread:%s\n", busy.c_str());
+        }
+    }
+
+    void write_trace(std::ostream &out)
+    {
+        // Chrome trace event format, see chrome://tracing or https://ui.perfetto.dev
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+        bool first = true;
+        auto sep = [&]() {
+            if (!first)
+                out << "," << std::endl;
+            first = false;
+        };
+        for (auto &tid : phase_tids) {
+            sep();
+            out << stringf("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %d, \"args\": {\"name\": "
+                           "\"%s\"}}",
+                           tid.second, tid.second == 0 ? "main" : stringf("thread %d", tid.second).c_str());
+        }
+        for (auto &ev : phases) {
+            sep();
+            out << stringf("{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, \"ts\": %lld, "
+                           "\"dur\": %lld, \"args\": {\"iter\": %d, \"nets\": %d, \"arcs\": %d, \"explored\": %lld, "
+                           "\"pushes\": %lld, \"pops\": %lld, \"ripups\": %d, \"mode0\": %d, \"mode1\": %d, "
+                           "\"fallbacks\": %d}}",
+                           ev.name.c_str(), ev.cat, ev.tid, (long long)ev.start_us, (long long)ev.dur_us, ev.iter,
+                           ev.nets, ev.stats.arcs_routed, (long long)ev.stats.explored,
+                           (long long)ev.stats.queue_pushes, (long long)ev.stats.queue_pops, ev.stats.ripups,
+                           ev.stats.mode0_arcs, ev.stats.mode1_arcs, ev.stats.fallbacks);
+        }
+        for (auto &ic : iter_counters) {
+            sep();
+            out << stringf("{\"name\": \"congestion\", \"ph\": \"C\", \"pid\": 0, \"ts\": %lld, \"args\": "
+                           "{\"wires\": %d, \"overused\": %d, \"overuse\": %d}}",
+                           (long long)ic.time_us, ic.wires, ic.overused, ic.overuse);
+        }
+        out << std::endl << "]}" << std::endl;
     }
 
     void router_thread(ThreadContext &t, bool is_mt)
@@ -1236,115 +1625,103 @@ struct Router2
         }
     }
 
+    // Route the nets that fit inside a non-root node of a partition tree on the thread pool. A node becomes ready once
+    // both its children are done. Nets that only fit inside the root are returned in `leftover`; nets that failed
+    // inside their partition in `failed`.
+    void route_partition_tree(int tree_idx, const std::vector<int> &queue, std::vector<int> &leftover,
+                              std::vector<NetInfo *> &failed)
+    {
+        const auto &tree = part_trees.at(tree_idx);
+        std::vector<ThreadContext> tcs(tree.size());
+        std::vector<int> work(tree.size(), 0);
+        for (size_t i = 0; i < tree.size(); i++) {
+            tcs.at(i).rng.rngseed(ctx->rng64());
+            tcs.at(i).bb = tree.at(i).bb;
+        }
+        for (int n : queue) {
+            int node = find_partition(tree, nets.at(n).bb);
+            if (node == 0) {
+                leftover.push_back(n);
+            } else {
+                NetInfo *ni = nets_by_udata.at(n);
+                tcs.at(node).route_nets.push_back(ni);
+                work.at(node) += int(ni->users.entries());
+            }
+        }
+        // Leaves are queued largest first; a parent is queued by whichever of its children finishes last
+        TaskGroup group(ctx->threadPool());
+        std::mutex mutex;
+        std::vector<int> pending(tree.size(), 0), leaves;
+        std::function<void(int)> route_node = [&](int node) {
+            auto start = std::chrono::high_resolution_clock::now();
+            router_thread(tcs.at(node), /*is_mt=*/true);
+            record_phase(stringf("tree %d node %d", tree_idx, node), "partition", start,
+                         int(tcs.at(node).route_nets.size()), tcs.at(node).stats);
+            int parent = tree.at(node).parent;
+            if (parent <= 0)
+                return;
+            bool parent_ready;
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                parent_ready = (--pending.at(parent) == 0);
+            }
+            if (parent_ready)
+                group.run([&route_node, parent]() { route_node(parent); });
+        };
+        for (int i = 1; i < int(tree.size()); i++) {
+            if (tree.at(i).split == -1)
+                leaves.push_back(i);
+            else
+                pending.at(i) = 2;
+        }
+        std::stable_sort(leaves.begin(), leaves.end(), [&](int a, int b) { return work.at(a) > work.at(b); });
+        for (int leaf : leaves)
+            group.run([&route_node, leaf]() { route_node(leaf); });
+        group.wait();
+        for (size_t i = 1; i < tree.size(); i++)
+            for (auto fail : tcs.at(i).failed_nets)
+                failed.push_back(fail);
+    }
+
     void do_route()
     {
+        ThreadContext st;
+        st.rng.rngseed(ctx->rng64());
+        st.bb = BoundingBox(0, 0, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
         // Don't multithread if fewer than 200 nets (heuristic)
-        if (route_queue.size() < 200) {
-            ThreadContext st;
-            st.rng.rngseed(ctx->rng64());
-            st.bb = BoundingBox(0, 0, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+        auto start = std::chrono::high_resolution_clock::now();
+        if (route_queue.size() < 200 || cfg.threads <= 1) {
             for (size_t j = 0; j < route_queue.size(); j++) {
                 route_net(st, nets_by_udata[route_queue[j]], false);
             }
+            record_phase("all nets", "serial", start, int(route_queue.size()), st.stats);
             return;
         }
-        const int Nq = 4, Nv = 2, Nh = 2;
-        const int N = Nq + Nv + Nh;
-        std::vector<ThreadContext> tcs(N + 1);
-        for (auto &th : tcs) {
-            th.rng.rngseed(ctx->rng64());
-        }
-        int le_x = mid_x;
-        int rs_x = mid_x;
-        int le_y = mid_y;
-        int rs_y = mid_y;
-        // Set up thread bounding boxes
-        tcs.at(0).bb = BoundingBox(0, 0, mid_x, mid_y);
-        tcs.at(1).bb = BoundingBox(mid_x + 1, 0, std::numeric_limits<int>::max(), le_y);
-        tcs.at(2).bb = BoundingBox(0, mid_y + 1, mid_x, std::numeric_limits<int>::max());
-        tcs.at(3).bb =
-                BoundingBox(mid_x + 1, mid_y + 1, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
-
-        tcs.at(4).bb = BoundingBox(0, 0, std::numeric_limits<int>::max(), mid_y);
-        tcs.at(5).bb = BoundingBox(0, mid_y + 1, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
-
-        tcs.at(6).bb = BoundingBox(0, 0, mid_x, std::numeric_limits<int>::max());
-        tcs.at(7).bb = BoundingBox(mid_x + 1, 0, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
-
-        tcs.at(8).bb = BoundingBox(0, 0, std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
-
-        for (auto n : route_queue) {
-            auto &nd = nets.at(n);
-            auto ni = nets_by_udata.at(n);
-            int bin = N;
-            // Quadrants
-            if (nd.bb.x0 < le_x && nd.bb.x1 < le_x && nd.bb.y0 < le_y && nd.bb.y1 < le_y)
-                bin = 0;
-            else if (nd.bb.x0 >= rs_x && nd.bb.x1 >= rs_x && nd.bb.y0 < le_y && nd.bb.y1 < le_y)
-                bin = 1;
-            else if (nd.bb.x0 < le_x && nd.bb.x1 < le_x && nd.bb.y0 >= rs_y && nd.bb.y1 >= rs_y)
-                bin = 2;
-            else if (nd.bb.x0 >= rs_x && nd.bb.x1 >= rs_x && nd.bb.y0 >= rs_y && nd.bb.y1 >= rs_y)
-                bin = 3;
-            // Vertical split
-            else if (nd.bb.y0 < le_y && nd.bb.y1 < le_y)
-                bin = Nq + 0;
-            else if (nd.bb.y0 >= rs_y && nd.bb.y1 >= rs_y)
-                bin = Nq + 1;
-            // Horizontal split
-            else if (nd.bb.x0 < le_x && nd.bb.x1 < le_x)
-                bin = Nq + Nv + 0;
-            else if (nd.bb.x0 >= rs_x && nd.bb.x1 >= rs_x)
-                bin = Nq + Nv + 1;
-            tcs.at(bin).route_nets.push_back(ni);
+        if (lazy_wires && !all_wires_set_up) {
+            // Threads find the wires they may touch from their location, so all of them have to be set up first
+            for (auto wire : ctx->getWires())
+                wire_index(wire);
+            all_wires_set_up = true;
         }
+        std::vector<int> cross_first, cross_both;
+        std::vector<NetInfo *> failed;
+        route_partition_tree(0, route_queue, cross_first, failed);
+        route_partition_tree(1, cross_first, cross_both, failed);
         if (ctx->verbose)
-            log_info("%d/%d nets not multi-threadable\n", int(tcs.at(N).route_nets.size()), int(route_queue.size()));
-#ifdef NPNR_DISABLE_THREADS
-        // Singlethreaded routing - quadrants
-        for (int i = 0; i < Nq; i++) {
-            router_thread(tcs.at(i), /*is_mt=*/false);
-        }
-        // Vertical splits
-        for (int i = Nq; i < Nq + Nv; i++) {
-            router_thread(tcs.at(i), /*is_mt=*/false);
-        }
-        // Horizontal splits
-        for (int i = Nq + Nv; i < Nq + Nv + Nh; i++) {
-            router_thread(tcs.at(i), /*is_mt=*/false);
-        }
-#else
-        // Multithreaded part of routing - quadrants
-        std::vector<boost::thread> threads;
-        for (int i = 0; i < Nq; i++) {
-            threads.emplace_back([this, &tcs, i]() { router_thread(tcs.at(i), /*is_mt=*/true); });
-        }
-        for (auto &t : threads)
-            t.join();
-        threads.clear();
-        // Vertical splits
-        for (int i = Nq; i < Nq + Nv; i++) {
-            threads.emplace_back([this, &tcs, i]() { router_thread(tcs.at(i), /*is_mt=*/true); });
-        }
-        for (auto &t : threads)
-            t.join();
-        threads.clear();
-        // Horizontal splits
-        for (int i = Nq + Nv; i < Nq + Nv + Nh; i++) {
-            threads.emplace_back([this, &tcs, i]() { router_thread(tcs.at(i), /*is_mt=*/true); });
-        }
-        for (auto &t : threads)
-            t.join();
-        threads.clear();
-#endif
+            log_info("%d/%d nets not multi-threadable\n", int(cross_both.size()), int(route_queue.size()));
         // Singlethreaded part of routing - nets that cross partitions
         // or don't fit within bounding box
-        for (auto st_net : tcs.at(N).route_nets)
-            route_net(tcs.at(N), st_net, false);
+        start = std::chrono::high_resolution_clock::now();
+        for (int st_net : cross_both)
+            route_net(st, nets_by_udata.at(st_net), false);
+        record_phase("cross-partition nets", "serial", start, int(cross_both.size()), st.stats);
         // Failed nets
-        for (int i = 0; i < N; i++)
-            for (auto fail : tcs.at(i).failed_nets)
-                route_net(tcs.at(N), fail, false);
+        start = std::chrono::high_resolution_clock::now();
+        RouteStats before_failed = st.stats;
+        for (auto fail : failed)
+            route_net(st, fail, false);
+        st.stats.add(before_failed, -1);
+        record_phase("failed nets", "serial", start, int(failed.size()), st.stats);
     }
 
     delay_t get_route_delay(int net, store_index<PortRef> usr_idx, int phys_idx)
@@ -1395,8 +1772,12 @@ struct Router2
         log_info("Setting up routing resources...\n");
         auto rstart = std::chrono::high_resolution_clock::now();
         setup_nets();
-        setup_wires();
-        find_all_reserved_wires();
+        if (cfg.eco) {
+            setup_eco();
+        } else {
+            setup_wires();
+            find_all_reserved_wires(nets_by_udata);
+        }
         partition_nets();
         curr_cong_weight = cfg.init_curr_cong_weight;
         hist_cong_weight = cfg.hist_cong_weight;
@@ -1405,8 +1786,9 @@ struct Router2
 
         ScopeLock<Context> lock(ctx);
 
-        for (size_t i = 0; i < nets_by_udata.size(); i++)
-            route_queue.push_back(i);
+        if (!cfg.eco)
+            for (size_t i = 0; i < nets_by_udata.size(); i++)
+                queue_net(i);
 
         timing_driven = ctx->setting<bool>("timing_driven");
         if (ctx->settings.count(ctx->id("router/tmg_ripup")))
@@ -1414,9 +1796,14 @@ struct Router2
         else
             timing_driven_ripup = false;
         log_info("Running main router loop...\n");
+        telemetry = cfg.perf_profile || !cfg.trace.empty();
+        telemetry_start = std::chrono::high_resolution_clock::now();
+        phase_tids.emplace(std::this_thread::get_id(), 0);
         if (timing_driven)
             tmg.run(true);
         do {
+            route_iter = iter;
+            auto phase_start = std::chrono::high_resolution_clock::now();
             ctx->sorted_shuffle(route_queue);
 
             if (timing_driven && int(route_queue.size()) >= 30) {
@@ -1433,10 +1820,15 @@ struct Router2
                                  [&](int na, int nb) { return nets.at(na).max_crit > nets.at(nb).max_crit; });
             }
 
+            record_phase("sort queue", "main", phase_start);
+            phase_start = std::chrono::high_resolution_clock::now();
             do_route();
+            record_phase("route", "main", phase_start, int(route_queue.size()));
+            phase_start = std::chrono::high_resolution_clock::now();
             update_route_delays();
             route_queue.clear();
             update_congestion();
+            record_phase("update congestion", "main", phase_start);
 
             if (!cfg.heatmap.empty()) {
                 std::string filename(cfg.heatmap + "_" + std::to_string(iter) + ".csv");
@@ -1447,8 +1839,10 @@ struct Router2
                 log_info("        wrote wiretype heatmap to %s.\n", filename.c_str());
             }
             int tmgfail = 0;
+            phase_start = std::chrono::high_resolution_clock::now();
             if (timing_driven)
                 tmg.run(false);
+            record_phase("timing", "main", phase_start);
             if (timing_driven_ripup && iter < 1500) {
                 for (size_t i = 0; i < nets_by_udata.size(); i++) {
                     NetInfo *ni = nets_by_udata.at(i);
@@ -1462,10 +1856,12 @@ struct Router2
             }
             if (overused_wires == 0 && tmgfail == 0) {
                 // Try and actually bind nextpnr Arch API wires
+                phase_start = std::chrono::high_resolution_clock::now();
                 bind_and_check_all();
+                record_phase("bind", "main", phase_start);
             }
             for (auto cn : failed_nets)
-                route_queue.push_back(cn);
+                queue_net(cn);
             if (timing_driven_ripup)
                 log_info("    iter=%d wires=%d overused=%d overuse=%d tmgfail=%d archfail=%s\n", iter, total_wire_use,
                          overused_wires, total_overuse, tmgfail,
@@ -1474,6 +1870,11 @@ struct Router2
                 log_info("    iter=%d wires=%d overused=%d overuse=%d archfail=%s\n", iter, total_wire_use,
                          overused_wires, total_overuse,
                          (overused_wires > 0 || tmgfail > 0) ? "NA" : std::to_string(arch_fail).c_str());
+            if (telemetry)
+                iter_counters.push_back(IterCounters{iter, telemetry_us(std::chrono::high_resolution_clock::now()),
+                                                     total_wire_use, overused_wires, total_overuse});
+            if (cfg.perf_profile)
+                log_iter_telemetry();
             ++iter;
             if (curr_cong_weight < 1e9)
                 curr_cong_weight += cfg.curr_cong_mult;
@@ -1484,17 +1885,49 @@ struct Router2
                 nets_by_runtime.emplace_back(nets.at(n->udata).total_route_us, n->name);
             }
             std::sort(nets_by_runtime.begin(), nets_by_runtime.end(), std::greater<std::pair<int, IdString>>());
-            log_info("1000 slowest nets by runtime:\n");
+            log_info("1000 slowest nets by runtime (with explored pips per wire used, arcs routed in mode 0/1 and "
+                     "fallbacks from mode 0):\n");
             for (int i = 0; i < std::min(int(nets_by_runtime.size()), 1000); i++) {
-                log("        %80s %6d %.1fms\n", nets_by_runtime.at(i).second.c_str(ctx),
-                    int(ctx->nets.at(nets_by_runtime.at(i).second)->users.entries()),
-                    nets_by_runtime.at(i).first / 1000.0);
+                const NetInfo *ni = ctx->nets.at(nets_by_runtime.at(i).second).get();
+                const auto &nd = nets.at(ni->udata);
+                double explored_per_wire = nd.stats.explored / double(std::max<size_t>(nd.wires.size(), 1));
+                log("        %80s %6d %.1fms %8.1f %6d %6d %6d\n", ni->name.c_str(ctx), int(ni->users.entries()),
+                    nets_by_runtime.at(i).first / 1000.0, explored_per_wire, nd.stats.mode0_arcs, nd.stats.mode1_arcs,
+                    nd.stats.fallbacks);
             }
         }
+        if (!cfg.trace.empty()) {
+            std::ofstream trace_file(cfg.trace);
+            if (!trace_file)
+                log_error("Failed to open router2 trace %s for writing.\n", cfg.trace.c_str());
+            write_trace(trace_file);
+            log_info("Wrote router2 trace to %s.\n", cfg.trace.c_str());
+        }
         auto rend = std::chrono::high_resolution_clock::now();
         log_info("Router2 time %.02fs\n", std::chrono::duration<float>(rend - rstart).count());
 
-        log_info("Running router1 to check that route is legal...\n");
+        log_info("Checking that route is legal...\n");
+        std::vector<NetInfo *> illegal_nets;
+        if (ctx->checkRoutedDesign(&illegal_nets)) {
+            log_info("Checksum: 0x%08x\n", ctx->checksum());
+            timing_analysis(ctx, true /* slack_histogram */, true /* print_fmax */, true /* print_path */,
+                            true /* warn_on_failure */, true /* update_results */);
+            return;
+        }
+
+        // Leave only the nets that failed the check for router1 to fix up
+        log_info("%d nets failed the check, running router1 on them...\n", int(illegal_nets.size()));
+        std::vector<WireId> net_wires;
+        for (auto net : illegal_nets) {
+            if (ctx->debug)
+                log("Ripping up net %s\n", ctx->nameOf(net));
+            net_wires.clear();
+            for (auto &w : net->wires)
+                if (w.second.strength <= STRENGTH_STRONG)
+                    net_wires.push_back(w.first);
+            for (auto w : net_wires)
+                ctx->unbindWire(w);
+        }
 
         lock.unlock_early();
 
@@ -1529,11 +1962,20 @@ Router2Cfg::Router2Cfg(Context *ctx)
         curr_cong_mult = ctx->setting<float>("router2/currCongWeightMult", 2.0f);
         estimate_weight = ctx->setting<float>("router2/estimateWeight", 1.25f);
     }
+    threads = ctx->setting<int>("threads", 8);
+    partition_depth = ctx->setting<int>("router2/partitionDepth", -1);
     perf_profile = ctx->setting<bool>("router2/perfProfile", false);
+    // Not recorded in the settings when unset, as they are saved with the routed design that an ECO run starts from
+    if (ctx->settings.count(ctx->id("router2/eco")))
+        eco = ctx->setting<bool>("router2/eco");
     if (ctx->settings.count(ctx->id("router2/heatmap")))
         heatmap = ctx->settings.at(ctx->id("router2/heatmap")).as_string();
     else
         heatmap = "";
+    if (ctx->settings.count(ctx->id("router2/trace")))
+        trace = ctx->settings.at(ctx->id("router2/trace")).as_string();
+    else
+        trace = "";
 }
 
 NEXTPNR_NAMESPACE_END
@@ -54,10 +54,22 @@ struct Router2Cfg
     // of choosing a less congestion/delay-optimal route
     float estimate_weight;
 
+    // Maximum number of threads used to route partitions in parallel
+    int threads;
+    // Depth of the recursive bisection used to partition nets between threads;
+    // -1 picks the smallest depth with at least as many leaves as threads
+    int partition_depth;
+
     // Print additional performance profiling information
     bool perf_profile = false;
 
+    // Incremental (ECO) mode: keep the existing routing of arcs that are still legal, and only route the nets left with
+    // unrouted arcs by a netlist or placement change, plus any nets they end up fighting with for wires
+    bool eco = false;
+
     std::string heatmap;
+    // File to write a Chrome trace event JSON of the routing phases on each thread to, if not empty
+    std::string trace;
     std::function<float(Context *ctx, WireId wire, PipId pip, float crit_weight)> get_base_cost = default_base_cost;
 };
 
@@ -0,0 +1,456 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "router_lookahead.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <queue>
+
+#include "deterministic_rng.h"
+#include "log.h"
+#include "nextpnr.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+namespace {
+
+// Bump whenever the file layout or the way the tables are built changes
+static constexpr uint32_t lookahead_version = 2;
+static const char lookahead_magic[8] = {'N', 'P', 'N', 'R', 'L', 'K', 'A', 'H'};
+
+// The cache file is this header, followed by the int32 table ([src class][dst class][dy][dx]), the int32 slopes
+// ([src class][dst class]) and finally the NUL-terminated wire type names in table class order
+struct CacheHeader
+{
+    char magic[8];
+    uint32_t version;
+    int32_t radius;
+    uint64_t key;
+    // Size and checksum of the chipdb blob the tables were built from
+    uint64_t chipdb_size;
+    uint64_t chipdb_checksum;
+    uint32_t num_classes;
+    uint32_t names_size;
+};
+
+struct KeyHasher
+{
+    // FNV-1a; only needs to be stable across runs, not strong
+    uint64_t value = 0xcbf29ce484222325ULL;
+    void add(const void *data, size_t size)
+    {
+        auto bytes = reinterpret_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < size; i++) {
+            value ^= bytes[i];
+            value *= 0x100000001b3ULL;
+        }
+    }
+    void add(const std::string &str) { add(str.c_str(), str.size() + 1); }
+    void add(int64_t x) { add(&x, sizeof(x)); }
+};
+
+// Checksum of a whole chipdb blob, a word at a time as these run to tens of megabytes
+uint64_t blob_checksum(const void *data, size_t size)
+{
+    auto bytes = reinterpret_cast<const uint8_t *>(data);
+    uint64_t value = 0x9e3779b97f4a7c15ULL ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        value = (value ^ word) * 0xff51afd7ed558ccdULL;
+        value ^= value >> 32;
+    }
+    for (; i < size; i++)
+        value = (value ^ bytes[i]) * 0x100000001b3ULL;
+    return value;
+}
+
+std::string default_cache_dir()
+{
+    const char *xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg != nullptr && xdg[0] != '\0')
+        return (boost::filesystem::path(xdg) / "nextpnr").string();
+#if defined(_WIN32)
+    const char *home = std::getenv("LOCALAPPDATA");
+    if (home != nullptr && home[0] != '\0')
+        return (boost::filesystem::path(home) / "nextpnr").string();
+#else
+    const char *home = std::getenv("HOME");
+    if (home != nullptr && home[0] != '\0')
+        return (boost::filesystem::path(home) / ".cache" / "nextpnr").string();
+#endif
+    return "";
+}
+
+} // namespace
+
+RouterLookaheadCfg::RouterLookaheadCfg(Context *ctx)
+{
+    enabled = ctx->setting<bool>("router/lookahead", false);
+    radius = ctx->setting<int>("router/lookahead/radius", 12);
+    samples = ctx->setting<int>("router/lookahead/samples", 4);
+    threads = ctx->setting<int>("threads", 8);
+    if (ctx->settings.count(ctx->id("router/lookahead/cache")))
+        cache_file = ctx->settings.at(ctx->id("router/lookahead/cache")).as_string();
+    else
+        cache_file = "";
+    rebuild = ctx->setting<bool>("router/lookahead/rebuild", false);
+}
+
+void RouterLookahead::init(Context *ctx, const std::string &chipdb_key, const void *chipdb, size_t chipdb_size)
+{
+    // Already set up by a previous call (e.g. routing twice from a script)
+    if (ready() && this->ctx == ctx)
+        return;
+    this->ctx = ctx;
+    table = nullptr;
+    slope = nullptr;
+
+    RouterLookaheadCfg cfg(ctx);
+    if (!cfg.enabled)
+        return;
+    if (ctx->getWireIndexCount() == 0) {
+        log_warning("Router lookahead needs dense wire indices, which this architecture doesn't provide; "
+                    "using the default estimate instead.\n");
+        return;
+    }
+    radius = std::max(1, cfg.radius);
+    side = 2 * radius + 1;
+    setup_wires();
+    this->chipdb_size = (chipdb != nullptr) ? chipdb_size : 0;
+    chipdb_checksum = (this->chipdb_size != 0) ? blob_checksum(chipdb, chipdb_size) : 0;
+
+    uint64_t key = compute_key(chipdb_key, cfg);
+    std::string filename = cfg.cache_file;
+    if (filename.empty() && this->chipdb_size == 0) {
+        // Without the chipdb contents a cache could silently outlive a rebuilt chipdb, so only use one if asked to
+        log_info("Chipdb size is not known, so the router lookahead is not cached by default.\n");
+    } else if (filename.empty()) {
+        std::string dir = default_cache_dir();
+        if (!dir.empty())
+            filename = (boost::filesystem::path(dir) / stringf("lookahead-%016llx.bin", (unsigned long long)key))
+                               .string();
+    }
+    if (!cfg.rebuild && !filename.empty() && read_cache(filename, key)) {
+        log_info("Loaded router lookahead from '%s'.\n", filename.c_str());
+        return;
+    }
+    build(cfg);
+    if (!filename.empty())
+        write_cache(filename, key);
+}
+
+void RouterLookahead::setup_wires()
+{
+    int wire_count = ctx->getWireIndexCount();
+    wire_x.assign(wire_count, 0);
+    wire_y.assign(wire_count, 0);
+    wire_class.assign(wire_count, -1);
+    classes.clear();
+    dict<IdString, int> class_idx;
+    for (auto wire : ctx->getWires()) {
+        int idx = ctx->getWireIndex(wire);
+        NPNR_ASSERT(idx >= 0 && idx < wire_count);
+        // Use the same notion of wire location as router2
+        BoundingBox wire_loc = ctx->getRouteBoundingBox(wire, wire);
+        wire_x.at(idx) = (wire_loc.x0 + wire_loc.x1) / 2;
+        wire_y.at(idx) = (wire_loc.y0 + wire_loc.y1) / 2;
+        IdString type = ctx->getWireType(wire);
+        auto fnd = class_idx.find(type);
+        if (fnd == class_idx.end()) {
+            fnd = class_idx.emplace(type, int(classes.size())).first;
+            classes.push_back(type);
+        }
+        wire_class.at(idx) = fnd->second;
+    }
+    class_map.resize(classes.size());
+    for (int i = 0; i < int(classes.size()); i++)
+        class_map.at(i) = i;
+}
+
+uint64_t RouterLookahead::compute_key(const std::string &chipdb_key, const RouterLookaheadCfg &cfg) const
+{
+    KeyHasher hash;
+    hash.add(int64_t(lookahead_version));
+    hash.add(chipdb_key);
+    hash.add(int64_t(chipdb_size));
+    hash.add(int64_t(chipdb_checksum));
+    hash.add(int64_t(radius));
+    hash.add(int64_t(cfg.samples));
+    hash.add(int64_t(wire_class.size()));
+    // Catch chipdb changes that the arch-provided key doesn't reflect
+    std::vector<int64_t> class_count(classes.size());
+    for (auto cls : wire_class)
+        if (cls != -1)
+            ++class_count.at(cls);
+    for (int i = 0; i < int(classes.size()); i++) {
+        hash.add(classes.at(i).str(ctx));
+        hash.add(class_count.at(i));
+    }
+    return hash.value;
+}
+
+void RouterLookahead::build(const RouterLookaheadCfg &cfg)
+{
+    auto rstart = std::chrono::high_resolution_clock::now();
+    int wire_count = int(wire_class.size());
+    int num_classes = int(classes.size());
+    std::vector<WireId> idx_to_wire(wire_count);
+    for (auto wire : ctx->getWires())
+        idx_to_wire.at(ctx->getWireIndex(wire)) = wire;
+
+    int max_x = 0, max_y = 0;
+    for (int i = 0; i < wire_count; i++) {
+        max_x = std::max<int>(max_x, wire_x.at(i));
+        max_y = std::max<int>(max_y, wire_y.at(i));
+    }
+
+    // Pick the source wires for each class; wires far enough from the edge of the device that the whole window
+    // can be explored are preferred
+    std::vector<std::vector<int>> sources(num_classes);
+    for (int i = 0; i < wire_count; i++) {
+        if (wire_class.at(i) == -1)
+            continue;
+        auto pips = ctx->getPipsDownhill(idx_to_wire.at(i));
+        if (pips.begin() != pips.end())
+            sources.at(wire_class.at(i)).push_back(i);
+    }
+    DeterministicRNG rng;
+    for (auto &src : sources) {
+        rng.shuffle(src);
+        std::stable_partition(src.begin(), src.end(), [&](int i) {
+            return wire_x.at(i) >= radius && wire_x.at(i) <= (max_x - radius) && wire_y.at(i) >= radius &&
+                   wire_y.at(i) <= (max_y - radius);
+        });
+        if (int(src.size()) > cfg.samples)
+            src.resize(cfg.samples);
+    }
+
+    log_info("Building router lookahead for %d wire types...\n", num_classes);
+    int table_size = side * side;
+    size_t num_pairs = size_t(num_classes) * num_classes;
+    data.assign(num_pairs * (table_size + 1), -1);
+    int32_t *table_data = data.data();
+    int32_t *slope_data = data.data() + num_pairs * table_size;
+
+    // Each class is handled by one thread, which owns that part of the table
+    std::atomic<int> next_class{0};
+    auto worker = [&]() {
+        std::vector<delay_t> dist(wire_count, std::numeric_limits<delay_t>::max());
+        std::vector<int> touched;
+        typedef std::pair<delay_t, int> QueuedWire;
+        std::priority_queue<QueuedWire, std::vector<QueuedWire>, std::greater<QueuedWire>> queue;
+        while (true) {
+            int cls = next_class++;
+            if (cls >= num_classes)
+                break;
+            int32_t *cls_table = table_data + size_t(cls) * num_classes * table_size;
+            for (int src : sources.at(cls)) {
+                int sx = wire_x.at(src), sy = wire_y.at(src);
+                dist.at(src) = 0;
+                touched.push_back(src);
+                queue.emplace(0, src);
+                while (!queue.empty()) {
+                    auto curr = queue.top();
+                    queue.pop();
+                    if (curr.first > dist.at(curr.second))
+                        continue;
+                    int dx = wire_x.at(curr.second) - sx, dy = wire_y.at(curr.second) - sy;
+                    int32_t &entry = cls_table[(size_t(wire_class.at(curr.second)) * side + (dy + radius)) * side +
+                                               (dx + radius)];
+                    int32_t value = int32_t(std::min<delay_t>(curr.first, std::numeric_limits<int32_t>::max()));
+                    if (entry == -1 || value < entry)
+                        entry = value;
+                    for (auto pip : ctx->getPipsDownhill(idx_to_wire.at(curr.second))) {
+                        WireId next = ctx->getPipDstWire(pip);
+                        int next_idx = ctx->getWireIndex(next);
+                        if (std::abs(wire_x.at(next_idx) - sx) > radius || std::abs(wire_y.at(next_idx) - sy) > radius)
+                            continue;
+                        delay_t next_dist =
+                                curr.first + ctx->getPipDelay(pip).maxDelay() + ctx->getWireDelay(next).maxDelay();
+                        if (next_dist < dist.at(next_idx)) {
+                            if (dist.at(next_idx) == std::numeric_limits<delay_t>::max())
+                                touched.push_back(next_idx);
+                            dist.at(next_idx) = next_dist;
+                            queue.emplace(next_dist, next_idx);
+                        }
+                    }
+                }
+                for (int i : touched)
+                    dist.at(i) = std::numeric_limits<delay_t>::max();
+                touched.clear();
+            }
+            // The cheapest delay per tile on the edge of the window, for extrapolating beyond it
+            for (int dst_cls = 0; dst_cls < num_classes; dst_cls++) {
+                const int32_t *pair_table = cls_table + size_t(dst_cls) * table_size;
+                int32_t pair_slope = -1;
+                for (int dy = -radius; dy <= radius; dy++)
+                    for (int dx = -radius; dx <= radius; dx++) {
+                        if (std::max(std::abs(dx), std::abs(dy)) != radius)
+                            continue;
+                        int32_t value = pair_table[(dy + radius) * side + (dx + radius)];
+                        if (value < 0)
+                            continue;
+                        int32_t per_tile = value / (std::abs(dx) + std::abs(dy));
+                        if (pair_slope == -1 || per_tile < pair_slope)
+                            pair_slope = per_tile;
+                    }
+                slope_data[size_t(cls) * num_classes + dst_cls] = std::max<int32_t>(pair_slope, 0);
+            }
+        }
+    };
+    int n_threads = std::min(std::max(1, cfg.threads), num_classes);
+    TaskGroup workers(ctx->threadPool());
+    for (int i = 1; i < n_threads; i++)
+        workers.run(worker);
+    worker();
+    workers.wait();
+    table = table_data;
+    slope = slope_data;
+    auto rend = std::chrono::high_resolution_clock::now();
+    log_info("Router lookahead built in %.02fs.\n", std::chrono::duration<float>(rend - rstart).count());
+}
+
+bool RouterLookahead::estimate(WireId src, WireId dst, delay_t &delay) const
+{
+    if (table == nullptr)
+        return false;
+    int src_idx = ctx->getWireIndex(src), dst_idx = ctx->getWireIndex(dst);
+    size_t pair = size_t(class_map[wire_class[src_idx]]) * classes.size() + class_map[wire_class[dst_idx]];
+    int dx = wire_x[dst_idx] - wire_x[src_idx], dy = wire_y[dst_idx] - wire_y[src_idx];
+    int excess = std::max(std::abs(dx) - radius, 0) + std::max(std::abs(dy) - radius, 0);
+    dx = std::min(std::max(dx, -radius), radius);
+    dy = std::min(std::max(dy, -radius), radius);
+    int32_t value = table[(pair * side + (dy + radius)) * side + (dx + radius)];
+    if (value < 0)
+        return false;
+    delay = delay_t(value) + delay_t(excess) * delay_t(slope[pair]);
+    return true;
+}
+
+bool RouterLookahead::read_cache(const std::string &filename, uint64_t key)
+{
+    if (!boost::filesystem::exists(filename))
+        return false;
+    try {
+        mapped.open(filename);
+    } catch (std::ios_base::failure &fail) {
+        return false;
+    }
+    if (!mapped.is_open())
+        return false;
+    auto fail = [&](const char *reason) {
+        log_info("Ignoring router lookahead cache '%s': %s.\n", filename.c_str(), reason);
+        mapped.close();
+        return false;
+    };
+    if (mapped.size() < sizeof(CacheHeader))
+        return fail("file is truncated");
+    CacheHeader hdr;
+    std::memcpy(&hdr, mapped.data(), sizeof(CacheHeader));
+    if (std::memcmp(hdr.magic, lookahead_magic, sizeof(lookahead_magic)) != 0)
+        return fail("not a lookahead file");
+    if (hdr.version != lookahead_version)
+        return fail("version mismatch");
+    if (hdr.chipdb_size != chipdb_size || hdr.chipdb_checksum != chipdb_checksum)
+        return fail("built from a different chipdb");
+    if (hdr.key != key || hdr.radius != radius || hdr.num_classes != classes.size())
+        return fail("built for a different chipdb or settings");
+    size_t num_pairs = size_t(hdr.num_classes) * hdr.num_classes;
+    size_t table_size = num_pairs * side * side;
+    size_t data_size = (table_size + num_pairs) * sizeof(int32_t);
+    if (mapped.size() != sizeof(CacheHeader) + data_size + hdr.names_size)
+        return fail("file is truncated");
+
+    // Class indices are per-run IdStrings, so match up classes by name
+    dict<IdString, int> file_class;
+    const char *names = mapped.data() + sizeof(CacheHeader) + data_size;
+    const char *names_end = names + hdr.names_size;
+    for (const char *cursor = names; cursor < names_end; cursor += std::strlen(cursor) + 1) {
+        if (std::find(cursor, names_end, '\0') == names_end)
+            return fail("corrupt wire type names");
+        int idx = int(file_class.size());
+        file_class[ctx->id(cursor)] = idx;
+    }
+    for (int i = 0; i < int(classes.size()); i++) {
+        auto fnd = file_class.find(classes.at(i));
+        if (fnd == file_class.end())
+            return fail("wire types differ");
+        class_map.at(i) = fnd->second;
+    }
+    // The mapping is page aligned and the header a multiple of four bytes, so the tables can be used in place
+    table = reinterpret_cast<const int32_t *>(mapped.data() + sizeof(CacheHeader));
+    slope = table + table_size;
+    data.clear();
+    return true;
+}
+
+void RouterLookahead::write_cache(const std::string &filename, uint64_t key) const
+{
+    CacheHeader hdr;
+    std::memcpy(hdr.magic, lookahead_magic, sizeof(lookahead_magic));
+    hdr.version = lookahead_version;
+    hdr.radius = radius;
+    hdr.key = key;
+    hdr.chipdb_size = chipdb_size;
+    hdr.chipdb_checksum = chipdb_checksum;
+    hdr.num_classes = uint32_t(classes.size());
+    std::string names;
+    for (auto cls : classes) {
+        names += cls.str(ctx);
+        names.push_back('\0');
+    }
+    hdr.names_size = uint32_t(names.size());
+
+    // Write to a temporary file and move it into place, so concurrent runs never see a partial file
+    try {
+        boost::filesystem::path path(filename);
+        if (path.has_parent_path())
+            boost::filesystem::create_directories(path.parent_path());
+        boost::filesystem::path temp = path;
+        temp += boost::filesystem::unique_path(".%%%%-%%%%-%%%%.tmp");
+        {
+            std::ofstream out(temp.string(), std::ios::binary);
+            out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+            out.write(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(int32_t));
+            out.write(names.data(), names.size());
+            if (!out) {
+                out.close();
+                boost::filesystem::remove(temp);
+                log_warning("Failed to write router lookahead cache '%s'.\n", filename.c_str());
+                return;
+            }
+        }
+        boost::filesystem::rename(temp, path);
+    } catch (boost::filesystem::filesystem_error &err) {
+        log_warning("Failed to write router lookahead cache '%s': %s.\n", filename.c_str(), err.what());
+        return;
+    }
+    log_info("Saved router lookahead to '%s'.\n", filename.c_str());
+}
+
+NEXTPNR_NAMESPACE_END
@@ -0,0 +1,106 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef ROUTER_LOOKAHEAD_H
+#define ROUTER_LOOKAHEAD_H
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nextpnr_namespaces.h"
+#include "nextpnr_types.h"
+
+NEXTPNR_NAMESPACE_BEGIN
+
+struct RouterLookaheadCfg
+{
+    RouterLookaheadCfg(Context *ctx);
+
+    // Whether the lookahead is used at all; arches fall back to their own estimate otherwise
+    bool enabled;
+    // Half-width of the (dx, dy) window explored around each sampled source wire. Offsets outside the window
+    // are extrapolated from its edge
+    int radius;
+    // Number of source wires of each wire type to run Dijkstra from
+    int samples;
+    int threads;
+    // Cache file to load from and save to. Empty picks a file in the user cache directory named after the key
+    std::string cache_file;
+    // Ignore an existing cache file and rebuild
+    bool rebuild;
+};
+
+// A generic router lookahead, for arches without a dedicated one.
+//
+// For every wire type (as returned by getWireType) a few source wires are sampled and a Dijkstra search over
+// downhill pips finds the minimum delay to reach a wire of each type at each (dx, dy) offset within a window. The
+// estimate for a (src, dst) pair is then the table entry for the types of src and dst and the offset between them.
+//
+// Building the tables costs many Dijkstra searches, so the result is cached in a flat, versioned file that is
+// memory-mapped and used in place on later runs. The cache is keyed by a checksum of the chipdb blob and a string
+// supplied by the arch, which should identify the device and anything else affecting pip delays, together with the
+// lookahead settings and the shape of the routing graph. The chipdb size and checksum are also kept in the file
+// header, so that a rebuilt chipdb is never paired with an old cache file given explicitly.
+//
+// The lookahead needs dense wire indices (getWireIndex); it stays disabled for arches that don't provide them.
+struct RouterLookahead
+{
+    // chipdb and chipdb_size give the chipdb blob, whose checksum is part of the cache key; pass nullptr if it is not
+    // known, in which case the cache is only used when a cache file is given explicitly
+    void init(Context *ctx, const std::string &chipdb_key, const void *chipdb, size_t chipdb_size);
+
+    bool ready() const { return table != nullptr; }
+
+    // Returns false if there is no estimate for this pair, in which case the arch should use its own
+    bool estimate(WireId src, WireId dst, delay_t &delay) const;
+
+  private:
+    const Context *ctx = nullptr;
+    int radius = 0, side = 0;
+    uint64_t chipdb_size = 0, chipdb_checksum = 0;
+
+    // Per dense wire index
+    std::vector<int16_t> wire_x, wire_y;
+    std::vector<int32_t> wire_class;
+    // Wire types, in the order of class indices
+    std::vector<IdString> classes;
+
+    // [src class][dst class][dy + radius][dx + radius], -1 where no such wire was reached
+    const int32_t *table = nullptr;
+    // Delay per tile used to extrapolate outside the window, per [src class][dst class]
+    const int32_t *slope = nullptr;
+    // Maps our class index to the class index in the table, which may be ordered differently if loaded from a cache
+    std::vector<int32_t> class_map;
+
+    // Backing storage for table and slope; either built here or mapped from the cache file
+    std::vector<int32_t> data;
+    boost::iostreams::mapped_file_source mapped;
+
+    void setup_wires();
+    uint64_t compute_key(const std::string &chipdb_key, const RouterLookaheadCfg &cfg) const;
+    void build(const RouterLookaheadCfg &cfg);
+    bool read_cache(const std::string &filename, uint64_t key);
+    void write_cache(const std::string &filename, uint64_t key) const;
+};
+
+NEXTPNR_NAMESPACE_END
+
+#endif
@@ -51,21 +51,23 @@ void IdString::initialize_arch(const BaseCtx *ctx)
 
 // -----------------------------------------------------------------------
 
-static const ChipInfoPOD *get_chip_info(ArchArgs::ArchArgsTypes chip)
+static std::string get_chipdb_name(ArchArgs::ArchArgsTypes chip)
 {
-    std::string chipdb;
     if (chip == ArchArgs::LFE5U_12F || chip == ArchArgs::LFE5U_25F || chip == ArchArgs::LFE5UM_25F ||
         chip == ArchArgs::LFE5UM5G_25F) {
-        chipdb = "ecp5/chipdb-25k.bin";
+        return "ecp5/chipdb-25k.bin";
     } else if (chip == ArchArgs::LFE5U_45F || chip == ArchArgs::LFE5UM_45F || chip == ArchArgs::LFE5UM5G_45F) {
-        chipdb = "ecp5/chipdb-45k.bin";
+        return "ecp5/chipdb-45k.bin";
     } else if (chip == ArchArgs::LFE5U_85F || chip == ArchArgs::LFE5UM_85F || chip == ArchArgs::LFE5UM5G_85F) {
-        chipdb = "ecp5/chipdb-85k.bin";
+        return "ecp5/chipdb-85k.bin";
     } else {
         log_error("Unknown chip\n");
     }
+}
 
-    auto ptr = reinterpret_cast<const RelPtr<ChipInfoPOD> *>(get_chipdb(chipdb));
+static const ChipInfoPOD *get_chip_info(ArchArgs::ArchArgsTypes chip)
+{
+    auto ptr = reinterpret_cast<const RelPtr<ChipInfoPOD> *>(get_chipdb(get_chipdb_name(chip)));
     if (ptr == nullptr)
         return nullptr;
     return ptr->get();
@@ -472,6 +474,10 @@ delay_t Arch::estimateDelay(WireId src, WireId dst) const
         }
     }
 
+    delay_t lookahead_delay;
+    if (lookahead.estimate(src, dst, lookahead_delay))
+        return lookahead_delay;
+
     auto est_location = [&](WireId w) -> std::pair<int, int> {
         const auto &wire = loc_info(w)->wire_data[w.index];
         if (w == gsrclk_wire) {
@@ -692,6 +698,8 @@ bool Arch::route()
     setup_wire_locations();
     route_ecp5_globals(getCtx());
     assignArchInfo();
+    std::string chipdb = get_chipdb_name(args.type);
+    lookahead.init(getCtx(), "ecp5/" + get_full_chip_name(), get_chipdb(chipdb), get_chipdb_size(chipdb));
 
     bool result;
     if (router == "router1") {
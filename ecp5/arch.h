@@ -27,6 +27,7 @@
 #include "base_arch.h"
 #include "nextpnr_types.h"
 #include "relptr.h"
+#include "router_lookahead.h"
 
 NEXTPNR_NAMESPACE_BEGIN
 
@@ -624,6 +625,12 @@ struct Arch : BaseArch<ArchRanges>
 
     bool getBelGlobalBuf(BelId bel) const override { return getBelType(bel) == id_DCCA; }
 
+    bool isBelBindingPartitionSafe(BelId bel) const override
+    {
+        // Bindings and slice state are per tile, but DSP validity looks at the whole block of DSP tiles
+        return !getBelType(bel).in(id_MULT18X18D, id_ALU54B);
+    }
+
     bool checkBelAvail(BelId bel) const override
     {
         NPNR_ASSERT(bel != BelId());
@@ -705,6 +712,9 @@ struct Arch : BaseArch<ArchRanges>
 
     uint32_t getWireChecksum(WireId wire) const override { return wire.index; }
 
+    int getWireIndex(WireId wire) const override { return get_wire_vecidx(wire); }
+    int getWireIndexCount() const override { return int(wire2net.size()); }
+
     uint32_t get_wire_vecidx(const WireId &e) const
     {
         uint32_t tile = e.location.y * chip_info->width + e.location.x;
@@ -1073,6 +1083,9 @@ struct Arch : BaseArch<ArchRanges>
     dict<WireId, std::pair<int, int>> wire_loc_overrides;
     void setup_wire_locations();
 
+    // Optional sampled lookahead used by estimateDelay, see router_lookahead.h
+    RouterLookahead lookahead;
+
     mutable dict<DelayKey, std::pair<bool, DelayQuad>> celldelay_cache;
 
     static const std::string defaultPlacer;
@@ -352,6 +352,9 @@ struct Arch : ArchAPI<ArchRanges>
         return getBoundBelCell(bel);
     }
 
+    // Binding goes through the shared constraint and site routing state
+    bool isBelBindingPartitionSafe(BelId /*bel*/) const final { return false; }
+
     BelRange getBels() const final
     {
         BelRange range;
@@ -27,18 +27,34 @@
 #include "LogicalNetlist.capnp.h"
 #include "zlib.h"
 #include "frontend_base.h"
+#include "gzip_writer.h"
+#include <chrono>
+#include <ostream>
 
 NEXTPNR_NAMESPACE_BEGIN
 
-static void write_message(::capnp::MallocMessageBuilder & message, const std::string &filename) {
-    kj::Array<capnp::word> words = messageToFlatArray(message);
-    kj::ArrayPtr<kj::byte> bytes = words.asBytes();
-
-    gzFile file = gzopen(filename.c_str(), "w");
-    NPNR_ASSERT(file != Z_NULL);
-
-    NPNR_ASSERT(gzwrite(file, &bytes[0], bytes.size()) == (int)bytes.size());
-    NPNR_ASSERT(gzclose(file) == Z_OK);
+static void write_message(const Context *ctx, ::capnp::MallocMessageBuilder & message, const std::string &filename) {
+    // Segments are serialised straight into the compressor, which deflates blocks on the thread pool as they fill,
+    // rather than first being copied into one flat array
+    auto start = std::chrono::high_resolution_clock::now();
+    ParallelGzipBuf buf(ctx->threadPool());
+    if (!buf.open(filename))
+        log_error("Failed to open '%s' for writing.\n", filename.c_str());
+    {
+        std::ostream ostream(&buf);
+        kj::std::StdOutputStream kj_ostream(ostream);
+        capnp::writeMessage(kj_ostream, message);
+    }
+    if (!buf.close())
+        log_error("Failed to write '%s'.\n", filename.c_str());
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (ctx->verbose) {
+        float write_time = std::chrono::duration<float>(end - start).count();
+        log_info("write_message time %.02fs (%.02f MiB -> %.02f MiB, %.02fs compressing on %d threads)\n",
+                 write_time, buf.bytes_in() / 1048576.0, buf.bytes_out() / 1048576.0, buf.compress_time(),
+                 ctx->threadPool().size());
+    }
 }
 
 struct StringEnumerator {
@@ -402,6 +418,7 @@ static void find_non_synthetic_edges(const Context * ctx, WireId root_wire,
 }
 
 void FpgaInterchange::write_physical_netlist(const Context * ctx, const std::string &filename) {
+    auto start = std::chrono::high_resolution_clock::now();
     ::capnp::MallocMessageBuilder message;
 
     PhysicalNetlist::PhysNetlist::Builder phys_netlist = message.initRoot<PhysicalNetlist::PhysNetlist>();
@@ -717,7 +734,12 @@ void FpgaInterchange::write_physical_netlist(const Context * ctx, const std::str
         str_list.set(i, strings.strings[i]);
     }
 
-    write_message(message, filename);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (ctx->verbose) {
+        log_info("build physical netlist time %.02fs\n", std::chrono::duration<float>(end - start).count());
+    }
+
+    write_message(ctx, message, filename);
 }
 
 struct LogicalNetlistImpl;
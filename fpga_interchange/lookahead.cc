@@ -24,7 +24,8 @@
 #include <boost/safe_numerics/safe_integer.hpp>
 #include <capnp/message.h>
 #include <capnp/serialize.h>
-#include <kj/filesystem.h>
+#include <chrono>
+#include <fstream>
 #include <kj/std/iostream.h>
 #include <queue>
 #include <sstream>
@@ -32,6 +33,7 @@
 
 #include "context.h"
 #include "flat_wire_map.h"
+#include "gzip_writer.h"
 #include "log.h"
 #include "sampler.h"
 #include "scope_lock.h"
@@ -1010,65 +1012,52 @@ void Lookahead::build_lookahead(const Context *ctx, DeterministicRNG *rng)
 
 constexpr static bool kUseGzipForLookahead = false;
 
-static void write_message(::capnp::MallocMessageBuilder &message, const std::string &filename)
+static void write_message(const Context *ctx, ::capnp::MallocMessageBuilder &message, const std::string &filename)
 {
-    kj::Array<capnp::word> words = messageToFlatArray(message);
-    kj::ArrayPtr<kj::byte> bytes = words.asBytes();
-
     boost::filesystem::path temp = boost::filesystem::unique_path();
     log_info("Writing tempfile to %s\n", temp.c_str());
 
+    // Segments are serialised straight to the file (or compressor) rather than first being copied into one flat array
+    auto start = std::chrono::high_resolution_clock::now();
+    bool ok;
     if (kUseGzipForLookahead) {
-        gzFile file = gzopen(temp.c_str(), "w");
-        NPNR_ASSERT(file != Z_NULL);
-
-        size_t bytes_written = 0;
-        int result;
-        while (bytes_written < bytes.size()) {
-            size_t bytes_remaining = bytes.size() - bytes_written;
-            size_t bytes_to_write = bytes_remaining;
-            if (bytes_to_write >= std::numeric_limits<int>::max()) {
-                bytes_to_write = std::numeric_limits<int>::max();
+        ParallelGzipBuf buf(ctx->threadPool());
+        ok = buf.open(temp.string());
+        if (ok) {
+            {
+                std::ostream ostream(&buf);
+                kj::std::StdOutputStream kj_ostream(ostream);
+                capnp::writeMessage(kj_ostream, message);
             }
-            result = gzwrite(file, &bytes[0] + bytes_written, bytes_to_write);
-            if (result < 0) {
-                break;
-            }
-
-            bytes_written += result;
+            ok = buf.close();
         }
-
-        int error;
-        std::string error_str;
-        if (result < 0) {
-            error_str.assign(gzerror(file, &error));
-        }
-        NPNR_ASSERT(gzclose(file) == Z_OK);
-        if (bytes_written != bytes.size()) {
-            // Remove failed writes before reporting error.
-            boost::filesystem::remove(temp);
-        }
-
-        if (result < 0) {
-            log_error("Failed to write lookahead, error from gzip %s\n", error_str.c_str());
-        } else {
-            if (bytes_written != bytes.size()) {
-                log_error("Failed to write lookahead, wrote %d bytes, had %zu bytes\n", result, bytes.size());
-            } else {
-                // Written, move file into place
-                boost::filesystem::rename(temp, filename);
-            }
+        if (ok && ctx->verbose) {
+            log_info("Compressed lookahead from %.02f MiB to %.02f MiB (%.02fs compressing on %d threads)\n",
+                     buf.bytes_in() / 1048576.0, buf.bytes_out() / 1048576.0, buf.compress_time(),
+                     ctx->threadPool().size());
         }
     } else {
-        {
-            kj::Own<kj::Filesystem> fs = kj::newDiskFilesystem();
-
-            auto path = kj::Path::parse(temp);
-            auto file = fs->getCurrent().openFile(path, kj::WriteMode::CREATE);
-            file->writeAll(bytes);
+        std::ofstream ostream(temp.string(), std::ios::binary);
+        ok = bool(ostream);
+        if (ok) {
+            kj::std::StdOutputStream kj_ostream(ostream);
+            capnp::writeMessage(kj_ostream, message);
+            ostream.close();
+            ok = bool(ostream);
         }
+    }
 
-        boost::filesystem::rename(temp, filename);
+    if (!ok) {
+        // Remove failed writes before reporting error.
+        boost::filesystem::remove(temp);
+        log_error("Failed to write lookahead to %s\n", temp.c_str());
+    }
+    // Written, move file into place
+    boost::filesystem::rename(temp, filename);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    if (ctx->verbose) {
+        log_info("write_lookahead time %.02fs\n", std::chrono::duration<float>(end - start).count());
     }
 }
 
@@ -1130,13 +1119,13 @@ bool Lookahead::read_lookahead(const std::string &chipdb_hash, const std::string
     }
 }
 
-void Lookahead::write_lookahead(const std::string &chipdb_hash, const std::string &file) const
+void Lookahead::write_lookahead(const Context *ctx, const std::string &chipdb_hash, const std::string &file) const
 {
     ::capnp::MallocMessageBuilder message;
 
     lookahead_storage::Lookahead::Builder lookahead = message.initRoot<lookahead_storage::Lookahead>();
     to_builder(chipdb_hash, lookahead);
-    write_message(message, file);
+    write_message(ctx, message, file);
 }
 
 void Lookahead::init(const Context *ctx, DeterministicRNG *rng)
@@ -1153,7 +1142,7 @@ void Lookahead::init(const Context *ctx, DeterministicRNG *rng)
     if (ctx->args.rebuild_lookahead || !read_lookahead(chipdb_hash, lookahead_filename)) {
         build_lookahead(ctx, rng);
         if (!ctx->args.dont_write_lookahead) {
-            write_lookahead(chipdb_hash, lookahead_filename);
+            write_lookahead(ctx, chipdb_hash, lookahead_filename);
         }
     }
 }
@@ -59,7 +59,7 @@ struct Lookahead
     void build_lookahead(const Context *, DeterministicRNG *rng);
 
     bool read_lookahead(const std::string &chipdb_hash, const std::string &file);
-    void write_lookahead(const std::string &chipdb_hash, const std::string &file) const;
+    void write_lookahead(const Context *ctx, const std::string &chipdb_hash, const std::string &file) const;
     bool from_reader(const std::string &chipdb_hash, lookahead_storage::Lookahead::Reader reader);
     void to_builder(const std::string &chipdb_hash, lookahead_storage::Lookahead::Builder builder) const;
 
@@ -19,185 +19,727 @@
 
 #include "json_frontend.h"
 #include "frontend_base.h"
-#include "json11.hpp"
 #include "log.h"
 #include "nextpnr.h"
 
-#include <streambuf>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
 
 NEXTPNR_NAMESPACE_BEGIN
 
-using namespace json11;
+namespace {
 
-struct JsonFrontendImpl
+// Reads JSON text from a stream in fixed-size chunks, so the file is never held in memory as a whole. Values are
+// consumed in document order by the caller, SAX style; there is no intermediate tree.
+struct JsonStreamReader
 {
-    // See specification in frontend_base.h
-    JsonFrontendImpl(Json &root) : root(root){};
-    Json &root;
-    typedef const Json &ModuleDataType;
-    typedef const Json &ModulePortDataType;
-    typedef const Json &CellDataType;
-    typedef const Json &NetnameDataType;
-    typedef const Json::array &BitVectorDataType;
+    JsonStreamReader(std::istream &in, const std::string &filename) : in(in), filename(filename), buf(1 << 20){};
 
-    template <typename TFunc> void foreach_module(TFunc Func) const
+    std::istream &in;
+    const std::string &filename;
+    std::vector<char> buf;
+    size_t pos = 0, end = 0;
+    size_t bytes_read = 0;
+    int line = 1;
+
+    bool fill()
     {
-        for (const auto &mod : root.object_items())
-            Func(mod.first, mod.second);
+        if (!in)
+            return false;
+        in.read(buf.data(), buf.size());
+        end = size_t(in.gcount());
+        pos = 0;
+        bytes_read += end;
+        return end > 0;
     }
 
-    template <typename TFunc> void foreach_port(ModuleDataType &mod, TFunc Func) const
+    int peek()
     {
-        const auto &ports = mod["ports"];
-        if (ports.is_null())
-            return;
-        for (const auto &port : ports.object_items())
-            Func(port.first, port.second);
+        if (pos == end && !fill())
+            return EOF;
+        return (unsigned char)buf[pos];
+    }
+
+    int get()
+    {
+        int c = peek();
+        if (c != EOF) {
+            ++pos;
+            if (c == '\n')
+                ++line;
+        }
+        return c;
+    }
+
+    [[noreturn]] void error(const std::string &msg)
+    {
+        log_error("Failed to parse JSON file '%s': %s at line %d.\n", filename.c_str(), msg.c_str(), line);
+    }
+
+    // Skips whitespace and comments, which Yosys doesn't write but older nextpnr (json11) accepted
+    void skip_ws()
+    {
+        while (true) {
+            int c = peek();
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+                get();
+            } else if (c == '/') {
+                get();
+                c = get();
+                if (c == '/') {
+                    while (c != '\n' && c != EOF)
+                        c = get();
+                } else if (c == '*') {
+                    int last = 0;
+                    while (true) {
+                        c = get();
+                        if (c == EOF)
+                            error("unterminated comment");
+                        if (last == '*' && c == '/')
+                            break;
+                        last = c;
+                    }
+                } else {
+                    error("malformed comment");
+                }
+            } else {
+                return;
+            }
+        }
+    }
+
+    void expect(char c)
+    {
+        skip_ws();
+        if (get() != c)
+            error(stringf("expected '%c'", c));
+    }
+
+    bool consume(char c)
+    {
+        skip_ws();
+        if (peek() != c)
+            return false;
+        get();
+        return true;
+    }
+
+    int peek_value()
+    {
+        skip_ws();
+        return peek();
+    }
+
+    void expect_literal(const char *lit)
+    {
+        for (const char *p = lit; *p; p++)
+            if (get() != *p)
+                error(stringf("expected '%s'", lit));
+    }
+
+    void put_utf8(std::string &out, uint32_t cp)
+    {
+        if (cp < 0x80) {
+            out += char(cp);
+        } else if (cp < 0x800) {
+            out += char(0xC0 | (cp >> 6));
+            out += char(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += char(0xE0 | (cp >> 12));
+            out += char(0x80 | ((cp >> 6) & 0x3F));
+            out += char(0x80 | (cp & 0x3F));
+        } else {
+            out += char(0xF0 | (cp >> 18));
+            out += char(0x80 | ((cp >> 12) & 0x3F));
+            out += char(0x80 | ((cp >> 6) & 0x3F));
+            out += char(0x80 | (cp & 0x3F));
+        }
+    }
+
+    uint32_t read_hex4()
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) {
+            int c = get();
+            v <<= 4;
+            if (c >= '0' && c <= '9')
+                v |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                v |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                v |= c - 'A' + 10;
+            else
+                error("bad \\u escape");
+        }
+        return v;
+    }
+
+    // Reads a string into out, reusing its storage
+    void read_string(std::string &out)
+    {
+        expect('"');
+        out.clear();
+        while (true) {
+            // Fast path: copy runs of plain characters straight out of the buffer
+            size_t start = pos;
+            while (pos < end && buf[pos] != '"' && buf[pos] != '\\' && buf[pos] != '\n')
+                ++pos;
+            out.append(buf.data() + start, pos - start);
+            int c = get();
+            if (c == '"') {
+                return;
+            } else if (c == '\\') {
+                c = get();
+                switch (c) {
+                case '"':
+                case '\\':
+                case '/':
+                    out += char(c);
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u': {
+                    uint32_t cp = read_hex4();
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        expect_literal("\\u");
+                        uint32_t lo = read_hex4();
+                        if (lo < 0xDC00 || lo > 0xDFFF)
+                            error("bad surrogate pair");
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    }
+                    put_utf8(out, cp);
+                    break;
+                }
+                default:
+                    error("bad escape sequence");
+                }
+            } else if (c == EOF) {
+                error("unterminated string");
+            } else {
+                // A newline, or the first character after the buffer was refilled
+                out += char(c);
+            }
+        }
+    }
+
+    double read_number()
+    {
+        skip_ws();
+        char tmp[64];
+        size_t len = 0;
+        while (true) {
+            int c = peek();
+            if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+                break;
+            if (len == sizeof(tmp) - 1)
+                error("number too long");
+            tmp[len++] = char(get());
+        }
+        tmp[len] = '\0';
+        char *num_end = nullptr;
+        double val = std::strtod(tmp, &num_end);
+        if (len == 0 || num_end != tmp + len)
+            error("bad number");
+        return val;
+    }
+
+    bool read_int(int &out)
+    {
+        double val = read_number();
+        if (val < INT_MIN || val > INT_MAX || int(val) != val)
+            return false;
+        out = int(val);
+        return true;
     }
 
-    template <typename TFunc> void foreach_cell(ModuleDataType &mod, TFunc Func) const
+    // Calls Func(key) for each key of an object; Func must consume the corresponding value
+    template <typename TFunc> void read_object(TFunc Func)
     {
-        const auto &cells = mod["cells"];
-        if (cells.is_null())
+        expect('{');
+        if (consume('}'))
             return;
-        for (const auto &cell : cells.object_items())
-            Func(cell.first, cell.second);
+        std::string key;
+        do {
+            read_string(key);
+            expect(':');
+            Func(key);
+        } while (consume(','));
+        expect('}');
     }
 
-    template <typename TFunc> void foreach_netname(ModuleDataType &mod, TFunc Func) const
+    // Calls Func() for each element of an array; Func must consume the element
+    template <typename TFunc> void read_array(TFunc Func)
     {
-        const auto &netnames = mod["netnames"];
-        if (netnames.is_null())
+        expect('[');
+        if (consume(']'))
             return;
-        for (const auto &netname : netnames.object_items())
-            Func(netname.first, netname.second);
+        do {
+            Func();
+        } while (consume(','));
+        expect(']');
     }
 
-    PortType lookup_portdir(const std::string &dir) const
+    void skip_value()
     {
-        if (dir == "input")
-            return PORT_IN;
-        else if (dir == "inout")
-            return PORT_INOUT;
-        else if (dir == "output")
-            return PORT_OUT;
-        else
-            NPNR_ASSERT_FALSE("invalid json port direction");
+        switch (peek_value()) {
+        case '{':
+            read_object([&](const std::string &) { skip_value(); });
+            break;
+        case '[':
+            read_array([&]() { skip_value(); });
+            break;
+        case '"':
+            read_string(scratch);
+            break;
+        case 't':
+            expect_literal("true");
+            break;
+        case 'f':
+            expect_literal("false");
+            break;
+        case 'n':
+            expect_literal("null");
+            break;
+        default:
+            read_number();
+        }
     }
 
-    PortType get_port_dir(ModulePortDataType &port) const { return lookup_portdir(port["direction"].string_value()); }
+    // Returns true, having consumed it, if the next value is null
+    bool read_null()
+    {
+        if (peek_value() != 'n')
+            return false;
+        expect_literal("null");
+        return true;
+    }
+
+    std::string scratch;
+};
+
+// A span of one of the flat per-module arrays below. Only an offset while the module is being read, as the arrays
+// may still be reallocated; resolve() sets the pointer once the module is complete.
+template <typename T> struct JsonSpan
+{
+    const T *data = nullptr;
+    int32_t start = 0, len = 0;
+
+    void resolve(const std::vector<T> &v) { data = v.data() + start; }
+    const T *begin() const { return data; }
+    const T *end() const { return data + len; }
+};
+
+// Each bit is a signal number, or -1 - c for a constant bit with value c
+typedef JsonSpan<int32_t> JsonBitVector;
+typedef JsonSpan<std::pair<IdString, Property>> JsonProperties;
+
+struct JsonPort
+{
+    PortType dir = PORT_IN;
+    int offset = 0;
+    bool upto = false;
+    JsonBitVector bits;
+    JsonProperties attrs;
+};
+
+struct JsonNetname
+{
+    int offset = 0;
+    bool upto = false;
+    JsonBitVector bits;
+    JsonProperties attrs;
+};
+
+struct JsonCell
+{
+    IdString type;
+    JsonProperties attrs, params;
+    JsonSpan<std::pair<IdString, PortType>> port_dirs;
+    JsonSpan<std::pair<IdString, JsonBitVector>> conns;
+};
+
+// The parts of a Yosys JSON module that the frontend uses, stored in a few flat arrays rather than a tree of
+// individually allocated nodes. All names are interned as IdStrings while reading.
+struct JsonModule
+{
+    JsonProperties attrs, settings;
+    std::vector<std::pair<IdString, JsonPort>> ports;
+    std::vector<std::pair<IdString, JsonCell>> cells;
+    std::vector<std::pair<IdString, JsonNetname>> netnames;
+
+    std::vector<int32_t> bits;
+    std::vector<std::pair<IdString, Property>> props;
+    std::vector<std::pair<IdString, PortType>> port_dirs;
+    std::vector<std::pair<IdString, JsonBitVector>> conns;
 
-    int get_array_offset(const Json &obj) const
+    void resolve()
     {
-        auto offset = obj["offset"];
-        return offset.is_null() ? 0 : offset.int_value();
+        attrs.resolve(props);
+        settings.resolve(props);
+        for (auto &port : ports) {
+            port.second.bits.resolve(bits);
+            port.second.attrs.resolve(props);
+        }
+        for (auto &conn : conns)
+            conn.second.resolve(bits);
+        for (auto &cell : cells) {
+            cell.second.attrs.resolve(props);
+            cell.second.params.resolve(props);
+            cell.second.port_dirs.resolve(port_dirs);
+            cell.second.conns.resolve(conns);
+        }
+        for (auto &netname : netnames) {
+            netname.second.bits.resolve(bits);
+            netname.second.attrs.resolve(props);
+        }
     }
+};
 
-    bool is_array_upto(const Json &obj) const
+struct JsonNetlistReader
+{
+    JsonNetlistReader(Context *ctx, JsonStreamReader &rd) : ctx(ctx), rd(rd){};
+    Context *ctx;
+    JsonStreamReader &rd;
+    std::string str;
+
+    IdString read_id()
     {
-        auto upto = obj["upto"];
-        return upto.is_null() ? false : bool(upto.int_value());
+        rd.read_string(str);
+        return ctx->id(str);
     }
 
-    BitVectorDataType &get_port_bits(ModulePortDataType &port) const { return port["bits"].array_items(); }
+    PortType read_portdir()
+    {
+        rd.read_string(str);
+        if (str == "input")
+            return PORT_IN;
+        else if (str == "inout")
+            return PORT_INOUT;
+        else if (str == "output")
+            return PORT_OUT;
+        else
+            rd.error(stringf("invalid port direction '%s'", str.c_str()));
+    }
 
-    const std::string &get_cell_type(CellDataType &cell) const { return cell["type"].string_value(); }
+    int read_int()
+    {
+        int val;
+        if (!rd.read_int(val))
+            rd.error("expected an integer");
+        return val;
+    }
 
-    Property parse_property(const Json &val) const
+    Property read_property()
     {
-        if (val.is_number()) {
-            if (val.int_value() != val.number_value())
+        int c = rd.peek_value();
+        if (c == '"') {
+            rd.read_string(str);
+            return Property::from_string(str);
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            int val;
+            if (!rd.read_int(val))
                 log_error("Found an out-of-range integer parameter in the JSON file.\n"
                           "Please regenerate the input file with an up-to-date version of yosys.\n");
-            return Property(val.int_value(), 32);
+            return Property(val, 32);
         } else {
-            return Property::from_string(val.string_value());
+            rd.skip_value();
+            return Property::from_string("");
         }
     }
 
-    template <typename TFunc> void foreach_attr(const Json &obj, TFunc Func) const
+    JsonProperties read_properties(JsonModule &mod)
     {
-        const auto &attrs = obj["attributes"];
-        if (attrs.is_null())
-            return;
-        for (const auto &attr : attrs.object_items()) {
-            Func(attr.first, parse_property(attr.second));
-        }
+        JsonProperties result;
+        if (rd.read_null())
+            return result;
+        result.start = int32_t(mod.props.size());
+        rd.read_object([&](const std::string &key) {
+            IdString name = ctx->id(key);
+            mod.props.emplace_back(name, read_property());
+        });
+        result.len = int32_t(mod.props.size()) - result.start;
+        return result;
     }
 
-    template <typename TFunc> void foreach_param(const Json &obj, TFunc Func) const
+    JsonBitVector read_bits(JsonModule &mod)
     {
-        const auto &params = obj["parameters"];
-        if (params.is_null())
-            return;
-        for (const auto &param : params.object_items()) {
-            Func(param.first, parse_property(param.second));
-        }
+        JsonBitVector result;
+        result.start = int32_t(mod.bits.size());
+        rd.read_array([&]() {
+            if (rd.peek_value() == '"') {
+                rd.read_string(str);
+                if (str != "0" && str != "1" && str != "x" && str != "z")
+                    rd.error(stringf("invalid constant bit '%s'", str.c_str()));
+                mod.bits.push_back(-1 - int32_t(uint8_t(str.at(0))));
+            } else {
+                int sig = read_int();
+                if (sig < 0)
+                    rd.error("negative signal number");
+                mod.bits.push_back(sig);
+            }
+        });
+        result.len = int32_t(mod.bits.size()) - result.start;
+        return result;
     }
 
-    template <typename TFunc> void foreach_setting(const Json &obj, TFunc Func) const
+    void read_port(JsonModule &mod, const std::string &name, JsonPort &port)
     {
-        const auto &settings = obj["settings"];
-        if (settings.is_null())
-            return;
-        for (const auto &setting : settings.object_items()) {
-            Func(setting.first, parse_property(setting.second));
-        }
+        bool have_dir = false;
+        rd.read_object([&](const std::string &key) {
+            if (key == "direction") {
+                port.dir = read_portdir();
+                have_dir = true;
+            } else if (key == "bits") {
+                port.bits = read_bits(mod);
+            } else if (key == "offset") {
+                port.offset = read_int();
+            } else if (key == "upto") {
+                port.upto = bool(read_int());
+            } else if (key == "attributes") {
+                port.attrs = read_properties(mod);
+            } else {
+                rd.skip_value();
+            }
+        });
+        if (!have_dir)
+            rd.error(stringf("port '%s' has no direction", name.c_str()));
+    }
+
+    void read_cell(JsonModule &mod, JsonCell &cell)
+    {
+        rd.read_object([&](const std::string &key) {
+            if (key == "type") {
+                cell.type = read_id();
+            } else if (key == "attributes") {
+                cell.attrs = read_properties(mod);
+            } else if (key == "parameters") {
+                cell.params = read_properties(mod);
+            } else if (key == "port_directions") {
+                cell.port_dirs.start = int32_t(mod.port_dirs.size());
+                rd.read_object([&](const std::string &port) {
+                    IdString name = ctx->id(port);
+                    mod.port_dirs.emplace_back(name, read_portdir());
+                });
+                cell.port_dirs.len = int32_t(mod.port_dirs.size()) - cell.port_dirs.start;
+            } else if (key == "connections") {
+                cell.conns.start = int32_t(mod.conns.size());
+                rd.read_object([&](const std::string &port) {
+                    IdString name = ctx->id(port);
+                    JsonBitVector bits = read_bits(mod);
+                    mod.conns.emplace_back(name, bits);
+                });
+                cell.conns.len = int32_t(mod.conns.size()) - cell.conns.start;
+            } else {
+                rd.skip_value();
+            }
+        });
+    }
+
+    void read_netname(JsonModule &mod, JsonNetname &netname)
+    {
+        rd.read_object([&](const std::string &key) {
+            if (key == "bits")
+                netname.bits = read_bits(mod);
+            else if (key == "offset")
+                netname.offset = read_int();
+            else if (key == "upto")
+                netname.upto = bool(read_int());
+            else if (key == "attributes")
+                netname.attrs = read_properties(mod);
+            else
+                rd.skip_value();
+        });
+    }
+
+    void read_module(JsonModule &mod)
+    {
+        rd.read_object([&](const std::string &key) {
+            if (key == "attributes") {
+                mod.attrs = read_properties(mod);
+            } else if (key == "settings") {
+                mod.settings = read_properties(mod);
+            } else if (key == "ports") {
+                if (rd.read_null())
+                    return;
+                rd.read_object([&](const std::string &name) {
+                    mod.ports.emplace_back(ctx->id(name), JsonPort());
+                    read_port(mod, name, mod.ports.back().second);
+                });
+            } else if (key == "cells") {
+                if (rd.read_null())
+                    return;
+                rd.read_object([&](const std::string &name) {
+                    mod.cells.emplace_back(ctx->id(name), JsonCell());
+                    read_cell(mod, mod.cells.back().second);
+                });
+            } else if (key == "netnames") {
+                if (rd.read_null())
+                    return;
+                rd.read_object([&](const std::string &name) {
+                    mod.netnames.emplace_back(ctx->id(name), JsonNetname());
+                    read_netname(mod, mod.netnames.back().second);
+                });
+            } else {
+                rd.skip_value();
+            }
+        });
+        mod.resolve();
+    }
+
+    // Returns false if there is no "modules" key
+    bool read_netlist(std::vector<std::pair<IdString, JsonModule>> &modules)
+    {
+        bool found_modules = false;
+        rd.read_object([&](const std::string &key) {
+            if (key == "modules" && !rd.read_null()) {
+                found_modules = true;
+                rd.read_object([&](const std::string &name) {
+                    modules.emplace_back(ctx->id(name), JsonModule());
+                    read_module(modules.back().second);
+                });
+            } else {
+                rd.skip_value();
+            }
+        });
+        if (rd.peek_value() != EOF)
+            rd.error("trailing data after netlist");
+        return found_modules;
+    }
+};
+
+struct JsonFrontendImpl
+{
+    // See specification in frontend_base.h
+    JsonFrontendImpl(Context *ctx, const std::vector<std::pair<IdString, JsonModule>> &modules)
+            : ctx(ctx), modules(modules){};
+    Context *ctx;
+    const std::vector<std::pair<IdString, JsonModule>> &modules;
+    typedef JsonModule ModuleDataType;
+    typedef JsonPort ModulePortDataType;
+    typedef JsonCell CellDataType;
+    typedef JsonNetname NetnameDataType;
+    typedef JsonBitVector BitVectorDataType;
+
+    template <typename TFunc> void foreach_module(TFunc Func) const
+    {
+        for (const auto &mod : modules)
+            Func(mod.first.str(ctx), mod.second);
+    }
+
+    template <typename TFunc> void foreach_port(const ModuleDataType &mod, TFunc Func) const
+    {
+        for (const auto &port : mod.ports)
+            Func(port.first.str(ctx), port.second);
     }
 
-    template <typename TFunc> void foreach_port_dir(CellDataType &cell, TFunc Func) const
+    template <typename TFunc> void foreach_cell(const ModuleDataType &mod, TFunc Func) const
     {
-        for (const auto &pdir : cell["port_directions"].object_items())
-            Func(pdir.first, lookup_portdir(pdir.second.string_value()));
+        for (const auto &cell : mod.cells)
+            Func(cell.first.str(ctx), cell.second);
     }
 
-    template <typename TFunc> void foreach_port_conn(CellDataType &cell, TFunc Func) const
+    template <typename TFunc> void foreach_netname(const ModuleDataType &mod, TFunc Func) const
     {
-        for (const auto &pconn : cell["connections"].object_items())
-            Func(pconn.first, pconn.second.array_items());
+        for (const auto &netname : mod.netnames)
+            Func(netname.first.str(ctx), netname.second);
     }
 
-    BitVectorDataType &get_net_bits(NetnameDataType &net) const { return net["bits"].array_items(); }
+    PortType get_port_dir(const ModulePortDataType &port) const { return port.dir; }
 
-    int get_vector_length(BitVectorDataType &bits) const { return int(bits.size()); }
+    template <typename TObj> int get_array_offset(const TObj &obj) const { return obj.offset; }
 
-    bool is_vector_bit_constant(BitVectorDataType &bits, int i) const
+    template <typename TObj> bool is_array_upto(const TObj &obj) const { return obj.upto; }
+
+    const BitVectorDataType &get_port_bits(const ModulePortDataType &port) const { return port.bits; }
+
+    const std::string &get_cell_type(const CellDataType &cell) const { return cell.type.str(ctx); }
+
+    template <typename TObj, typename TFunc> void foreach_attr(const TObj &obj, TFunc Func) const
     {
-        NPNR_ASSERT(i < int(bits.size()));
-        return bits[i].is_string();
+        for (const auto &attr : obj.attrs)
+            Func(attr.first.str(ctx), attr.second);
     }
 
-    char get_vector_bit_constval(BitVectorDataType &bits, int i) const
+    template <typename TFunc> void foreach_param(const CellDataType &cell, TFunc Func) const
     {
-        auto s = bits.at(i).string_value();
-        NPNR_ASSERT(s.size() == 1);
-        return s.at(0);
+        for (const auto &param : cell.params)
+            Func(param.first.str(ctx), param.second);
     }
 
-    int get_vector_bit_signal(BitVectorDataType &bits, int i) const
+    template <typename TFunc> void foreach_setting(const ModuleDataType &mod, TFunc Func) const
     {
-        NPNR_ASSERT(bits.at(i).is_number());
-        return bits.at(i).int_value();
+        for (const auto &setting : mod.settings)
+            Func(setting.first.str(ctx), setting.second);
+    }
+
+    template <typename TFunc> void foreach_port_dir(const CellDataType &cell, TFunc Func) const
+    {
+        for (const auto &pdir : cell.port_dirs)
+            Func(pdir.first.str(ctx), pdir.second);
+    }
+
+    template <typename TFunc> void foreach_port_conn(const CellDataType &cell, TFunc Func) const
+    {
+        for (const auto &pconn : cell.conns)
+            Func(pconn.first.str(ctx), pconn.second);
+    }
+
+    const BitVectorDataType &get_net_bits(const NetnameDataType &net) const { return net.bits; }
+
+    int get_vector_length(const BitVectorDataType &bits) const { return bits.len; }
+
+    bool is_vector_bit_constant(const BitVectorDataType &bits, int i) const
+    {
+        NPNR_ASSERT(i < bits.len);
+        return bits.data[i] < 0;
+    }
+
+    char get_vector_bit_constval(const BitVectorDataType &bits, int i) const
+    {
+        NPNR_ASSERT(i < bits.len && bits.data[i] < 0);
+        return char(-1 - bits.data[i]);
+    }
+
+    int get_vector_bit_signal(const BitVectorDataType &bits, int i) const
+    {
+        NPNR_ASSERT(i < bits.len && bits.data[i] >= 0);
+        return bits.data[i];
     }
 };
 
+} // namespace
+
 bool parse_json(std::istream &in, const std::string &filename, Context *ctx)
 {
-    Json root;
+    std::vector<std::pair<IdString, JsonModule>> modules;
     {
         if (!in)
             log_error("Failed to open JSON file '%s'.\n", filename.c_str());
-        std::string json_str((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
-        std::string error;
-        root = Json::parse(json_str, error, JsonParse::COMMENTS);
-        if (root.is_null())
-            log_error("Failed to parse JSON file '%s': %s.\n", filename.c_str(), error.c_str());
-        root = root["modules"];
-        if (root.is_null())
+        auto start = std::chrono::steady_clock::now();
+        JsonStreamReader rd(in, filename);
+        if (!JsonNetlistReader(ctx, rd).read_netlist(modules))
             log_error("JSON file '%s' doesn't look like a netlist (doesn't contain \"modules\" key)\n",
                       filename.c_str());
+        auto end = std::chrono::steady_clock::now();
+        double secs = std::chrono::duration<double>(end - start).count();
+        double mib = rd.bytes_read / (1024.0 * 1024.0);
+        log_info("Read %.1f MiB of JSON in %.2fs (%.1f MiB/s).\n", mib, secs, secs > 0 ? mib / secs : 0.0);
     }
-    GenericFrontend<JsonFrontendImpl>(ctx, JsonFrontendImpl(root), /*split_io=*/true)();
+    GenericFrontend<JsonFrontendImpl>(ctx, JsonFrontendImpl(ctx, modules), /*split_io=*/true)();
     return true;
 }
 
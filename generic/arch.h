@@ -270,6 +270,8 @@ struct Arch : BaseArch<ArchRanges>
     PortType getBelPinType(BelId bel, IdString pin) const override;
     std::vector<IdString> getBelPins(BelId bel) const override;
     const std::vector<IdString> &getBelPinsForCellPin(const CellInfo *cell_info, IdString pin) const override;
+    int getBelIndex(BelId bel) const override { return bel.index; }
+    int getBelIndexCount() const override { return int(bels.size()); }
 
     WireId getWireByName(IdStringList name) const override;
     IdStringList getWireName(WireId wire) const override;
@@ -285,6 +287,8 @@ struct Arch : BaseArch<ArchRanges>
     DelayQuad getWireDelay(WireId wire) const override { return DelayQuad(0); }
     linear_range<WireId> getWires() const override;
     const std::vector<BelPin> &getWireBelPins(WireId wire) const override;
+    int getWireIndex(WireId wire) const override { return wire.index; }
+    int getWireIndexCount() const override { return int(wires.size()); }
 
     PipId getPipByName(IdStringList name) const override;
     IdStringList getPipName(PipId pip) const override;
@@ -300,6 +304,8 @@ struct Arch : BaseArch<ArchRanges>
     NetInfo *getConflictingPipNet(PipId pip) const override;
     linear_range<PipId> getPips() const override;
     Loc getPipLocation(PipId pip) const override;
+    int getPipIndex(PipId pip) const override { return pip.index; }
+    int getPipIndexCount() const override { return int(pips.size()); }
     WireId getPipSrcWire(PipId pip) const override;
     WireId getPipDstWire(PipId pip) const override;
     DelayQuad getPipDelay(PipId pip) const override;
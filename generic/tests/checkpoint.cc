@@ -0,0 +1,242 @@
+/*
+ *  nextpnr -- Next Generation Place and Route
+ *
+ *  Copyright (C) 2023  The nextpnr Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include <boost/filesystem.hpp>
+#include <memory>
+#include "checkpoint.h"
+#include "gtest/gtest.h"
+#include "nextpnr.h"
+
+USING_NEXTPNR_NAMESPACE
+
+namespace {
+
+const int grid_size = 4;
+
+// A grid of single-LUT tiles, where any LUT output can reach any LUT input through one pip
+void build_fabric(Context *ctx)
+{
+    std::vector<WireId> outputs, inputs;
+    for (int x = 0; x < grid_size; x++) {
+        for (int y = 0; y < grid_size; y++) {
+            IdString tile = ctx->idf("X%dY%d", x, y);
+            BelId bel = ctx->addBel(IdStringList::concat(tile, ctx->id("LUT")), ctx->id("LUT"), Loc(x, y, 0), false,
+                                    false);
+            for (auto pin : {"I0", "I1"}) {
+                WireId wire = ctx->addWire(IdStringList::concat(tile, ctx->id(pin)), ctx->id("LUT_IN"), x, y);
+                ctx->addBelInput(bel, ctx->id(pin), wire);
+                inputs.push_back(wire);
+            }
+            WireId out = ctx->addWire(IdStringList::concat(tile, ctx->id("O")), ctx->id("LUT_OUT"), x, y);
+            ctx->addBelOutput(bel, ctx->id("O"), out);
+            outputs.push_back(out);
+        }
+    }
+    for (int i = 0; i < int(outputs.size()); i++) {
+        for (auto dst : inputs) {
+            ctx->addPip(IdStringList::concat(ctx->getWireName(dst), ctx->idf("FROM_%d", i)), ctx->id("SWITCH"),
+                        outputs.at(i), dst, ctx->getDelayFromNS(0.1), Loc(0, 0, 0));
+        }
+    }
+}
+
+// A context with the fabric and the settings that the command line handler would otherwise fill in
+std::unique_ptr<Context> make_context(const ArchArgs &args)
+{
+    auto ctx = std::make_unique<Context>(args);
+    ctx->settings[ctx->id("target_freq")] = std::to_string(12e6);
+    ctx->settings[ctx->id("timing_driven")] = true;
+    ctx->settings[ctx->id("slack_redist_iter")] = 0;
+    ctx->settings[ctx->id("auto_freq")] = false;
+    ctx->settings[ctx->id("placer")] = std::string("sa");
+    ctx->settings[ctx->id("router")] = std::string("router1");
+    build_fabric(ctx.get());
+    return ctx;
+}
+
+CellInfo *add_lut(Context *ctx, const char *name)
+{
+    CellInfo *cell = ctx->createCell(ctx->id(name), ctx->id("LUT"));
+    cell->addInput(ctx->id("I0"));
+    cell->addInput(ctx->id("I1"));
+    cell->addOutput(ctx->id("O"));
+    return cell;
+}
+
+class CheckpointTest : public ::testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        filename = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.npnrckpt"))
+                           .string();
+        ctx = make_context(chipArgs);
+    }
+
+    virtual void TearDown() { boost::filesystem::remove(filename); }
+
+    ArchArgs chipArgs;
+    std::unique_ptr<Context> ctx;
+    std::string filename;
+};
+
+} // namespace
+
+TEST_F(CheckpointTest, placed_routed_round_trip)
+{
+    // A few LUTs, with a net of several users to check their order is kept
+    std::vector<CellInfo *> luts;
+    for (auto name : {"a", "b", "c", "d", "e", "f"})
+        luts.push_back(add_lut(ctx.get(), name));
+    NetInfo *fanout = ctx->createNet(ctx->id("fanout"));
+    luts.at(0)->connectPort(ctx->id("O"), fanout);
+    for (int i = 1; i <= 3; i++)
+        luts.at(i)->connectPort(ctx->id("I0"), fanout);
+    NetInfo *chain = ctx->createNet(ctx->id("chain"));
+    luts.at(1)->connectPort(ctx->id("O"), chain);
+    luts.at(4)->connectPort(ctx->id("I1"), chain);
+    luts.at(5)->connectPort(ctx->id("I0"), chain);
+    luts.at(2)->connectPort(ctx->id("I1"), chain);
+    luts.at(0)->attrs[ctx->id("keep")] = Property(1, 1);
+    luts.at(4)->params[ctx->id("INIT")] = Property(0x6, 4);
+    ctx->net_aliases[ctx->id("fanout_alias")] = ctx->id("fanout");
+
+    ctx->assignArchInfo();
+    ASSERT_TRUE(ctx->place());
+    ASSERT_TRUE(ctx->route());
+    ctx->check();
+    ASSERT_EQ(ctx->nets.at(ctx->id("chain"))->wires.size(), 4U);
+    ASSERT_TRUE(write_checkpoint(filename, ctx.get()));
+
+    auto loaded = make_context(chipArgs);
+    ASSERT_TRUE(read_checkpoint(filename, loaded.get()));
+    loaded->check();
+
+    ASSERT_EQ(loaded->cells.size(), ctx->cells.size());
+    for (auto &cell : ctx->cells) {
+        const CellInfo *orig = cell.second.get();
+        ASSERT_TRUE(loaded->cells.count(loaded->id(cell.first.str(ctx.get()))));
+        const CellInfo *ci = loaded->cells.at(loaded->id(cell.first.str(ctx.get()))).get();
+        EXPECT_EQ(ci->type.str(loaded.get()), orig->type.str(ctx.get()));
+        EXPECT_EQ(loaded->getBelName(ci->bel).str(loaded.get()), ctx->getBelName(orig->bel).str(ctx.get()));
+        EXPECT_EQ(ci->belStrength, orig->belStrength);
+        EXPECT_EQ(ci->attrs.size(), orig->attrs.size());
+        EXPECT_EQ(ci->params.size(), orig->params.size());
+        for (auto &param : orig->params)
+            EXPECT_EQ(ci->params.at(loaded->id(param.first.str(ctx.get()))).as_int64(), param.second.as_int64());
+        ASSERT_EQ(ci->ports.size(), orig->ports.size());
+        for (auto &port : orig->ports) {
+            const PortInfo &p = ci->ports.at(loaded->id(port.first.str(ctx.get())));
+            EXPECT_EQ(p.type, port.second.type);
+            EXPECT_EQ(p.net ? p.net->name.str(loaded.get()) : "",
+                      port.second.net ? port.second.net->name.str(ctx.get()) : "");
+        }
+    }
+
+    ASSERT_EQ(loaded->nets.size(), ctx->nets.size());
+    for (auto &net : ctx->nets) {
+        const NetInfo *orig = net.second.get();
+        ASSERT_TRUE(loaded->nets.count(loaded->id(net.first.str(ctx.get()))));
+        const NetInfo *ni = loaded->nets.at(loaded->id(net.first.str(ctx.get()))).get();
+        ASSERT_EQ(bool(ni->driver.cell), bool(orig->driver.cell));
+        if (orig->driver.cell) {
+            EXPECT_EQ(ni->driver.cell->name.str(loaded.get()), orig->driver.cell->name.str(ctx.get()));
+        }
+        std::vector<std::string> orig_users, users;
+        for (auto &usr : orig->users)
+            orig_users.push_back(usr.cell->name.str(ctx.get()) + "." + usr.port.str(ctx.get()));
+        for (auto &usr : ni->users)
+            users.push_back(usr.cell->name.str(loaded.get()) + "." + usr.port.str(loaded.get()));
+        EXPECT_EQ(users, orig_users);
+        ASSERT_EQ(ni->wires.size(), orig->wires.size());
+        for (auto &wire : orig->wires) {
+            WireId w = loaded->getWireByName(
+                    IdStringList::parse(loaded.get(), ctx->getWireName(wire.first).str(ctx.get())));
+            ASSERT_TRUE(ni->wires.count(w));
+            const PipMap &pm = ni->wires.at(w);
+            EXPECT_EQ(pm.strength, wire.second.strength);
+            EXPECT_EQ(pm.pip == PipId() ? "" : loaded->getPipName(pm.pip).str(loaded.get()),
+                      wire.second.pip == PipId() ? "" : ctx->getPipName(wire.second.pip).str(ctx.get()));
+        }
+    }
+    EXPECT_EQ(loaded->net_aliases.at(loaded->id("fanout_alias")), loaded->id("fanout"));
+
+    // The bindings seen from the arch side must match the netlist, too
+    for (auto bel : loaded->getBels()) {
+        const CellInfo *bound = loaded->getBoundBelCell(bel);
+        if (bound) {
+            EXPECT_EQ(bound->bel, bel);
+        }
+    }
+    for (auto &net : loaded->nets)
+        for (auto &wire : net.second->wires)
+            EXPECT_EQ(loaded->getBoundWireNet(wire.first), net.second.get());
+}
+
+TEST_F(CheckpointTest, cluster_region_round_trip)
+{
+    CellInfo *root = add_lut(ctx.get(), "root");
+    CellInfo *child = add_lut(ctx.get(), "child");
+    root->cluster = root->name;
+    root->constr_children.push_back(child);
+    child->cluster = root->name;
+    child->constr_x = 1;
+    child->constr_y = -1;
+    child->constr_z = 0;
+    child->constr_abs_z = true;
+
+    ctx->createRectangularRegion(ctx->id("corner"), 0, 0, 1, 1);
+    ctx->constrainCellToRegion(root->name, ctx->id("corner"));
+    ctx->createRegionPlug(ctx->id("plug"), ctx->id("PLUG"), Loc(3, 3, 0));
+    ctx->addPlugPin(ctx->id("plug"), ctx->id("O"), PORT_OUT,
+                    ctx->getWireByName(IdStringList::parse(ctx.get(), "X3Y3/O")));
+    ASSERT_TRUE(write_checkpoint(filename, ctx.get()));
+
+    auto loaded = make_context(chipArgs);
+    ASSERT_TRUE(read_checkpoint(filename, loaded.get()));
+
+    const CellInfo *l_root = loaded->cells.at(loaded->id("root")).get();
+    const CellInfo *l_child = loaded->cells.at(loaded->id("child")).get();
+    EXPECT_EQ(l_root->cluster, l_root->name);
+    EXPECT_EQ(l_child->cluster, l_root->name);
+    ASSERT_EQ(l_root->constr_children.size(), 1U);
+    EXPECT_EQ(l_root->constr_children.at(0), l_child);
+    EXPECT_EQ(l_child->constr_x, 1);
+    EXPECT_EQ(l_child->constr_y, -1);
+    EXPECT_EQ(l_child->constr_z, 0);
+    EXPECT_TRUE(l_child->constr_abs_z);
+
+    ASSERT_TRUE(loaded->region.count(loaded->id("corner")));
+    const Region *r = loaded->region.at(loaded->id("corner")).get();
+    EXPECT_EQ(l_root->region, r);
+    EXPECT_EQ(l_child->region, nullptr);
+    EXPECT_TRUE(r->constr_bels);
+    EXPECT_EQ(r->bels.size(), 4U);
+    for (BelId bel : r->bels) {
+        Loc loc = loaded->getBelLocation(bel);
+        EXPECT_TRUE(loc.x <= 1 && loc.y <= 1);
+    }
+
+    const CellInfo *l_plug = loaded->cells.at(loaded->id("plug")).get();
+    auto plug = dynamic_cast<const RegionPlug *>(l_plug->pseudo_cell.get());
+    ASSERT_NE(plug, nullptr);
+    EXPECT_EQ(plug->loc, Loc(3, 3, 0));
+    EXPECT_EQ(loaded->getWireName(plug->port_wires.at(loaded->id("O"))).str(loaded.get()), "X3Y3/O");
+    EXPECT_EQ(l_plug->ports.at(loaded->id("O")).type, PORT_OUT);
+}
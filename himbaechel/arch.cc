@@ -139,6 +139,16 @@ void Arch::init_tiles()
             tile_name2idx[name] = tile;
         }
     }
+    for (auto offset : {&tile_bel_offset, &tile_wire_offset, &tile_pip_offset}) {
+        offset->reserve(chip_info->tile_insts.size() + 1);
+        offset->push_back(0);
+    }
+    for (int tile = 0; tile < chip_info->tile_insts.ssize(); tile++) {
+        const auto &tile_data = chip_tile_info(chip_info, tile);
+        tile_bel_offset.push_back(tile_bel_offset.back() + tile_data.bels.ssize());
+        tile_wire_offset.push_back(tile_wire_offset.back() + tile_data.wires.ssize());
+        tile_pip_offset.push_back(tile_pip_offset.back() + tile_data.pips.ssize());
+    }
 }
 
 void Arch::late_init()
@@ -230,6 +240,11 @@ bool Arch::route()
 {
     set_fast_pip_delays(true);
     uarch->preRoute();
+    lookahead.init(getCtx(),
+                   stringf("himbaechel/%s/%s/%s/%d/%s", chip_info->uarch.get(), chip_info->name.get(),
+                           chip_info->generator.get(), int(chip_info->version),
+                           speed_grade ? IdString(speed_grade->name).c_str(this) : ""),
+                   blob_file.data(), blob_file.size());
     std::string router = str_or_default(settings, id("router"), defaultRouter);
     bool result;
     if (router == "router1") {
@@ -29,6 +29,7 @@
 #include "himbaechel_api.h"
 #include "nextpnr_namespaces.h"
 #include "nextpnr_types.h"
+#include "router_lookahead.h"
 
 NEXTPNR_NAMESPACE_BEGIN
 
@@ -493,6 +494,8 @@ struct Arch : BaseArch<ArchRanges>
         return IdString(chip_wire_info(chip_info, wire).const_value);
     }
     WireRange getWires() const override { return WireRange(chip_info); }
+    int getWireIndex(WireId wire) const override { return tile_wire_offset[wire.tile] + wire.index; }
+    int getWireIndexCount() const override { return tile_wire_offset.back(); }
     bool checkWireAvail(WireId wire) const override
     {
         if (!uarch->checkWireAvail(wire))
@@ -522,6 +525,8 @@ struct Arch : BaseArch<ArchRanges>
         loc.z = 0;
         return loc;
     }
+    int getPipIndex(PipId pip) const override { return tile_pip_offset[pip.tile] + pip.index; }
+    int getPipIndexCount() const override { return tile_pip_offset.back(); }
     IdString getPipType(PipId pip) const override;
     WireId getPipSrcWire(PipId pip) const override
     {
@@ -650,13 +655,13 @@ struct Arch : BaseArch<ArchRanges>
     void bindBel(BelId bel, CellInfo *cell, PlaceStrength strength) override
     {
         uarch->notifyBelChange(bel, cell);
-        BaseArch::bindBel(bel, cell, strength); // TODO: faster?
+        BaseArch::bindBel(bel, cell, strength);
     }
 
     void unbindBel(BelId bel) override
     {
         uarch->notifyBelChange(bel, nullptr);
-        BaseArch::unbindBel(bel); // TODO: faster?
+        BaseArch::unbindBel(bel);
         // TODO: fast tile status and bind
     }
 
@@ -670,6 +675,14 @@ struct Arch : BaseArch<ArchRanges>
 
     // getBoundBelCell: BaseArch
 
+    bool isBelBindingPartitionSafe(BelId bel) const override
+    {
+        // Once the dense binding table has been sized by the first bind, every bel has its own slot in it
+        return !dense_bel2cell.empty() && uarch->isBelBindingPartitionSafe(bel);
+    }
+    int getBelIndex(BelId bel) const override { return tile_bel_offset[bel.tile] + bel.index; }
+    int getBelIndexCount() const override { return tile_bel_offset.back(); }
+
     // ------------------------------------------------
 
     BelBucketId getBelBucketForCellType(IdString cell_type) const override
@@ -789,6 +802,10 @@ struct Arch : BaseArch<ArchRanges>
     void set_fast_pip_delays(bool fast_mode);
     std::vector<IdString> tile_name;
     dict<IdString, int> tile_name2idx;
+    // Prefix sums of bels, wires and pips per tile, for dense indices; one extra entry at the end for the total
+    std::vector<int> tile_bel_offset, tile_wire_offset, tile_pip_offset;
+    // Optional sampled lookahead used by the default HimbaechelAPI::estimateDelay, see router_lookahead.h
+    RouterLookahead lookahead;
 
     // -------------------------------------------------
     IdString get_tile_type(int tile) const;
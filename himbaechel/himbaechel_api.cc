@@ -43,7 +43,9 @@ bool HimbaechelAPI::isValidBelForCellType(IdString cell_type, BelId bel) const
 
 delay_t HimbaechelAPI::estimateDelay(WireId src, WireId dst) const
 {
-    // TODO: configurable lookahead
+    delay_t lookahead_delay;
+    if (ctx->lookahead.estimate(src, dst, lookahead_delay))
+        return lookahead_delay;
     int sx, sy, dx, dy;
     tile_xy(ctx->chip_info, src.tile, sx, sy);
     tile_xy(ctx->chip_info, dst.tile, dx, dy);
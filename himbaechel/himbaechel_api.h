@@ -79,6 +79,8 @@ struct HimbaechelAPI
     virtual BelBucketId getBelBucketForCellType(IdString cell_type) const;
     virtual bool isValidBelForCellType(IdString cell_type, BelId bel) const;
     virtual bool isBelLocationValid(BelId bel, bool explain_invalid = false) const { return true; }
+    // Return true if notifyBelChange and isBelLocationValid for this bel only touch state belonging to its own tile
+    virtual bool isBelBindingPartitionSafe(BelId bel) const { return false; }
 
     // --- Wire and pip functions ---
     // Called when a wire/pip is placed/unplaced (with net=nullptr for a unbind)
@@ -79,6 +79,9 @@ struct ExampleImpl : HimbaechelAPI
         }
     }
 
+    // Validity only looks at the slices of the bel's own tile
+    bool isBelBindingPartitionSafe(BelId bel) const override { return true; }
+
     // Bel bucket functions
     IdString getBelBucketForCellType(IdString cell_type) const override
     {
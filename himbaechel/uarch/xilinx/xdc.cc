@@ -21,6 +21,7 @@
 #include <fstream>
 #include <regex>
 
+#include "design_name_index.h"
 #include "extra_data.h"
 #include "himbaechel_api.h"
 #include "log.h"
@@ -89,6 +90,9 @@ void XilinxImpl::parse_xdc(const std::string &filename)
         return split_args;
     };
 
+    // Top-level ports are matched against the IO buffer cells, which are named after them
+    DesignNameIndex names(ctx);
+
     auto get_cells = [&](std::string str) {
         std::vector<CellInfo *> tgt_cells;
         if (str.empty() || str.front() != '[')
@@ -101,9 +105,15 @@ void XilinxImpl::parse_xdc(const std::string &filename)
             log_error("targets other than 'get_ports' are not supported (on line %d)\n", lineno);
         if (split.size() < 2)
             log_error("failed to parse target (on line %d)\n", lineno);
-        IdString cellname = ctx->id(strip_quotes(split.at(1)));
-        if (ctx->cells.count(cellname))
-            tgt_cells.push_back(ctx->cells.at(cellname).get());
+        bool regexp = false;
+        for (size_t i = 1; i < split.size(); i++) {
+            if (split.at(i) == "-regexp") {
+                regexp = true;
+                continue;
+            }
+            for (auto cellname : names.get_cells(strip_quotes(split.at(i)), regexp))
+                tgt_cells.push_back(ctx->cells.at(cellname).get());
+        }
         return tgt_cells;
     };
 
@@ -119,10 +129,15 @@ void XilinxImpl::parse_xdc(const std::string &filename)
             log_error("targets other than 'get_ports' or 'get_nets' are not supported (on line %d)\n", lineno);
         if (split.size() < 2)
             log_error("failed to parse target (on line %d)\n", lineno);
-        IdString netname = ctx->id(split.at(1));
-        NetInfo *maybe_net = ctx->getNetByAlias(netname);
-        if (maybe_net != nullptr)
-            tgt_nets.push_back(maybe_net);
+        bool regexp = false;
+        for (size_t i = 1; i < split.size(); i++) {
+            if (split.at(i) == "-regexp") {
+                regexp = true;
+                continue;
+            }
+            for (auto netname : names.get_nets(split.at(i), regexp))
+                tgt_nets.push_back(ctx->nets.at(netname).get());
+        }
         return tgt_nets;
     };
 
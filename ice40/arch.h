@@ -405,7 +405,8 @@ struct Arch : BaseArch<ArchRanges>
     mutable dict<IdStringList, int> pip_by_name;
     mutable dict<Loc, int> bel_by_loc;
 
-    std::vector<bool> bel_carry;
+    // Bytes rather than bools so that bels in different tiles can be bound at the same time
+    std::vector<uint8_t> bel_carry;
     std::vector<CellInfo *> bel_to_cell;
     std::vector<NetInfo *> wire_to_net;
     std::vector<NetInfo *> pip_to_net;
@@ -470,6 +471,12 @@ struct Arch : BaseArch<ArchRanges>
         refreshUiBel(bel);
     }
 
+    bool isBelBindingPartitionSafe(BelId bel) const override
+    {
+        // Logic cell validity only depends on the other logic cells in the tile
+        return getBelType(bel) == id_ICESTORM_LC;
+    }
+
     bool checkBelAvail(BelId bel) const override
     {
         NPNR_ASSERT(bel != BelId());
@@ -608,6 +615,9 @@ struct Arch : BaseArch<ArchRanges>
         return range;
     }
 
+    int getWireIndex(WireId wire) const override { return wire.index; }
+    int getWireIndexCount() const override { return chip_info->wire_data.size(); }
+
     // -------------------------------------------------
 
     PipId getPipByName(IdStringList name) const override;
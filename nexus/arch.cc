@@ -128,6 +128,10 @@ Arch::Arch(ArchArgs args) : args(args)
         ts.boundwires.resize(loc.wires.size());
         ts.boundpips.resize(loc.pips.size());
     }
+    tile_wire_offset.reserve(chip_info->grid.size() + 1);
+    tile_wire_offset.push_back(0);
+    for (size_t i = 0; i < chip_info->grid.size(); i++)
+        tile_wire_offset.push_back(tile_wire_offset.back() + db->loctypes[chip_info->grid[i].loc_type].wires.ssize());
 
     for (int i = 0; i < chip_info->width; i++) {
         IdString x_id = idf("X%d", i);
@@ -680,6 +684,9 @@ delay_t Arch::estimateDelay(WireId src, WireId dst) const
     const auto &dst_data = wire_data(dst);
     if (src.tile == 0 && dst_data.name == ID_LOCAL_VCC)
         return 0;
+    delay_t lookahead_delay;
+    if (lookahead.estimate(src, dst, lookahead_delay))
+        return lookahead_delay;
     int src_x = src.tile % chip_info->width, src_y = src.tile / chip_info->width;
     int dst_x = dst.tile % chip_info->width, dst_y = dst.tile / chip_info->width;
     int dist_x = std::abs(src_x - dst_x);
@@ -813,6 +820,9 @@ bool Arch::route()
 
     route_globals();
 
+    std::string chipdb = stringf("nexus/chipdb-%s.bin", family.c_str());
+    lookahead.init(getCtx(), "nexus/" + args.device, get_chipdb(chipdb), get_chipdb_size(chipdb));
+
     std::string router = str_or_default(settings, id_router, defaultRouter);
     bool result;
     if (router == "router1") {
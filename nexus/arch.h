@@ -28,6 +28,7 @@
 #include "nextpnr_namespaces.h"
 #include "nextpnr_types.h"
 #include "relptr.h"
+#include "router_lookahead.h"
 
 NEXTPNR_NAMESPACE_BEGIN
 
@@ -917,6 +918,8 @@ struct Arch : BaseArch<ArchRanges>
     };
 
     std::vector<TileStatus> tileStatus;
+    // Prefix sum of tile wire counts, for dense wire indices
+    std::vector<int> tile_wire_offset;
 
     // fast access to  X and Y IdStrings for building object names
     std::vector<IdString> x_ids, y_ids;
@@ -1075,6 +1078,12 @@ struct Arch : BaseArch<ArchRanges>
         return type.in(id_DCC, id_VCC_DRV);
     }
 
+    bool isBelBindingPartitionSafe(BelId /*bel*/) const override
+    {
+        // Every bel has its own binding slot, and logic tile state is only touched by the bels of that logic tile
+        return true;
+    }
+
     IdString getBelType(BelId bel) const override
     {
         NPNR_ASSERT(bel != BelId());
@@ -1138,6 +1147,9 @@ struct Arch : BaseArch<ArchRanges>
         return range;
     }
 
+    int getWireIndex(WireId wire) const override { return tile_wire_offset[wire.tile] + wire.index; }
+    int getWireIndexCount() const override { return tile_wire_offset.back(); }
+
     void bindWire(WireId wire, NetInfo *net, PlaceStrength strength) override
     {
         NPNR_ASSERT(wire != WireId());
@@ -1298,6 +1310,8 @@ struct Arch : BaseArch<ArchRanges>
     // -------------------------------------------------
 
     int32_t estimate_delay_mult;
+    // Optional sampled lookahead used by estimateDelay, see router_lookahead.h
+    RouterLookahead lookahead;
     delay_t estimateDelay(WireId src, WireId dst) const override;
     delay_t predictDelay(BelId src_bel, IdString src_pin, BelId dst_bel, IdString dst_pin) const override;
     delay_t getDelayEpsilon() const override { return 20; }
@@ -2,11 +2,20 @@ use nextpnr::{Context, Nets};
 
 #[no_mangle]
 pub extern "C" fn rust_example_printnets(ctx: &mut Context) {
+    let graph = ctx.graph_snapshot();
+    println!(
+        "Routing graph: {} wires, {} pips",
+        graph.wires().len(),
+        graph.pips().len()
+    );
+    drop(graph);
+
     let nets = Nets::new(ctx);
     let nets_vec = nets.to_vec();
 
     println!("Nets in design:");
     for (&name, _net) in nets_vec {
-        println!("  {}", ctx.name_of(name).to_str().unwrap());
+        let sinks = nets.users_by_name(name).map_or(0, |users| users.len());
+        println!("  {} ({} sinks)", ctx.name_of(name).to_str().unwrap(), sinks);
     }
 }
@@ -239,16 +239,9 @@ impl Context {
         v
     }
 
-    pub fn wires_leaking(&self) -> &[WireId] {
-        let mut wires = std::ptr::null_mut();
-        let len = unsafe { npnr_context_get_wires_leak(self, &mut wires as *mut *mut WireId) };
-        unsafe { std::slice::from_raw_parts(wires, len as usize) }
-    }
-
-    pub fn pips_leaking(&self) -> &[PipId] {
-        let mut pips = std::ptr::null_mut();
-        let len = unsafe { npnr_context_get_pips_leak(self, &mut pips as *mut *mut PipId) };
-        unsafe { std::slice::from_raw_parts(pips, len as usize) }
+    /// Take a snapshot of the routing graph and the net endpoints, as flat arrays.
+    pub fn graph_snapshot(&self) -> GraphSnapshot {
+        GraphSnapshot::new(self)
     }
 
     pub fn get_downhill_pips(&self, wire: WireId) -> DownhillPipsIter {
@@ -377,8 +370,6 @@ extern "C" {
     fn npnr_context_delay_epsilon(ctx: &Context) -> f32;
     fn npnr_context_get_pip_delay(ctx: &Context, pip: PipId) -> f32;
     fn npnr_context_get_wire_delay(ctx: &Context, wire: WireId) -> f32;
-    fn npnr_context_get_wires_leak(ctx: &Context, wires: *mut *mut WireId) -> u64;
-    fn npnr_context_get_pips_leak(ctx: &Context, pips: *mut *mut PipId) -> u64;
     fn npnr_context_get_pip_location(ctx: &Context, pip: PipId) -> Loc;
     fn npnr_context_check_pip_avail_for_net(
         ctx: &Context,
@@ -402,18 +393,16 @@ extern "C" {
         n: u32,
     ) -> WireId;
 
-    fn npnr_context_nets_leak(
-        ctx: &Context,
-        names: *mut *mut libc::c_int,
-        nets: *mut *mut *mut NetInfo,
-    ) -> u32;
+    fn npnr_context_graph_snapshot(ctx: &Context) -> *mut RawGraphSnapshot;
+    fn npnr_delete_graph_snapshot(snapshot: *mut RawGraphSnapshot);
+    fn npnr_graph_snapshot_view(snapshot: *const RawGraphSnapshot) -> RawGraphSnapshotView;
+    fn npnr_graph_snapshot_wire_index(snapshot: *const RawGraphSnapshot, wire: WireId) -> i32;
     fn npnr_context_get_pips_downhill(ctx: &Context, wire: WireId) -> &mut RawDownhillIter;
     fn npnr_delete_downhill_iter(iter: &mut RawDownhillIter);
     fn npnr_context_get_pips_uphill(ctx: &Context, wire: WireId) -> &mut RawUphillIter;
     fn npnr_delete_uphill_iter(iter: &mut RawUphillIter);
 
     fn npnr_netinfo_driver(net: &mut NetInfo) -> Option<&mut PortRef>;
-    fn npnr_netinfo_users_leak(net: &NetInfo, users: *mut *mut *const PortRef) -> u32;
     fn npnr_netinfo_is_global(net: &NetInfo) -> bool;
     fn npnr_netinfo_udata(net: &NetInfo) -> NetIndex;
     fn npnr_netinfo_udata_set(net: &mut NetInfo, value: NetIndex);
@@ -429,61 +418,186 @@ extern "C" {
     fn npnr_is_uphill_iter_done(iter: &mut RawUphillIter) -> bool;
 }
 
+#[repr(C)]
+struct RawGraphSnapshot {
+    content: [u8; 0],
+}
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+struct RawGraphSnapshotView {
+    wires: *const WireId,
+    wire_count: u64,
+    pips: *const PipId,
+    pip_src: *const i32,
+    pip_dst: *const i32,
+    pip_count: u64,
+    downhill_begin: *const i32,
+    nets: *const *mut NetInfo,
+    net_names: *const IdString,
+    net_source: *const i32,
+    net_count: u64,
+    sink_begin: *const i32,
+    sink_ports: *const *mut PortRef,
+    sink_wire: *const i32,
+    sink_count: u64,
+}
+
+/// Make a slice from an array owned by a snapshot; `len` may be zero, in which case `data` may be null.
+unsafe fn snapshot_slice<'a, T>(data: *const T, len: u64) -> &'a [T] {
+    if len == 0 {
+        &[]
+    } else {
+        slice::from_raw_parts(data, len as usize)
+    }
+}
+
+/// Snapshot of the routing graph and the net endpoints of a context, in compressed sparse row form.
+///
+/// Wires, pips and nets are numbered densely. The pips downhill of wire `w` are `downhill_begin()[w] ..
+/// downhill_begin()[w + 1]`, and the sinks of net `n` are `sink_begin()[n] .. sink_begin()[n + 1]` in the sink arrays.
+/// Wire numbers of -1 mean "no wire". Wire numbers are the arch's dense wire indices, which may have gaps: `wires()`
+/// holds `WireId::null()` for a number without a wire. The arrays are owned by nextpnr and freed when the snapshot is
+/// dropped.
+pub struct GraphSnapshot<'a> {
+    raw: *mut RawGraphSnapshot,
+    view: RawGraphSnapshotView,
+    ctx: &'a Context,
+}
+
+impl<'a> GraphSnapshot<'a> {
+    pub fn new(ctx: &'a Context) -> GraphSnapshot<'a> {
+        let raw = unsafe { npnr_context_graph_snapshot(ctx) };
+        let view = unsafe { npnr_graph_snapshot_view(raw) };
+        Self { raw, view, ctx }
+    }
+
+    /// Return the dense number of a wire, or -1 if the wire is not in the snapshot.
+    pub fn wire_index(&self, wire: WireId) -> i32 {
+        unsafe { npnr_graph_snapshot_wire_index(self.raw, wire) }
+    }
+
+    /// The wire of each wire number; `WireId::null()` for a gap in the numbering.
+    pub fn wires(&self) -> &[WireId] {
+        unsafe { snapshot_slice(self.view.wires, self.view.wire_count) }
+    }
+
+    /// Return the name of a wire number, or `None` for a gap in the numbering. Panics if `wire` is not below
+    /// `wires().len()`.
+    pub fn wire_name(&self, wire: usize) -> Option<&CStr> {
+        let wire = self.wires()[wire];
+        if wire.is_null() {
+            None
+        } else {
+            Some(self.ctx.name_of_wire(wire))
+        }
+    }
+
+    pub fn pips(&self) -> &[PipId] {
+        unsafe { snapshot_slice(self.view.pips, self.view.pip_count) }
+    }
+
+    /// Source wire number of each pip.
+    pub fn pip_src(&self) -> &[i32] {
+        unsafe { snapshot_slice(self.view.pip_src, self.view.pip_count) }
+    }
+
+    /// Destination wire number of each pip.
+    pub fn pip_dst(&self) -> &[i32] {
+        unsafe { snapshot_slice(self.view.pip_dst, self.view.pip_count) }
+    }
+
+    /// Offsets of each wire's downhill pips; one entry more than there are wires.
+    pub fn downhill_begin(&self) -> &[i32] {
+        unsafe { snapshot_slice(self.view.downhill_begin, self.view.wire_count + 1) }
+    }
+
+    /// Numbers of the pips downhill of a wire.
+    pub fn downhill(&self, wire: usize) -> std::ops::Range<usize> {
+        let begin = self.downhill_begin();
+        begin[wire] as usize..begin[wire + 1] as usize
+    }
+
+    pub fn nets(&self) -> &[&NetInfo] {
+        // SAFETY: the pointers are all non-null, so have the same representation as references.
+        unsafe { snapshot_slice(self.view.nets as *const &NetInfo, self.view.net_count) }
+    }
+
+    pub fn net_names(&self) -> &[IdString] {
+        unsafe { snapshot_slice(self.view.net_names, self.view.net_count) }
+    }
+
+    /// Source wire number of each net.
+    pub fn net_source(&self) -> &[i32] {
+        unsafe { snapshot_slice(self.view.net_source, self.view.net_count) }
+    }
+
+    /// Offsets of each net's sinks; one entry more than there are nets.
+    pub fn sink_begin(&self) -> &[i32] {
+        unsafe { snapshot_slice(self.view.sink_begin, self.view.net_count + 1) }
+    }
+
+    pub fn sink_ports(&self) -> &[&PortRef] {
+        // SAFETY: the pointers are all non-null, so have the same representation as references.
+        unsafe { snapshot_slice(self.view.sink_ports as *const &PortRef, self.view.sink_count) }
+    }
+
+    /// First sink wire number of each sink.
+    pub fn sink_wire(&self) -> &[i32] {
+        unsafe { snapshot_slice(self.view.sink_wire, self.view.sink_count) }
+    }
+
+    /// Sinks of a net.
+    pub fn sinks(&self, net: usize) -> &[&PortRef] {
+        let begin = self.sink_begin();
+        &self.sink_ports()[begin[net] as usize..begin[net + 1] as usize]
+    }
+}
+
+impl<'a> Drop for GraphSnapshot<'a> {
+    fn drop(&mut self) {
+        unsafe { npnr_delete_graph_snapshot(self.raw) };
+    }
+}
+
 /// Store for the nets of a context.
 pub struct Nets<'a> {
+    snapshot: GraphSnapshot<'a>,
     nets: HashMap<IdString, &'a mut NetInfo>,
-    users: HashMap<IdString, &'a [&'a PortRef]>,
+    net_to_index: HashMap<IdString, usize>,
     index_to_net: Vec<IdString>,
-    _data: PhantomData<&'a Context>,
 }
 
 impl<'a> Nets<'a> {
     /// Create a new store for the nets of a context.
-    ///
-    /// Note that this leaks memory created by nextpnr; the intention is this is called once.
     pub fn new(ctx: &'a Context) -> Nets<'a> {
-        let mut names: *mut libc::c_int = std::ptr::null_mut();
-        let mut nets_ptr: *mut *mut NetInfo = std::ptr::null_mut();
-        let size = unsafe {
-            npnr_context_nets_leak(
-                ctx,
-                &mut names as *mut *mut libc::c_int,
-                &mut nets_ptr as *mut *mut *mut NetInfo,
-            )
-        };
+        let snapshot = GraphSnapshot::new(ctx);
         let mut nets = HashMap::new();
-        let mut users = HashMap::new();
+        let mut net_to_index = HashMap::new();
         let mut index_to_net = Vec::new();
-        for i in 0..size {
-            let name = unsafe { IdString(*names.add(i as usize)) };
-            let net = unsafe { &mut **nets_ptr.add(i as usize) };
-            let mut users_ptr = std::ptr::null_mut();
-            // SAFETY: net is not null because it's a &mut, and users is only written to.
-            // Leaking memory is the most convenient FFI I could think of.
-            let len =
-                unsafe { npnr_netinfo_users_leak(net, &mut users_ptr as *mut *mut *const PortRef) };
-            let users_slice =
-                unsafe { slice::from_raw_parts(users_ptr as *mut &PortRef, len as usize) };
+        for (i, &name) in snapshot.net_names().iter().enumerate() {
+            let net = unsafe { &mut **snapshot.view.nets.add(i) };
             let index = index_to_net.len() as i32;
             index_to_net.push(name);
             unsafe {
                 npnr_netinfo_udata_set(net, NetIndex(index));
             }
             nets.insert(name, net);
-            users.insert(name, users_slice);
+            net_to_index.insert(name, i);
         }
-        // Note: the contents of `names` and `nets_ptr` are now lost.
         Self {
+            snapshot,
             nets,
-            users,
+            net_to_index,
             index_to_net,
-            _data: PhantomData,
         }
     }
 
     /// Find net users given a net's name.
-    pub fn users_by_name(&self, net: IdString) -> Option<&&[&PortRef]> {
-        self.users.get(&net)
+    pub fn users_by_name(&self, net: IdString) -> Option<&[&PortRef]> {
+        self.net_to_index
+            .get(&net)
+            .map(|&index| self.snapshot.sinks(index))
     }
 
     /// Return the number of nets in the store.
@@ -17,7 +17,8 @@
  */
 
 #include <array>
-#include <numeric>
+#include <vector>
+#include "graph_snapshot.h"
 #include "log.h"
 #include "nextpnr.h"
 
@@ -74,6 +75,50 @@ struct UphillIterWrapper
     UphillIterWrapper(UphillIter begin, UphillIter end) : current(begin), end(end) {}
 };
 
+// RoutingGraphSnapshot, plus the ids in the form they are passed to Rust in
+struct GraphSnapshotWrapper
+{
+    RoutingGraphSnapshot graph;
+    std::vector<uint64_t> wires;
+    std::vector<uint64_t> pips;
+    std::vector<int> net_names;
+
+    explicit GraphSnapshotWrapper(const Context *ctx) : graph(ctx)
+    {
+        wires.reserve(graph.wires.size());
+        for (auto wire : graph.wires)
+            wires.push_back(wrap(wire));
+        pips.reserve(graph.pips.size());
+        for (auto pip : graph.pips)
+            pips.push_back(wrap(pip));
+        net_names.reserve(graph.nets.size());
+        for (auto net : graph.nets)
+            net_names.push_back(net->name.index);
+    }
+};
+
+// Pointers into a GraphSnapshotWrapper, valid until it is deleted. Mirrored by RawGraphSnapshotView in Rust
+struct GraphSnapshotView
+{
+    const uint64_t *wires;
+    uint64_t wire_count;
+    const uint64_t *pips;
+    const int32_t *pip_src;
+    const int32_t *pip_dst;
+    uint64_t pip_count;
+    // wire_count + 1 entries
+    const int32_t *downhill_begin;
+    NetInfo *const *nets;
+    const int *net_names;
+    const int32_t *net_source;
+    uint64_t net_count;
+    // net_count + 1 entries
+    const int32_t *sink_begin;
+    PortRef *const *sink_ports;
+    const int32_t *sink_wire;
+    uint64_t sink_count;
+};
+
 extern "C" {
 USING_NEXTPNR_NAMESPACE;
 
@@ -129,36 +174,6 @@ bool npnr_context_check_pip_avail_for_net(const Context *ctx, uint64_t pip, NetI
     return ctx->checkPipAvailForNet(unwrap_pip(pip), net);
 }
 
-uint64_t npnr_context_get_pips_leak(const Context *ctx, uint64_t **const pips)
-{
-    const auto ctx_pips{ctx->getPips()};
-    const auto size{std::accumulate(ctx_pips.begin(), ctx_pips.end(), /*initial value*/ size_t{},
-                                    [](size_t value, const auto & /*pip*/) { return value + 1U; })};
-    *pips = new uint64_t[size];
-    auto idx = 0;
-    for (const auto &pip : ctx_pips) {
-        (*pips)[idx] = wrap(pip);
-        idx++;
-    }
-    // Yes, by never deleting pip_vec, we leak memory.
-    return size;
-}
-
-uint64_t npnr_context_get_wires_leak(const Context *ctx, uint64_t **const wires)
-{
-    const auto ctx_wires{ctx->getWires()};
-    const auto size{std::accumulate(ctx_wires.begin(), ctx_wires.end(), /*initial value*/ size_t{},
-                                    [](size_t value, const auto & /*wire*/) { return value + 1U; })};
-    *wires = new uint64_t[size];
-    auto idx = 0;
-    for (const auto &wire : ctx_wires) {
-        (*wires)[idx] = wrap(wire);
-        idx++;
-    }
-    // Yes, by never deleting wires, we leak memory.
-    return size;
-}
-
 void npnr_context_check(const Context *ctx) { ctx->check(); }
 bool npnr_context_debug(const Context *ctx) { return ctx->debug; }
 int npnr_context_id(const Context *ctx, const char *str) { return ctx->id(str).hash(); }
@@ -176,19 +191,32 @@ uint64_t npnr_context_get_netinfo_sink_wire(const Context *ctx, const NetInfo *n
     return wrap(ctx->getNetinfoSinkWire(net, *sink, n));
 }
 
-uint32_t npnr_context_nets_leak(const Context *ctx, int **names, NetInfo ***nets)
+GraphSnapshotWrapper *npnr_context_graph_snapshot(const Context *ctx) { return new GraphSnapshotWrapper(ctx); }
+void npnr_delete_graph_snapshot(GraphSnapshotWrapper *snapshot) { delete snapshot; }
+GraphSnapshotView npnr_graph_snapshot_view(const GraphSnapshotWrapper *snapshot)
 {
-    auto size = ctx->nets.size();
-    *names = new int[size];
-    *nets = new NetInfo *[size];
-    auto idx = 0;
-    for (auto &item : ctx->nets) {
-        (*names)[idx] = item.first.index;
-        (*nets)[idx] = item.second.get();
-        idx++;
-    }
-    // Yes, by never deleting `names` and `nets` we leak memory.
-    return size;
+    const RoutingGraphSnapshot &graph = snapshot->graph;
+    GraphSnapshotView view;
+    view.wires = snapshot->wires.data();
+    view.wire_count = snapshot->wires.size();
+    view.pips = snapshot->pips.data();
+    view.pip_src = graph.pip_src.data();
+    view.pip_dst = graph.pip_dst.data();
+    view.pip_count = snapshot->pips.size();
+    view.downhill_begin = graph.downhill_begin.data();
+    view.nets = graph.nets.data();
+    view.net_names = snapshot->net_names.data();
+    view.net_source = graph.net_source.data();
+    view.net_count = graph.nets.size();
+    view.sink_begin = graph.sink_begin.data();
+    view.sink_ports = graph.sink_ports.data();
+    view.sink_wire = graph.sink_wire.data();
+    view.sink_count = graph.sink_ports.size();
+    return view;
+}
+int32_t npnr_graph_snapshot_wire_index(const GraphSnapshotWrapper *snapshot, uint64_t wire)
+{
+    return snapshot->graph.wire_index(unwrap_wire(wire));
 }
 
 DownhillIterWrapper *npnr_context_get_pips_downhill(Context *ctx, uint64_t wire_id)
@@ -214,19 +242,6 @@ PortRef *npnr_netinfo_driver(NetInfo *net)
     return &net->driver;
 }
 
-uint32_t npnr_netinfo_users_leak(const NetInfo *net, const PortRef ***users)
-{
-    auto size = net->users.entries();
-    *users = new const PortRef *[size];
-    auto idx = 0;
-    for (auto &item : net->users) {
-        (*users)[idx] = &item;
-        idx++;
-    }
-    // Yes, by not freeing `users`, we leak memory.
-    return size;
-}
-
 #ifdef ARCH_ECP5
 bool npnr_netinfo_is_global(NetInfo *net) { return net->is_global; }
 #else
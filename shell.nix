@@ -6,7 +6,6 @@ let
 in pkgs.mkShell {
   buildInputs = with pkgs; [
     cmake
-    eigen
     boostPython
     pythonPkgs.python
     pythonPkgs.apycula